@@ -2,8 +2,25 @@
 #include <iomanip>
 #include "../src/PricingEngine.hpp"
 #include "../src/AsianOption.hpp"
+#include "../src/ThreadPool.hpp"
 #include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
+
+// Threads used by the parameter sweeps
+inline unsigned int analysisThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Checkpoints 1000, 6000, ..., 996000 shared by the convergence and tolerance sweeps
+inline std::vector<unsigned int> convergenceCheckpoints() {
+    std::vector<unsigned int> checkpoints;
+    for (unsigned int numSimulations = 1000; numSimulations <= 1000000; numSimulations += 5000) {
+        checkpoints.push_back(numSimulations);
+    }
+    return checkpoints;
+}
 
 class SpotVsOptionWriter {
 public:
@@ -19,20 +36,25 @@ public:
         // Write the headers
         outfile << "SpotPrice,OptionPrice1,OptionPrice2,OptionPrice3,OptionPrice4\n";
 
-        // Calculate prices for a range of spot prices and varying expiry times
+        // Calculate prices for a range of spot prices and varying expiry times; grid points run in parallel, rows are written in order
+        std::vector<double> spots;
         for (double spot = 20.0; spot <= 180.0; spot += 1.0) {
-            AsianOption optionExpiry1(105.0, 1.0, optionType, averagingType, 10);
-            AsianOption optionExpiry2(105.0, 4.0, optionType, averagingType, 10);
-            AsianOption optionExpiry3(105.0, 8.0, optionType, averagingType, 10);
-            AsianOption optionExpiry4(105.0, 12.0, optionType, averagingType, 10);
-
-            double price1 = pricingMethod(optionExpiry1, spot, 0.05, 0.20, 10000);
-            double price2 = pricingMethod(optionExpiry2, spot, 0.05, 0.20, 10000);
-            double price3 = pricingMethod(optionExpiry3, spot, 0.05, 0.20, 10000);
-            double price4 = pricingMethod(optionExpiry4, spot, 0.05, 0.20, 10000);
+            spots.push_back(spot);
+        }
 
+        ThreadPool pool(analysisThreads());
+        std::vector<std::vector<double>> rows = runSweep(pool, spots, [&](double spot) {
+            std::vector<double> prices;
+            for (double expiry : {1.0, 4.0, 8.0, 12.0}) {
+                AsianOption option(105.0, expiry, optionType, averagingType, 10);
+                prices.push_back(pricingMethod(option, spot, 0.05, 0.20, 10000));
+            }
+            return prices;
+        });
+
+        for (std::size_t i = 0; i < spots.size(); ++i) {
             // Write the spot price and option prices to the CSV file
-            outfile << std::fixed << std::setprecision(2) << spot << "," << price1 << "," << price2 << "," << price3 << "," << price4 << "\n";
+            outfile << std::fixed << std::setprecision(2) << spots[i] << "," << rows[i][0] << "," << rows[i][1] << "," << rows[i][2] << "," << rows[i][3] << "\n";
         }
 
         // Close the opened file
@@ -57,15 +79,23 @@ public:
         // Write the headers
         outfile << "NumSimulations,PriceNaive,PriceAntithetic,PriceGBM\n";
 
-        // Calculate prices for a range of iterations
-        for (double numSimulations = 1000; numSimulations <= 1000000; numSimulations += 5000) {
-            AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
-            double priceNaive = PricingEngine::calculatePriceNaive(option, 100.0, 0.05, 0.20, numSimulations);
-            double priceAntithetic = PricingEngine::calculatePriceAntithetic(option, 100.0, 0.05, 0.20, numSimulations);
-            double priceGBM = PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.20, numSimulations);
+        // Each method simulates one growing set of paths and reports its running estimate at every checkpoint,
+        // instead of re-pricing from scratch for every number of simulations
+        AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
+        std::vector<unsigned int> checkpoints = convergenceCheckpoints();
+        SimulationConfig config = PricingEngine::randomConfig();
+        config.numThreads = analysisThreads();
 
+        std::vector<PricingResult> pricesNaive = PricingEngine::calculatePriceConvergence(PricingEngine::Method::Naive, option, 100.0, 0.05, 0.20, checkpoints, config);
+        config.seed = PricingEngine::randomConfig().seed;
+        std::vector<PricingResult> pricesAntithetic = PricingEngine::calculatePriceConvergence(PricingEngine::Method::Antithetic, option, 100.0, 0.05, 0.20, checkpoints, config);
+        config.seed = PricingEngine::randomConfig().seed;
+        std::vector<PricingResult> pricesGBM = PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, option, 100.0, 0.05, 0.20, checkpoints, config);
+
+        for (std::size_t i = 0; i < checkpoints.size(); ++i) {
             // Write the number of simulations and option prices to the CSV file
-            outfile << std::fixed << std::setprecision(2) << numSimulations << "," << priceNaive << "," << priceAntithetic << "," << priceGBM << "\n";
+            outfile << std::fixed << std::setprecision(2) << static_cast<double>(checkpoints[i]) << "," << pricesNaive[i].price << ","
+                    << pricesAntithetic[i].price << "," << pricesGBM[i].price << "\n";
         }
 
         // Close the opened file
@@ -90,20 +120,25 @@ public:
         // Write the headers
         outfile << "Volatility,OptionPrice1,OptionPrice2,OptionPrice3,OptionPrice4\n";
 
-        // Calculate prices for a range of volatilities while keeping other parameters constant
+        // Calculate prices for a range of volatilities while keeping other parameters constant; grid points run in parallel
+        std::vector<double> volatilities;
         for (double volatility = 0.02; volatility <= 0.80; volatility += 0.005) {
-            AsianOption optionVolatility1(105.0, 1.0, optionType, averagingType, 10);
-            AsianOption optionVolatility2(105.0, 4.0, optionType, averagingType, 10);
-            AsianOption optionVolatility3(105.0, 8.0, optionType, averagingType, 10);
-            AsianOption optionVolatility4(105.0, 12.0, optionType, averagingType, 10);
-
-            double price1 = pricingMethod(optionVolatility1, 100.0, 0.05, volatility, 10000);
-            double price2 = pricingMethod(optionVolatility2, 100.0, 0.05, volatility, 10000);
-            double price3 = pricingMethod(optionVolatility3, 100.0, 0.05, volatility, 10000);
-            double price4 = pricingMethod(optionVolatility4, 100.0, 0.05, volatility, 10000);
+            volatilities.push_back(volatility);
+        }
 
+        ThreadPool pool(analysisThreads());
+        std::vector<std::vector<double>> rows = runSweep(pool, volatilities, [&](double volatility) {
+            std::vector<double> prices;
+            for (double expiry : {1.0, 4.0, 8.0, 12.0}) {
+                AsianOption option(105.0, expiry, optionType, averagingType, 10);
+                prices.push_back(pricingMethod(option, 100.0, 0.05, volatility, 10000));
+            }
+            return prices;
+        });
+
+        for (std::size_t i = 0; i < volatilities.size(); ++i) {
             // Write the volatility and option prices to the CSV file
-            outfile << std::fixed << std::setprecision(3) << volatility << "," << price1 << "," << price2 << "," << price3 << "," << price4 << "\n";
+            outfile << std::fixed << std::setprecision(3) << volatilities[i] << "," << rows[i][0] << "," << rows[i][1] << "," << rows[i][2] << "," << rows[i][3] << "\n";
         }
 
         // Close the opened file
@@ -114,78 +149,156 @@ public:
     }
 };
 
-class EfficiencyWriter {
+class ToleranceWriter {
 public:
-    static void writeData(const std::string& filename) {
+    using PricingMethod = double(*)(const Option&, double, double, double, unsigned int);
+
+    static void writeData(const std::string& filename, Option::Type optionType, AsianOption::AveragingType averagingType, PricingMethod pricingMethod) {
         // Print notification to console
-        std::cout << "Running: analysis/EfficiencyWriter" << std::endl;
+        std::cout << "Running: analysis/ToleranceWriter" << std::endl;
 
         // Open a file in write mode
         std::ofstream outfile(filename);
 
         // Write the headers
-        outfile << "NumSimulations,TimeNaive,TimeAntithetic\n";
-
-        // Calculate prices and measure computational time for a range of iterations
-        for (double numSimulations = 1000; numSimulations <= 1000000; numSimulations += 5000) {
-            AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
-
-            // Measure computational time for the naive method
-            auto startNaive = std::chrono::high_resolution_clock::now();
-            PricingEngine::calculatePriceNaive(option, 100.0, 0.05, 0.20, numSimulations);
-            auto endNaive = std::chrono::high_resolution_clock::now();
-            auto timeNaive = std::chrono::duration_cast<std::chrono::microseconds>(endNaive - startNaive).count();
-
-            // Measure computational time for the antithetic method
-            auto startAntithetic = std::chrono::high_resolution_clock::now();
-            PricingEngine::calculatePriceAntithetic(option, 100.0, 0.05, 0.20, numSimulations);
-            auto endAntithetic = std::chrono::high_resolution_clock::now();
-            auto timeAntithetic = std::chrono::duration_cast<std::chrono::microseconds>(endAntithetic - startAntithetic).count();
-
-            // Write the number of simulations and computational times to the CSV file
-            outfile << std::fixed << std::setprecision(3) << numSimulations << "," << timeNaive << "," << timeAntithetic << "\n";
+        outfile << "NumSimulations,PriceDiffNaive,PriceDiffAntithetic\n";
+
+        // Running estimates of each method along one growing set of paths, as in ConvergenceWriter
+        AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
+        std::vector<unsigned int> checkpoints = convergenceCheckpoints();
+        SimulationConfig config = PricingEngine::randomConfig();
+        config.numThreads = analysisThreads();
+
+        std::vector<PricingResult> pricesNaive = PricingEngine::calculatePriceConvergence(PricingEngine::Method::Naive, option, 100.0, 0.05, 0.20, checkpoints, config);
+        config.seed = PricingEngine::randomConfig().seed;
+        std::vector<PricingResult> pricesAntithetic = PricingEngine::calculatePriceConvergence(PricingEngine::Method::Antithetic, option, 100.0, 0.05, 0.20, checkpoints, config);
+        config.seed = PricingEngine::randomConfig().seed;
+        std::vector<PricingResult> pricesGBM = PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, option, 100.0, 0.05, 0.20, checkpoints, config);
+
+        for (std::size_t i = 0; i < checkpoints.size(); ++i) {
+            double priceDiffNaive = std::abs(pricesNaive[i].price - pricesGBM[i].price);
+            double priceDiffAntithetic = std::abs(pricesAntithetic[i].price - pricesGBM[i].price);
+
+            // Write the number of simulations and option prices to the CSV file
+            outfile << std::fixed << std::setprecision(2) << checkpoints[i] << "," << priceDiffNaive << "," << priceDiffAntithetic << "\n";
         }
 
         // Close the opened file
         outfile.close();
 
         // Print notification to console
-        std::cout << "Complete: analysis/EfficiencyWriter" << std::endl;
+        std::cout << "Complete: analysis/ToleranceWriter" << std::endl;
     }
 };
 
-class ToleranceWriter {
-public:
-    using PricingMethod = double(*)(const Option&, double, double, double, unsigned int);
 
-    static void writeData(const std::string& filename, Option::Type optionType, AsianOption::AveragingType averagingType, PricingMethod pricingMethod) {
+class ScalingWriter {
+public:
+    static void writeData(const std::string& filename, unsigned int maxThreads) {
         // Print notification to console
-        std::cout << "Running: analysis/ToleranceWriter" << std::endl;
+        std::cout << "Running: analysis/ScalingWriter" << std::endl;
 
         // Open a file in write mode
         std::ofstream outfile(filename);
 
         // Write the headers
-        outfile << "NumSimulations,PriceDiffNaive,PriceDiffAntithetic\n";
+        outfile << "NumThreads,Time,Speedup,FinalPrice\n";
+
+        // Time the ConvergenceWriter workload (the three methods' running estimates over convergenceCheckpoints()) for doubling
+        // thread counts. The seed is fixed, so FinalPrice must be identical on every row.
+        AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
+        std::vector<unsigned int> checkpoints = convergenceCheckpoints();
+        double baseTime = 0.0;
+        for (unsigned int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            SimulationConfig config;
+            config.numThreads = numThreads;
+            config.seed = 2023;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            PricingEngine::calculatePriceConvergence(PricingEngine::Method::Naive, option, 100.0, 0.05, 0.20, checkpoints, config);
+            PricingEngine::calculatePriceConvergence(PricingEngine::Method::Antithetic, option, 100.0, 0.05, 0.20, checkpoints, config);
+            double finalPrice = PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, option, 100.0, 0.05, 0.20, checkpoints, config).back().price;
+            auto end = std::chrono::high_resolution_clock::now();
+            double time = std::chrono::duration<double>(end - start).count();
+
+            if (numThreads == 1) {
+                baseTime = time;
+            }
+
+            // Write the number of threads, wall time in seconds, speedup and final price to the CSV file
+            outfile << numThreads << "," << std::fixed << std::setprecision(3) << time << "," << baseTime / time << ","
+                    << std::setprecision(10) << finalPrice << "\n";
+        }
 
-        // Calculate prices for a range of iterations
-        for (int numSimulations = 1000; numSimulations <= 1000000; numSimulations += 5000) {
-            AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10);
-            double priceNaive = PricingEngine::calculatePriceNaive(option, 100.0, 0.05, 0.20, numSimulations);
-            double priceAntithetic = PricingEngine::calculatePriceAntithetic(option, 100.0, 0.05, 0.20, numSimulations);
-            double priceGBM = PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.20, numSimulations);
+        // Close the opened file
+        outfile.close();
 
-            double priceDiffNaive = std::abs(priceNaive - priceGBM);
-            double priceDiffAntithetic = std::abs(priceAntithetic - priceGBM);
+        // Print notification to console
+        std::cout << "Complete: analysis/ScalingWriter" << std::endl;
+    }
+};
 
-            // Write the number of simulations and option prices to the CSV file
-            outfile << std::fixed << std::setprecision(2) << numSimulations << "," << priceDiffNaive << "," << priceDiffAntithetic << "\n";
+class AdjointWriter {
+public:
+    static void writeData(const std::string& filename) {
+        // Print notification to console
+        std::cout << "Running: analysis/AdjointWriter" << std::endl;
+
+        // Open a file in write mode
+        std::ofstream outfile(filename);
+
+        // Write the headers
+        outfile << "AveragingPeriods,NumInputs,TimePrice,TimeAdjoint,AdjointOverPrice,TimeBumpSpotVolRate,TimeBumpAllInputs,BumpAllOverPrice\n";
+
+        // Compare one price, all adjoint sensitivities, and central-difference bump-and-reprice, on the same 100000 paths: first of
+        // spot, volatility and rate alone (seven prices), then of every input, with expiry and each fixing date after the spot bumped
+        // through the explicit-schedule constructor (2 * NumInputs + 1 prices)
+        for (unsigned int averagingPeriods : {2u, 10u, 52u, 252u}) {
+            AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, averagingPeriods);
+            SimulationConfig config;
+            config.seed = 2023;
+            unsigned int numSimulations = 100000;
+            unsigned int numInputs = averagingPeriods + 3; // spot, volatility, rate, expiry and the n - 1 simulated fixing dates
+
+            double timePrice = PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.20, numSimulations, config).wallTime;
+            double timeAdjoint = PricingEngine::calculateGreeksAdjoint(option, 100.0, 0.05, 0.20, numSimulations, config).price.wallTime;
+
+            // Bumped contracts are built up front so that only pricing is timed; a bump of 1e-4 years keeps the dates increasing
+            const std::vector<double> &fixingTimes = option.getFixingTimes();
+            std::vector<AsianOption> scheduleBumps;
+            for (double bump : {-1e-4, 1e-4}) {
+                scheduleBumps.emplace_back(105.0, 1.0 + bump, Option::Type::Call, AsianOption::AveragingType::Arithmetic, fixingTimes);
+                for (std::size_t i = 1; i < fixingTimes.size(); ++i) {
+                    std::vector<double> bumped = fixingTimes;
+                    bumped[i] += bump;
+                    scheduleBumps.emplace_back(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, bumped);
+                }
+            }
+
+            auto startBump = std::chrono::high_resolution_clock::now();
+            PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.20, numSimulations, config);
+            for (double bump : {-1.0, 1.0}) {
+                PricingEngine::calculatePriceGBM(option, 100.0 + bump, 0.05, 0.20, numSimulations, config);
+                PricingEngine::calculatePriceGBM(option, 100.0, 0.05 + 0.0001 * bump, 0.20, numSimulations, config);
+                PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.20 + 0.001 * bump, numSimulations, config);
+            }
+            auto endBump = std::chrono::high_resolution_clock::now();
+            for (const AsianOption &bumped : scheduleBumps) {
+                PricingEngine::calculatePriceGBM(bumped, 100.0, 0.05, 0.20, numSimulations, config);
+            }
+            auto endBumpAll = std::chrono::high_resolution_clock::now();
+            double timeBump = std::chrono::duration<double>(endBump - startBump).count();
+            double timeBumpAll = std::chrono::duration<double>(endBumpAll - startBump).count();
+
+            // Write the number of inputs, times in seconds and the adjoint cost in units of one price to the CSV file
+            outfile << averagingPeriods << "," << numInputs << "," << std::fixed << std::setprecision(4) << timePrice << "," << timeAdjoint << ","
+                    << timeAdjoint / timePrice << "," << timeBump << "," << timeBumpAll << "," << timeBumpAll / timePrice << "\n";
         }
 
         // Close the opened file
         outfile.close();
 
         // Print notification to console
-        std::cout << "Complete: analysis/ToleranceWriter" << std::endl;
+        std::cout << "Complete: analysis/AdjointWriter" << std::endl;
     }
 };
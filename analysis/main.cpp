@@ -2,7 +2,7 @@
 
 // Specify what analysis you would like to see below by commenting out certain lines, then run the .ipynb file to generate graphs.
 // NOTE: ONLY execute the required cells in the .ipynb file to avoid a FileNotFound Error.
-// File takes 5 minutes to run all analysis.
+// File takes under a minute to run all analysis on one core; the parameter sweeps use every hardware thread.
 
 int main() {
     SpotVsOptionWriter::writeData("../../analysis/SpotVsOption.csv", Option::Type::Call, AsianOption::AveragingType::Arithmetic, PricingEngine::calculatePriceGBM);
@@ -12,11 +12,12 @@ int main() {
 
     OptionPriceVsVolatilityWriter::writeData("../../analysis/OptionVsVolatility.csv", Option::Type::Call, AsianOption::AveragingType::Arithmetic, PricingEngine::calculatePriceGBM);
 
-    EfficiencyWriter efficiencyWriter;
-    EfficiencyWriter::writeData("../../analysis/Efficiency.csv");
-
     ToleranceWriter toleranceWriter;
     ToleranceWriter::writeData("../../analysis/Tolerance.csv", Option::Type::Call, AsianOption::AveragingType::Arithmetic, PricingEngine::calculatePriceGBM);
 
+    ScalingWriter::writeData("../../analysis/Scaling.csv", std::max(1u, std::thread::hardware_concurrency()));
+
+    AdjointWriter::writeData("../../analysis/Adjoint.csv");
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "PerfCounters.hpp"
+
+#if defined(__linux__)
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+struct CounterDefinition {
+    const char *name;
+    std::uint64_t config;
+};
+
+const CounterDefinition counterDefinitions[] = {
+    {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache-misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branch-misses", PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+// User-space events of this thread; inherit also counts the threads it starts later, such as the pool of an engine context first used
+// after the counters are opened
+int openCounter(std::uint64_t config) {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    for (const CounterDefinition &definition : counterDefinitions) {
+        int descriptor = openCounter(definition.config);
+        if (descriptor >= 0) {
+            descriptors.push_back(descriptor);
+            names.push_back(definition.name);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int descriptor : descriptors) {
+        close(descriptor);
+    }
+}
+
+void PerfCounters::start() {
+    for (int descriptor : descriptors) {
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::stop() {
+    for (int descriptor : descriptors) {
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+std::vector<double> PerfCounters::read() const {
+    std::vector<double> counts;
+    for (int descriptor : descriptors) {
+        std::uint64_t count = 0;
+        counts.push_back(::read(descriptor, &count, sizeof(count)) == sizeof(count) ? static_cast<double>(count) : 0.0);
+    }
+    return counts;
+}
+
+#else
+
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+std::vector<double> PerfCounters::read() const { return {}; }
+
+#endif
+
+bool PerfCounters::isAvailable() const { return !descriptors.empty(); }
+
+const std::vector<std::string> &PerfCounters::getNames() const { return names; }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Hardware event counters for the calling thread and the threads it starts, read through Linux perf_event_open.
+// Counters the kernel or the machine does not provide (containers, VMs, other platforms) are skipped, so isAvailable() may be false.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool isAvailable() const;
+
+    void start(); // resets and enables every counter
+    void stop();
+
+    // Names and counts of the counters that could be opened, in the same order
+    const std::vector<std::string> &getNames() const;
+    std::vector<double> read() const;
+
+private:
+    std::vector<int> descriptors;
+    std::vector<std::string> names;
+};
@@ -0,0 +1,181 @@
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+#include "../src/RandomStream.hpp"
+#include "../src/PriceCache.hpp"
+#include "../src/EngineContext.hpp"
+#include "../src/Instrumentation.hpp"
+#include "PerfCounters.hpp"
+
+// Throughput benchmarks for the pricing engines. Every benchmark prices the standard contract (K = 105, T = 1, arithmetic call,
+// S = 100, r = 5%, sigma = 20%) with a fixed seed over a grid of (paths, averaging periods, threads), and reports:
+//   paths/s       simulated paths per second of wall time
+//   ns/step       wall time per simulated path step
+//   stderr        standard error of the price, to weigh speed against accuracy
+//   <event>/path  hardware counters per path, where perf_event_open is permitted
+//   arena allocs  heap blocks the engine context obtained during the timed iterations (zero once warm)
+//   arena bytes   peak scratch memory in use across the context's arenas
+//   <phase>/path  instrumented time per path in each engine phase, in ns or cycles; only with -DASIAN_PRICING_INSTRUMENTATION=ON
+// normalsBenchmark times the random number layer on its own, filling a buffer of standard normals with each generator, and
+// priceCacheBenchmark the latency of an interpolated quote from a warm PriceCache.
+// Run with --benchmark_repetitions to get the mean, median, standard deviation and coefficient of variation across repetitions.
+
+namespace {
+
+const std::uint64_t benchmarkSeed = 2023;
+
+AsianOption benchmarkOption(unsigned int averagingPeriods) {
+    return AsianOption(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, averagingPeriods);
+}
+
+// Times pricer(option, numSimulations, config) once per benchmark iteration and attaches the throughput counters
+template <typename Pricer>
+void runPricing(benchmark::State &state, Pricer pricer, RandomGenerator generator = RandomGenerator::Philox) {
+    unsigned int numSimulations = static_cast<unsigned int>(state.range(0));
+    unsigned int averagingPeriods = static_cast<unsigned int>(state.range(1));
+    AsianOption option = benchmarkOption(averagingPeriods);
+    SimulationConfig config;
+    config.seed = benchmarkSeed;
+    config.numThreads = static_cast<unsigned int>(state.range(2));
+    config.generator = generator;
+    EngineContext context;
+    config.context = &context;
+
+    PerfCounters perfCounters;
+    PricingResult result;
+    double wallTime = 0.0;
+
+    // One untimed call sizes the arenas and starts the context's thread pool, so the timed calls show the steady state and the
+    // counters, opened before it, follow the pool's threads
+    pricer(option, numSimulations, config);
+    unsigned long long warmAllocations = context.getStatistics().heapAllocations;
+    resetInstrumentation();
+
+    perfCounters.start();
+    for (auto _ : state) {
+        result = pricer(option, numSimulations, config);
+        benchmark::DoNotOptimize(result.price);
+        wallTime += result.wallTime;
+    }
+    perfCounters.stop();
+
+    double paths = static_cast<double>(numSimulations) * state.iterations();
+    double steps = paths * std::max(averagingPeriods - 1, 1u);
+    state.counters["paths/s"] = benchmark::Counter(paths, benchmark::Counter::kIsRate);
+    state.counters["ns/step"] = wallTime * 1e9 / steps;
+    state.counters["stderr"] = result.standardError;
+    ArenaStatistics arena = context.getStatistics();
+    state.counters["arena allocs"] = static_cast<double>(arena.heapAllocations - warmAllocations);
+    state.counters["arena bytes"] = static_cast<double>(arena.peakBytesInUse);
+
+    InstrumentationReport instrumentation = instrumentationReport();
+    if (instrumentation.enabled) {
+        for (unsigned int i = 0; i < numInstrumentedPhases; ++i) {
+            state.counters[std::string(instrumentedPhaseName(static_cast<InstrumentedPhase>(i))) + "/path"] = instrumentation.phaseTicks[i] / paths;
+        }
+    }
+
+    std::vector<double> counts = perfCounters.read();
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        state.counters[perfCounters.getNames()[i] + "/path"] = counts[i] / paths;
+    }
+}
+
+void methodBenchmark(benchmark::State &state, PricingEngine::Method method, RandomGenerator generator = RandomGenerator::Philox) {
+    runPricing(state, [method](const AsianOption &option, unsigned int numSimulations, const SimulationConfig &config) {
+        return PricingEngine::calculatePrice(method, option, 100.0, 0.05, 0.20, numSimulations, config);
+    }, generator);
+}
+
+// The paths are split over 8 scrambled replicas
+void quasiMonteCarloBenchmark(benchmark::State &state) {
+    runPricing(state, [](const AsianOption &option, unsigned int numSimulations, const SimulationConfig &config) {
+        return PricingEngine::calculatePriceQuasiMonteCarlo(option, 100.0, 0.05, 0.20, numSimulations / 8, 8, config);
+    });
+}
+
+// GBM paths streamed through a step table on the same uniform schedule
+void streamingBenchmark(benchmark::State &state) {
+    runPricing(state, [](const AsianOption &option, unsigned int numSimulations, const SimulationConfig &config) {
+        return PricingEngine::calculatePriceStreaming(option, 100.0, 0.05, 0.20, numSimulations, config);
+    });
+}
+
+// Queries a warm price cache at spots and volatilities spread over its grid; the surface is built before timing starts
+void priceCacheBenchmark(benchmark::State &state) {
+    AsianOption option = benchmarkOption(52);
+    PriceCacheConfig config;
+    config.simulation.seed = benchmarkSeed;
+    PriceCache cache(config);
+    cache.quote(option, 100.0, 0.05, 0.20);
+
+    unsigned int query = 0;
+    for (auto _ : state) {
+        double spot = 90.0 + (query % 97) * 0.2;
+        double volatility = 0.15 + (query % 89) * 0.001;
+        benchmark::DoNotOptimize(cache.quote(option, spot, 0.05, volatility));
+        ++query;
+    }
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// Fills a buffer of state.range(0) normals per iteration from one stream
+void normalsBenchmark(benchmark::State &state, RandomGenerator generator) {
+    std::vector<double> normals(static_cast<std::size_t>(state.range(0)));
+    NormalStream stream(generator, benchmarkSeed, 0);
+    for (auto _ : state) {
+        stream.fill(normals.data(), normals.size());
+        benchmark::DoNotOptimize(normals.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["normals/s"] = benchmark::Counter(static_cast<double>(normals.size()) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+void pricingGrid(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgNames({"paths", "periods", "threads"})
+            ->ArgsProduct({{1 << 14, 1 << 17}, {10, 52, 252}, {1, 2, 4}})
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(methodBenchmark, Naive, PricingEngine::Method::Naive)->Apply(pricingGrid);
+BENCHMARK_CAPTURE(methodBenchmark, Antithetic, PricingEngine::Method::Antithetic)->Apply(pricingGrid);
+BENCHMARK_CAPTURE(methodBenchmark, GBM, PricingEngine::Method::GBM)->Apply(pricingGrid);
+BENCHMARK_CAPTURE(methodBenchmark, ControlVariate, PricingEngine::Method::ControlVariate)->Apply(pricingGrid);
+BENCHMARK(quasiMonteCarloBenchmark)->Apply(pricingGrid);
+BENCHMARK(streamingBenchmark)->Apply(pricingGrid);
+BENCHMARK_CAPTURE(methodBenchmark, GBMMersenneTwister, PricingEngine::Method::GBM, RandomGenerator::MersenneTwister)->Apply(pricingGrid);
+BENCHMARK(priceCacheBenchmark);
+BENCHMARK_CAPTURE(normalsBenchmark, Philox, RandomGenerator::Philox)->Arg(1 << 16);
+BENCHMARK_CAPTURE(normalsBenchmark, MersenneTwister, RandomGenerator::MersenneTwister)->Arg(1 << 16);
+
+// Defaults to five repetitions with aggregates on the console and a JSON report next to the analysis CSVs;
+// any of these flags given on the command line wins
+int main(int argc, char **argv) {
+    std::vector<std::string> defaults = {"--benchmark_repetitions=5", "--benchmark_display_aggregates_only=true",
+                                         "--benchmark_out=../../analysis/Benchmark.json", "--benchmark_out_format=json"};
+    std::vector<char *> arguments(argv, argv + argc);
+    for (std::string &flag : defaults) {
+        std::string name = flag.substr(0, flag.find('=') + 1);
+        bool given = false;
+        for (int i = 1; i < argc; ++i) {
+            given = given || std::string(argv[i]).rfind(name, 0) == 0;
+        }
+        if (!given) {
+            arguments.push_back(&flag[0]);
+        }
+    }
+
+    int numArguments = static_cast<int>(arguments.size());
+    benchmark::Initialize(&numArguments, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(numArguments, arguments.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
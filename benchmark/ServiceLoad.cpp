@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingEngine.hpp"
+#include "PricingService.hpp"
+
+// Closed-loop load on the pricing service: each client thread submits a request, waits for its price and submits the next, drawing
+// its contracts from a small shared set so that concurrent clients ask for the same ones. The same requests are then priced by the
+// clients calling calculatePriceGBM directly, for comparison.
+
+namespace {
+
+const char *const usage =
+        "Usage: ServiceLoadGenerator [options]\n"
+        "Options:\n"
+        "  --clients N     concurrent client threads (default 8)\n"
+        "  --requests N    requests per client (default 200)\n"
+        "  --paths N       paths per request (default 10000)\n"
+        "  --workers N     service worker threads (default 2)\n"
+        "  --contracts N   distinct contracts the clients draw from (default 16)\n";
+
+unsigned int parseCount(const std::string &option, const std::string &value) {
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long count = std::strtoull(value.c_str(), &end, 10);
+    if (value.empty() || value[0] == '-' || *end != '\0' || errno == ERANGE || count > UINT32_MAX) {
+        throw std::invalid_argument(option + " expects a non-negative integer no greater than " + std::to_string(UINT32_MAX) + ", got '" + value + "'");
+    }
+    return static_cast<unsigned int>(count);
+}
+
+// Runs every client to completion and returns the elapsed seconds
+template <typename Request>
+double runClients(unsigned int clients, const Request &request) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int c = 0; c < clients; ++c) {
+        threads.emplace_back(request, c);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    unsigned int clients = 8, requests = 200, paths = 10000, contracts = 16;
+    PricingServiceConfig config;
+    try {
+        for (std::size_t i = 0; i < arguments.size(); i += 2) {
+            if (i + 1 >= arguments.size()) {
+                throw std::invalid_argument(arguments[i] + " expects a value");
+            }
+            const std::string &option = arguments[i];
+            unsigned int value = parseCount(option, arguments[i + 1]);
+            if (option == "--clients") {
+                clients = value;
+            } else if (option == "--requests") {
+                requests = value;
+            } else if (option == "--paths") {
+                paths = value;
+            } else if (option == "--workers") {
+                config.workers = value;
+            } else if (option == "--contracts") {
+                contracts = value;
+            } else {
+                throw std::invalid_argument("unknown option " + option);
+            }
+        }
+        if (clients == 0 || contracts == 0 || config.workers == 0) {
+            throw std::invalid_argument("--clients, --contracts and --workers must be positive");
+        }
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << "\n" << usage;
+        return 1;
+    }
+
+    // One market and schedule with a spread of strikes and both types, so distinct contracts still share a batch
+    const MarketData market = {100.0, 0.05, 0.2};
+    std::vector<AsianOption> book;
+    for (unsigned int k = 0; k < contracts; ++k) {
+        book.emplace_back(80.0 + 40.0 * k / contracts, 1.0, k % 2 == 0 ? Option::Type::Call : Option::Type::Put,
+                          AsianOption::AveragingType::Arithmetic, 12);
+    }
+    auto contract = [&](unsigned int client, unsigned int request) { return book[(client * 7 + request) % contracts]; };
+    double total = static_cast<double>(clients) * requests;
+
+    double directTime = runClients(clients, [&](unsigned int client) {
+        for (unsigned int r = 0; r < requests; ++r) {
+            PricingEngine::calculatePriceGBM(contract(client, r), market.spot, market.riskFreeRate, market.volatility, paths, config.simulation);
+        }
+    });
+
+    PricingServiceStatistics statistics;
+    double serviceTime;
+    {
+        PricingService service(config);
+        serviceTime = runClients(clients, [&](unsigned int client) {
+            for (unsigned int r = 0; r < requests; ++r) {
+                service.submit(contract(client, r), market, paths).get();
+            }
+        });
+        statistics = service.getStatistics();
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << clients << " clients x " << requests << " requests, " << paths << " paths, " << contracts << " contracts, "
+              << config.workers << " workers\n";
+    std::cout << "direct:  " << total / directTime << " requests/s\n";
+    std::cout << "service: " << total / serviceTime << " requests/s, " << statistics.batches << " batches, " << statistics.coalesced
+              << " coalesced, p50 " << statistics.p50Latency * 1e3 << " ms, p99 " << statistics.p99Latency * 1e3 << " ms\n";
+    return 0;
+}
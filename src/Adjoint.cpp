@@ -0,0 +1,41 @@
+#include "Adjoint.hpp"
+
+Tape::Tape() {
+    nodes.push_back(Node{{0, 0}, {0.0, 0.0}}); // node 0 absorbs the derivatives of constants
+}
+
+Tape &Tape::current() {
+    thread_local Tape tape;
+    return tape;
+}
+
+unsigned int Tape::variable() {
+    return record(0, 0.0, 0, 0.0);
+}
+
+std::size_t Tape::mark() const { return nodes.size(); }
+
+void Tape::rewind(std::size_t position) {
+    nodes.resize(position < 1 ? 1 : position);
+}
+
+void Tape::clearAdjoints() {
+    adjoints.assign(nodes.size(), 0.0);
+}
+
+double &Tape::adjoint(unsigned int index) {
+    return adjoints[index];
+}
+
+void Tape::propagate(std::size_t position) {
+    std::size_t last = position < 1 ? 1 : position;
+    for (std::size_t i = nodes.size(); i-- > last;) {
+        double adjoint = adjoints[i];
+        if (adjoint == 0.0) {
+            continue;
+        }
+        const Node &node = nodes[i];
+        adjoints[node.operand[0]] += node.partial[0] * adjoint;
+        adjoints[node.operand[1]] += node.partial[1] * adjoint;
+    }
+}
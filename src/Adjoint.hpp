@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Tape for reverse-mode (adjoint) differentiation. Every elementary operation on Active values appends a node holding the
+// indices of its (at most two) operands and the partial derivatives with respect to them; propagate() then sweeps the nodes
+// backwards, so one sweep gives the derivative of one output with respect to every input.
+// Node 0 stands for all constants: derivatives flowing into it are simply discarded.
+class Tape {
+public:
+    Tape();
+
+    // The calling thread's tape; each thread records independently
+    static Tape &current();
+
+    unsigned int variable(); // a new independent input
+
+    unsigned int record(unsigned int first, double firstPartial, unsigned int second, double secondPartial) {
+        nodes.push_back(Node{{first, second}, {firstPartial, secondPartial}});
+        return static_cast<unsigned int>(nodes.size() - 1);
+    }
+
+    // Current length of the tape; rewinding to a mark drops every node recorded after it, so the memory is reused
+    std::size_t mark() const;
+    void rewind(std::size_t position);
+
+    // Sizes the adjoints to the tape and zeroes them; call after recording, before seeding the output's adjoint
+    void clearAdjoints();
+    double &adjoint(unsigned int index);
+
+    // Sweeps the nodes from the end of the tape back to node position, adding each node's adjoint times its partials to its operands
+    void propagate(std::size_t position = 0);
+
+private:
+    struct Node {
+        unsigned int operand[2];
+        double partial[2];
+    };
+    std::vector<Node> nodes;
+    std::vector<double> adjoints;
+};
+
+// Value recorded on the calling thread's tape. Arithmetic mirrors double; constants (and results computed only from constants)
+// are not recorded at all.
+class Active {
+public:
+    Active(double value = 0.0) : value(value), index(0) {}
+    Active(double value, unsigned int index) : value(value), index(index) {}
+
+    // Registers a new input on the tape
+    static Active variable(double value) { return Active(value, Tape::current().variable()); }
+
+    double getValue() const { return value; }
+    unsigned int getIndex() const { return index; }
+
+    // Result of an operation with the given partials; left unrecorded when no operand is on the tape
+    static Active result(double value, const Active &first, double firstPartial, const Active &second = Active(), double secondPartial = 0.0) {
+        if (first.index == 0 && second.index == 0) {
+            return Active(value);
+        }
+        return Active(value, Tape::current().record(first.index, firstPartial, second.index, secondPartial));
+    }
+
+    Active &operator+=(const Active &other) { return *this = result(value + other.value, *this, 1.0, other, 1.0); }
+    Active &operator-=(const Active &other) { return *this = result(value - other.value, *this, 1.0, other, -1.0); }
+    Active &operator*=(const Active &other) { return *this = result(value * other.value, *this, other.value, other, value); }
+
+private:
+    double value;
+    unsigned int index;
+};
+
+inline Active operator+(const Active &a, const Active &b) { return Active::result(a.getValue() + b.getValue(), a, 1.0, b, 1.0); }
+inline Active operator-(const Active &a, const Active &b) { return Active::result(a.getValue() - b.getValue(), a, 1.0, b, -1.0); }
+inline Active operator-(const Active &a) { return Active::result(-a.getValue(), a, -1.0); }
+inline Active operator*(const Active &a, const Active &b) { return Active::result(a.getValue() * b.getValue(), a, b.getValue(), b, a.getValue()); }
+inline Active operator/(const Active &a, const Active &b) {
+    double quotient = a.getValue() / b.getValue();
+    return Active::result(quotient, a, 1.0 / b.getValue(), b, -quotient / b.getValue());
+}
+
+inline Active exp(const Active &a) {
+    double value = std::exp(a.getValue());
+    return Active::result(value, a, value);
+}
+inline Active log(const Active &a) { return Active::result(std::log(a.getValue()), a, 1.0 / a.getValue()); }
+inline Active sqrt(const Active &a) {
+    double value = std::sqrt(a.getValue());
+    return Active::result(value, a, 0.5 / value);
+}
+// max(a, b) follows the larger operand; at a tie the derivative is taken from a
+inline Active max(const Active &a, const Active &b) { return a.getValue() >= b.getValue() ? Active::result(a.getValue(), a, 1.0) : Active::result(b.getValue(), b, 1.0); }
@@ -1,8 +1,35 @@
 #include <algorithm>
+#include <stdexcept>
+#include <utility>
 #include "AsianOption.hpp"
 
 AsianOption::AsianOption(double strike, double expiry, Option::Type optionType, AveragingType averagingType, unsigned int averagingPeriods)
-        : Option(strike, expiry, optionType), averagingType(averagingType), averagingPeriods(averagingPeriods) {
+        : Option(strike, expiry, optionType), averagingType(averagingType), averagingPeriods(averagingPeriods), pastFixings(0),
+          pastAverage(0.0), uniformSchedule(true) {
+    if (averagingPeriods == 0) {
+        throw std::invalid_argument("AsianOption requires at least one averaging period");
+    }
+    fixingTimes = uniformFixingTimes(expiry, averagingPeriods);
+}
+
+AsianOption::AsianOption(double strike, double expiry, Option::Type optionType, AveragingType averagingType, std::vector<double> fixingTimes,
+                         unsigned int pastFixings, double pastAverage)
+        : Option(strike, expiry, optionType), averagingType(averagingType), fixingTimes(std::move(fixingTimes)), pastFixings(pastFixings),
+          pastAverage(pastFixings > 0 ? pastAverage : 0.0) {
+    averagingPeriods = pastFixings + static_cast<unsigned int>(this->fixingTimes.size());
+    if (averagingPeriods == 0) {
+        throw std::invalid_argument("AsianOption requires at least one averaging period");
+    }
+    if (pastFixings > 0 && !(pastAverage > 0.0)) {
+        throw std::invalid_argument("AsianOption requires a positive average of the past fixings");
+    }
+    for (std::size_t i = 0; i < this->fixingTimes.size(); ++i) {
+        double time = this->fixingTimes[i];
+        if (!(time >= 0.0) || time > expiry || (i > 0 && !(time > this->fixingTimes[i - 1]))) {
+            throw std::invalid_argument("AsianOption requires strictly increasing fixing times between today and expiry");
+        }
+    }
+    uniformSchedule = pastFixings == 0 && this->fixingTimes == uniformFixingTimes(expiry, averagingPeriods);
 }
 
 double AsianOption::payoff(double averagePrice) const {
@@ -19,4 +46,29 @@ AsianOption::AveragingType AsianOption::getAveragingType() const {
 
 unsigned int AsianOption::getAveragingPeriods() const {
     return averagingPeriods;
-}
\ No newline at end of file
+}
+
+const std::vector<double> &AsianOption::getFixingTimes() const {
+    return fixingTimes;
+}
+
+unsigned int AsianOption::getPastFixings() const {
+    return pastFixings;
+}
+
+double AsianOption::getPastAverage() const {
+    return pastAverage;
+}
+
+bool AsianOption::hasUniformSchedule() const {
+    return uniformSchedule;
+}
+
+std::vector<double> AsianOption::uniformFixingTimes(double expiry, unsigned int averagingPeriods) {
+    double dt = expiry / averagingPeriods;
+    std::vector<double> times(averagingPeriods);
+    for (unsigned int i = 0; i < averagingPeriods; ++i) {
+        times[i] = i * dt;
+    }
+    return times;
+}
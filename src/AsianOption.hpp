@@ -1,6 +1,7 @@
 #ifndef ASIANOPTION_HPP
 #define ASIANOPTION_HPP
 
+#include <vector>
 #include "Option.hpp"
 
 // Defines class called AsianOption derived from Option class
@@ -8,18 +9,38 @@ class AsianOption : public Option {
 public:
     enum class AveragingType { Arithmetic, Geometric };
 
-    // Specifying constructor with three member variables from base Option class and initialises additional member variables specific to AsianOption
+    // Specifying constructor with three member variables from base Option class and initialises additional member variables specific to AsianOption.
+    // The averagingPeriods fixings are equally spaced at 0, dt, ..., (n - 1) dt with dt = expiry / n, so the spot is the first fixing.
     AsianOption(double strike, double expiry, Option::Type optionType, AveragingType averagingType, unsigned int averagingPeriods);
 
+    // Explicit schedule, possibly seasoned. fixingTimes are the remaining fixing dates in years from today: non-negative, strictly
+    // increasing and none after expiry, with a fixing at 0 taken as today's spot. pastFixings fixings have already been observed and
+    // pastAverage is their average, arithmetic or geometric to match the averaging type. Throws std::invalid_argument otherwise.
+    AsianOption(double strike, double expiry, Option::Type optionType, AveragingType averagingType, std::vector<double> fixingTimes,
+                unsigned int pastFixings = 0, double pastAverage = 0.0);
+
     double payoff(double averagePrice) const override; // Overrides payoff() method inherited from the base Option class
 
     // Accessor functions to retrieve values of the member variables
     AveragingType getAveragingType() const;
-    unsigned int getAveragingPeriods() const;
+    unsigned int getAveragingPeriods() const; // every fixing, past and remaining
+    const std::vector<double> &getFixingTimes() const; // remaining fixings only
+    unsigned int getPastFixings() const;
+    double getPastAverage() const;
+
+    // Whether the contract is the equally spaced, unseasoned schedule of the first constructor
+    bool hasUniformSchedule() const;
+
+    // The equally spaced schedule: averagingPeriods fixings at 0, dt, ..., (n - 1) dt with dt = expiry / n
+    static std::vector<double> uniformFixingTimes(double expiry, unsigned int averagingPeriods);
 
 private:
     AveragingType averagingType;
     unsigned int averagingPeriods;
+    std::vector<double> fixingTimes;
+    unsigned int pastFixings;
+    double pastAverage;
+    bool uniformSchedule;
 };
 
-#endif // ASIANOPTION_HPP
\ No newline at end of file
+#endif // ASIANOPTION_HPP
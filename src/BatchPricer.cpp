@@ -0,0 +1,44 @@
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "BatchPricer.hpp"
+
+BatchPricerSummary priceTradeFile(TradeReader &reader, std::ostream &output, const BatchPricerConfig &config) {
+    if (config.tradesPerBatch == 0) {
+        throw std::invalid_argument("priceTradeFile requires at least one trade per batch");
+    }
+    auto start = std::chrono::steady_clock::now();
+    BatchPricerSummary summary;
+
+    std::vector<TradeRecord> trades;
+    std::vector<AsianOption> options;
+    std::vector<MarketData> marketData;
+    trades.reserve(config.tradesPerBatch);
+    options.reserve(config.tradesPerBatch);
+    marketData.reserve(config.tradesPerBatch);
+
+    output.precision(std::numeric_limits<double>::max_digits10);
+    output << "id,price,standard_error\n";
+
+    while (reader.read(trades, config.tradesPerBatch) > 0) {
+        options.clear();
+        marketData.clear();
+        for (const TradeRecord &trade : trades) {
+            options.push_back(trade.option());
+            marketData.push_back(trade.marketData());
+        }
+
+        std::vector<PricingResult> results = PricingEngine::calculatePricesBatch(options, marketData, config.numSimulations, config.simulation);
+        for (std::size_t i = 0; i < trades.size(); ++i) {
+            output << trades[i].id << ',' << results[i].price << ',' << results[i].standardError << '\n';
+        }
+        output.flush();
+
+        summary.contracts += trades.size();
+        ++summary.batches;
+    }
+
+    summary.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include "PricingEngine.hpp"
+#include "TradeFile.hpp"
+
+// Prices a whole trade file: trades are read, priced and written one batch at a time, so memory stays flat however long the file is.
+// Each batch goes through PricingEngine::calculatePricesBatch, which spreads the batch's (contract group, chunk of paths) tasks over
+// the configured threads and shares paths between trades on the same market inputs and schedule.
+
+struct BatchPricerConfig {
+    unsigned int numSimulations = 10000; // paths per trade
+    std::size_t tradesPerBatch = 1024;   // trades held in memory at a time
+    SimulationConfig simulation;         // threads and seed; every trade sees the same seed, like calculatePriceGBM with this configuration
+};
+
+struct BatchPricerSummary {
+    unsigned long long contracts = 0;
+    unsigned long long batches = 0;
+    double wallTime = 0.0; // seconds from the first read to the last write
+
+    double contractsPerSecond() const { return wallTime > 0.0 ? contracts / wallTime : 0.0; }
+};
+
+// Writes the CSV header "id,price,standard_error" and then one row per trade, in file order, flushing after every batch.
+// Throws whatever the reader throws for a malformed trade; the rows of earlier batches have been written by then.
+BatchPricerSummary priceTradeFile(TradeReader &reader, std::ostream &output, const BatchPricerConfig &config);
@@ -0,0 +1,75 @@
+#include <cmath>
+#include <stdexcept>
+#include "BrownianBridge.hpp"
+
+BrownianBridge::BrownianBridge(const std::vector<double> &times)
+        : times(times), bridgeIndex(times.size()), leftIndex(times.size()), rightIndex(times.size()),
+          leftWeight(times.size()), rightWeight(times.size()), stdDev(times.size()) {
+    unsigned int m = static_cast<unsigned int>(times.size());
+    if (m == 0) {
+        return;
+    }
+    for (unsigned int i = 0; i < m; ++i) {
+        if (times[i] <= (i == 0 ? 0.0 : times[i - 1])) {
+            throw std::invalid_argument("BrownianBridge times must be positive and strictly increasing");
+        }
+    }
+
+    // Construction step 0 draws the end point; constructed[j] marks the path points already built
+    std::vector<bool> constructed(m, false);
+    bridgeIndex[0] = m - 1;
+    stdDev[0] = std::sqrt(times[m - 1]);
+    constructed[m - 1] = true;
+
+    unsigned int j = 0;
+    for (unsigned int i = 1; i < m; ++i) {
+        // Find the next gap [j, k) of unconstructed points (wrapping round to the start of the path once a pass is complete)
+        // and fill its midpoint l between the neighbours j - 1 and k
+        while (j < m && constructed[j]) {
+            ++j;
+        }
+        if (j == m) {
+            j = 0;
+            while (constructed[j]) {
+                ++j;
+            }
+        }
+        unsigned int k = j;
+        while (!constructed[k]) {
+            ++k;
+        }
+        unsigned int l = j + ((k - 1 - j) >> 1);
+        constructed[l] = true;
+
+        double leftTime = j == 0 ? 0.0 : times[j - 1];
+        bridgeIndex[i] = l;
+        leftIndex[i] = j;
+        rightIndex[i] = k;
+        leftWeight[i] = (times[k] - times[l]) / (times[k] - leftTime);
+        rightWeight[i] = (times[l] - leftTime) / (times[k] - leftTime);
+        stdDev[i] = std::sqrt((times[l] - leftTime) * (times[k] - times[l]) / (times[k] - leftTime));
+
+        j = k + 1;
+        if (j >= m) {
+            j = 0;
+        }
+    }
+}
+
+void BrownianBridge::buildPath(const double *normals, double *path) const {
+    unsigned int m = size();
+    if (m == 0) {
+        return;
+    }
+
+    path[m - 1] = stdDev[0] * normals[0];
+    for (unsigned int i = 1; i < m; ++i) {
+        unsigned int l = bridgeIndex[i];
+        double left = leftIndex[i] == 0 ? 0.0 : path[leftIndex[i] - 1];
+        path[l] = leftWeight[i] * left + rightWeight[i] * path[rightIndex[i]] + stdDev[i] * normals[i];
+    }
+}
+
+unsigned int BrownianBridge::size() const {
+    return static_cast<unsigned int>(times.size());
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+// Brownian-bridge construction of a Brownian path at increasing times t_1 < ... < t_m (all after time 0).
+// The first normal fixes W(t_m), and each later one fills the midpoint of the widest remaining gap, so the leading
+// normals carry most of the path's variance. This pairs with quasi-random numbers, whose leading dimensions are the best distributed.
+class BrownianBridge {
+public:
+    explicit BrownianBridge(const std::vector<double> &times);
+
+    // Maps m independent standard normals to the path values W(t_1), ..., W(t_m)
+    void buildPath(const double *normals, double *path) const;
+
+    unsigned int size() const;
+
+private:
+    std::vector<double> times;
+    std::vector<unsigned int> bridgeIndex; // path point filled by construction step i
+    std::vector<unsigned int> leftIndex;   // one past the left neighbour (0 means time 0, where W = 0)
+    std::vector<unsigned int> rightIndex;  // right neighbour already constructed
+    std::vector<double> leftWeight;
+    std::vector<double> rightWeight;
+    std::vector<double> stdDev;
+};
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <new>
+#include <thread>
+#include "EngineContext.hpp"
+
+PathArena::PathArena(std::size_t blockBytes) : blockBytes(std::max(blockBytes, alignment)) {}
+
+PathArena::~PathArena() {
+    for (Block &block : blocks) {
+        ::operator delete(block.data, std::align_val_t(alignment));
+    }
+}
+
+void *PathArena::allocateBytes(std::size_t bytes) {
+    // Whole cache lines, so every allocation starts on one; an empty request still gets a valid line
+    bytes = std::max((bytes + alignment - 1) / alignment * alignment, alignment);
+
+    while (currentBlock < blocks.size() && offset + bytes > blocks[currentBlock].size) {
+        ++currentBlock;
+        offset = 0;
+    }
+    if (currentBlock == blocks.size()) {
+        std::size_t size = std::max(blockBytes, bytes);
+        blocks.push_back(Block{static_cast<unsigned char *>(::operator new(size, std::align_val_t(alignment))), size});
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        bytesReserved.fetch_add(size, std::memory_order_relaxed);
+        offset = 0;
+    }
+
+    void *result = blocks[currentBlock].data + offset;
+    offset += bytes;
+    std::size_t inUse = bytesInUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (inUse > peakBytesInUse.load(std::memory_order_relaxed)) {
+        peakBytesInUse.store(inUse, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+PathArena::Mark PathArena::mark() const {
+    return Mark{currentBlock, offset, bytesInUse.load(std::memory_order_relaxed)};
+}
+
+void PathArena::rewind(const Mark &to) {
+    currentBlock = to.block;
+    offset = to.offset;
+    bytesInUse.store(to.bytesInUse, std::memory_order_relaxed);
+}
+
+void PathArena::reset() {
+    rewind(Mark{0, 0, 0});
+}
+
+ArenaStatistics PathArena::getStatistics() const {
+    ArenaStatistics statistics;
+    statistics.heapAllocations = heapAllocations.load(std::memory_order_relaxed);
+    statistics.bytesReserved = bytesReserved.load(std::memory_order_relaxed);
+    statistics.bytesInUse = bytesInUse.load(std::memory_order_relaxed);
+    statistics.peakBytesInUse = peakBytesInUse.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+EngineContext::EngineContext(std::size_t arenaBlockBytes, unsigned int numWorkers)
+    : arenaBlockBytes(arenaBlockBytes), numWorkers(numWorkers ? numWorkers : std::max(std::thread::hardware_concurrency(), 2u) - 1) {}
+
+EngineContext::Lease::~Lease() {
+    if (slot) {
+        slot->arena.reset();
+        context->release(slot);
+    }
+}
+
+NormalStream &EngineContext::Lease::stream(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream) {
+    slot->stream.restart(generator, seed, stream);
+    return slot->stream;
+}
+
+EngineContext::Lease EngineContext::acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeSlots.empty()) {
+        slots.push_back(std::make_unique<Slot>(arenaBlockBytes));
+        freeSlots.reserve(slots.size());
+        return Lease(*this, *slots.back());
+    }
+    Slot *slot = freeSlots.back();
+    freeSlots.pop_back();
+    return Lease(*this, *slot);
+}
+
+void EngineContext::release(Slot *slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeSlots.push_back(slot);
+}
+
+ArenaStatistics EngineContext::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    ArenaStatistics total;
+    for (const std::unique_ptr<Slot> &slot : slots) {
+        ArenaStatistics arena = slot->arena.getStatistics();
+        total.heapAllocations += arena.heapAllocations;
+        total.bytesReserved += arena.bytesReserved;
+        total.bytesInUse += arena.bytesInUse;
+        total.peakBytesInUse += arena.peakBytesInUse;
+    }
+    return total;
+}
+
+std::size_t EngineContext::numSlots() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slots.size();
+}
+
+ThreadPool &EngineContext::threadPool() {
+    std::call_once(poolStarted, [this]() { pool = std::make_unique<ThreadPool>(numWorkers); });
+    return *pool;
+}
+
+EngineContext &EngineContext::shared() {
+    static EngineContext context;
+    return context;
+}
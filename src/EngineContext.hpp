@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "RandomStream.hpp"
+#include "ThreadPool.hpp"
+
+// Scratch memory for the engines. Path buffers are carved out of large 64-byte-aligned blocks by a bump allocator that is rewound,
+// never freed, between uses, and an EngineContext keeps a pool of such arenas (each with a reusable normal stream) that outlives
+// pricing calls. Once every arena has grown to the largest chunk it has served, simulating paths performs no heap allocation.
+
+// Counters of one arena, or of all the arenas of a context
+struct ArenaStatistics {
+    unsigned long long heapAllocations = 0; // blocks obtained from the heap since construction
+    std::size_t bytesReserved = 0;          // total size of those blocks
+    std::size_t bytesInUse = 0;             // handed out and not yet rewound
+    std::size_t peakBytesInUse = 0;
+};
+
+// Bump allocator over a list of 64-byte-aligned blocks. Allocations are released together by rewinding to a mark; blocks are kept
+// for the next user, so a workload that repeats reaches a steady state with no heap traffic. Not thread-safe: one arena per thread.
+class PathArena {
+public:
+    static const std::size_t alignment = 64; // a cache line, and one AVX-512 register
+
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+        std::size_t bytesInUse;
+    };
+
+    explicit PathArena(std::size_t blockBytes = 256 * 1024);
+    ~PathArena();
+    PathArena(const PathArena &) = delete;
+    PathArena &operator=(const PathArena &) = delete;
+
+    // Uninitialised, 64-byte-aligned storage for count values of a trivially destructible type, valid until the arena is rewound past it
+    template <typename T>
+    T *allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "PathArena never runs destructors");
+        return static_cast<T *>(allocateBytes(count * sizeof(T)));
+    }
+
+    Mark mark() const;
+    void rewind(const Mark &to);
+    void reset();
+
+    ArenaStatistics getStatistics() const;
+
+private:
+    struct Block {
+        unsigned char *data;
+        std::size_t size;
+    };
+
+    void *allocateBytes(std::size_t bytes);
+
+    std::size_t blockBytes;
+    std::vector<Block> blocks;
+    std::size_t currentBlock = 0;
+    std::size_t offset = 0;
+
+    // Read by EngineContext::getStatistics from other threads
+    std::atomic<unsigned long long> heapAllocations{0};
+    std::atomic<std::size_t> bytesReserved{0};
+    std::atomic<std::size_t> bytesInUse{0};
+    std::atomic<std::size_t> peakBytesInUse{0};
+};
+
+// Rewinds an arena to where it was when the scope was entered
+class ArenaScope {
+public:
+    explicit ArenaScope(PathArena &arena) : arena(arena), start(arena.mark()) {}
+    ~ArenaScope() { arena.rewind(start); }
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+private:
+    PathArena &arena;
+    PathArena::Mark start;
+};
+
+// A pool of arenas and normal streams shared by pricing calls and threads. Each task leases one slot for its duration; a lease
+// takes a free slot or, when all are taken, creates one, so the pool grows to the peak number of concurrent tasks and then stops
+// allocating. The context also owns the worker threads the engines run their chunks on, started on first use and kept until it is
+// destroyed. SimulationConfig::context selects the context of a call; without one the engines use EngineContext::shared().
+class EngineContext {
+private:
+    struct Slot {
+        explicit Slot(std::size_t arenaBlockBytes) : arena(arenaBlockBytes), stream(RandomGenerator::Philox, 0, 0) {}
+        PathArena arena;
+        NormalStream stream;
+    };
+
+public:
+    // numWorkers is the size of the thread pool; zero means one fewer than the hardware threads, and at least one
+    explicit EngineContext(std::size_t arenaBlockBytes = 256 * 1024, unsigned int numWorkers = 0);
+    EngineContext(const EngineContext &) = delete;
+    EngineContext &operator=(const EngineContext &) = delete;
+
+    // Exclusive use of one slot; its arena is reset and the slot returned to the pool when the lease ends
+    class Lease {
+    public:
+        Lease(EngineContext &context, Slot &slot) : context(&context), slot(&slot) {}
+        Lease(Lease &&other) noexcept : context(other.context), slot(other.slot) { other.slot = nullptr; }
+        Lease &operator=(Lease &&) = delete;
+        ~Lease();
+
+        PathArena &arena() { return slot->arena; }
+
+        // The slot's stream restarted as (generator, seed, stream), reusing its buffers
+        NormalStream &stream(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream);
+
+    private:
+        EngineContext *context;
+        Slot *slot;
+    };
+
+    Lease acquire();
+
+    // Totals over every slot; bytesInUse counts the leases still open, and peakBytesInUse is the sum of the per-arena peaks
+    ArenaStatistics getStatistics() const;
+    std::size_t numSlots() const;
+
+    // The worker threads of parallel calls on this context; a call uses up to SimulationConfig::numThreads - 1 of them
+    ThreadPool &threadPool();
+
+    // The context used by calls that do not name one
+    static EngineContext &shared();
+
+private:
+    void release(Slot *slot);
+
+    std::size_t arenaBlockBytes;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<Slot *> freeSlots; // capacity kept at slots.size(), so returning a slot never allocates
+    unsigned int numWorkers;
+    std::once_flag poolStarted;
+    std::unique_ptr<ThreadPool> pool;
+};
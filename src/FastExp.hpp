@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Cephes-style exp: x = n*ln2 + r with |r| <= ln2/2, exp(r) from a Pade approximant, and 2^n written straight into the exponent bits.
+// Rounding to n uses the 1.5*2^52 shifter trick so the whole function is plain arithmetic and vectorises; it is accurate to a couple
+// of ulp. Outside [-708, 709] the exponent bits come out as garbage, so Saturate clamps x first. The clamp is a compare-and-select,
+// which stops GCC vectorising AVX2 and baseline loops without -fno-trapping-math, so callers whose arguments are known to be in range
+// leave it off.
+template <bool Saturate = false>
+inline double expKernel(double x) {
+    const double shifter = 6755399441055744.0;
+    const std::int64_t shifterBits = 0x4338000000000000;
+
+    if (Saturate) {
+        x = std::min(std::max(x, -708.0), 709.0);
+    }
+
+    double t = x * 1.4426950408889634074 + shifter;
+    double n = t - shifter;
+    double r = x - n * 6.93145751953125e-1;
+    r -= n * 1.42860682030941723212e-6;
+
+    double rr = r * r;
+    double p = r * ((1.26177193074810590878e-4 * rr + 3.02994407707441961300e-2) * rr + 9.99999999999999999910e-1);
+    double q = ((3.00198505138664455042e-6 * rr + 2.52448340349684104192e-3) * rr + 2.27265548208155028766e-1) * rr + 2.0;
+    double expR = 1.0 + 2.0 * p / (q - p);
+
+    std::int64_t tBits;
+    std::memcpy(&tBits, &t, sizeof(t));
+    std::int64_t scaleBits = (tBits - shifterBits + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &scaleBits, sizeof(scale));
+    return expR * scale;
+}
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cmath>
+#include "FiniteDifference.hpp"
+
+void factorTridiagonal(unsigned int n, const double *lower, const double *diagonal, const double *upper, double *ratios, double *inversePivots) {
+    inversePivots[0] = 1.0 / diagonal[0];
+    for (unsigned int i = 1; i < n; ++i) {
+        ratios[i - 1] = upper[i - 1] * inversePivots[i - 1];
+        inversePivots[i] = 1.0 / (diagonal[i] - lower[i] * ratios[i - 1]);
+    }
+}
+
+void solveFactoredTridiagonal(unsigned int n, const double *lower, const double *ratios, const double *inversePivots, double *values) {
+    values[0] *= inversePivots[0];
+    for (unsigned int i = 1; i < n; ++i) {
+        values[i] = (values[i] - lower[i] * values[i - 1]) * inversePivots[i];
+    }
+    for (unsigned int i = n - 1; i > 0; --i) {
+        values[i - 1] -= ratios[i - 1] * values[i];
+    }
+}
+
+void solveTridiagonal(unsigned int n, const double *lower, const double *diagonal, const double *upper, double *values, double *scratch) {
+    double *inversePivots = scratch + (n - 1);
+    factorTridiagonal(n, lower, diagonal, upper, scratch, inversePivots);
+    solveFactoredTridiagonal(n, lower, scratch, inversePivots, values);
+}
+
+VecerValue solveVecerPde(const std::vector<double> &intervalEnds, const std::vector<double> &holdings, double volatility, Option::Type type, double z0,
+                         const FiniteDifferenceConfig &config, PathArena &arena) {
+    ArenaScope scope(arena);
+    unsigned int n = std::max(config.spaceSteps, 4u);
+    unsigned int timeSteps = std::max(config.timeSteps, 1u);
+    double expiry = intervalEnds.back();
+    double spread = volatility * std::sqrt(expiry);
+    double maxHolding = *std::max_element(holdings.begin(), holdings.end());
+
+    // Above the largest holding Z - q(t) can only grow, so Z_T > 0 and u is exactly the call's z or the put's 0 there. Below, Z - q moves
+    // roughly lognormally with volatility sigma, so six standard deviations of log-distance keep the lower boundary out of reach.
+    double zMax = std::max(z0, maxHolding) + maxHolding + 0.1;
+    double zMin = maxHolding - (maxHolding - std::min(z0, 0.0) + 0.1) * std::exp(6.0 * spread);
+
+    // Nodes z0 + alpha sinh(xi) on a uniform xi grid with z0 at node centre: fine where the solution bends, coarse towards the far boundaries
+    double alpha = 0.5 * std::max(spread, 0.01) * std::max(maxHolding - std::min(z0, 0.0), 0.1);
+    double xiMin = std::asinh((zMin - z0) / alpha);
+    double xiMax = std::asinh((zMax - z0) / alpha);
+    unsigned int centre = std::min(std::max(static_cast<unsigned int>(std::lround(n * -xiMin / (xiMax - xiMin))), 1u), n - 1);
+    double *z = arena.allocate<double>(n + 1);
+    for (unsigned int i = 0; i <= n; ++i) {
+        double xi = i <= centre ? xiMin * (centre - i) / centre : xiMax * (i - centre) / (n - centre);
+        z[i] = z0 + alpha * std::sinh(xi);
+    }
+    z[centre] = z0;
+
+    // Three-point second derivative on the non-uniform grid: u_zz(z_i) ~ below[i] u_{i-1} - (below[i] + above[i]) u_i + above[i] u_{i+1}
+    double *below = arena.allocate<double>(n + 1);
+    double *above = arena.allocate<double>(n + 1);
+    for (unsigned int i = 1; i < n; ++i) {
+        double hBelow = z[i] - z[i - 1];
+        double hAbove = z[i + 1] - z[i];
+        below[i] = 2.0 / (hBelow * (hBelow + hAbove));
+        above[i] = 2.0 / (hAbove * (hBelow + hAbove));
+    }
+
+    // Terminal payoff; the boundary values keep it, exactly at the top and to within the far tail at the bottom. The node whose cell
+    // holds the kink at z = 0 takes the payoff's cell average instead, so the error no longer depends on where the kink falls
+    double *u = arena.allocate<double>(n + 1);
+    double sign = type == Option::Type::Call ? 1.0 : -1.0;
+    for (unsigned int i = 0; i <= n; ++i) {
+        u[i] = std::max(sign * z[i], 0.0);
+        double cellLow = i > 0 ? 0.5 * (z[i - 1] + z[i]) : z[i];
+        double cellHigh = i < n ? 0.5 * (z[i] + z[i + 1]) : z[i];
+        if (cellLow < 0.0 && cellHigh > 0.0) {
+            double inTheMoney = sign > 0.0 ? cellHigh : -cellLow;
+            u[i] = inTheMoney * inTheMoney / (2.0 * (cellHigh - cellLow));
+        }
+    }
+
+    // Per interval and step size: the explicit operator's coefficients and the factorised implicit matrix, so each step is two sweeps
+    // of multiply-adds with no division
+    unsigned int interior = n - 1;
+    double *diffusion = arena.allocate<double>(n + 1);
+    double *explicitBelow = arena.allocate<double>(interior);
+    double *explicitCentre = arena.allocate<double>(interior);
+    double *explicitAbove = arena.allocate<double>(interior);
+    double *lower = arena.allocate<double>(interior);
+    double *diagonal = arena.allocate<double>(interior);
+    double *upper = arena.allocate<double>(interior);
+    double *ratios = arena.allocate<double>(interior);
+    double *inversePivots = arena.allocate<double>(interior);
+    double *values = arena.allocate<double>(interior);
+
+    // The theta scheme (I - theta dt L) u_new = (I + (1 - theta) dt L) u_old for steps of length dt backwards in time
+    auto prepare = [&](double dt, double theta) {
+        for (unsigned int i = 1; i < n; ++i) {
+            double implicitWeight = theta * dt * diffusion[i];
+            double explicitWeight = (1.0 - theta) * dt * diffusion[i];
+            explicitBelow[i - 1] = explicitWeight * below[i];
+            explicitCentre[i - 1] = 1.0 - explicitWeight * (below[i] + above[i]);
+            explicitAbove[i - 1] = explicitWeight * above[i];
+            lower[i - 1] = -implicitWeight * below[i];
+            diagonal[i - 1] = 1.0 + implicitWeight * (below[i] + above[i]);
+            upper[i - 1] = -implicitWeight * above[i];
+        }
+        factorTridiagonal(interior, lower, diagonal, upper, ratios, inversePivots);
+    };
+    auto step = [&]() {
+        for (unsigned int i = 1; i < n; ++i) {
+            values[i - 1] = explicitBelow[i - 1] * u[i - 1] + explicitCentre[i - 1] * u[i] + explicitAbove[i - 1] * u[i + 1];
+        }
+        values[0] -= lower[0] * u[0];
+        values[interior - 1] -= upper[interior - 1] * u[n];
+        solveFactoredTridiagonal(interior, lower, ratios, inversePivots, values);
+        std::copy(values, values + interior, u + 1);
+    };
+
+    // Piecewise-constant coefficients from expiry backwards: the schedule's own intervals, or for schedules with more fixing dates than
+    // time steps, uniform steps over which (q - z)^2 is averaged. Its mean is (qMean - z)^2 + qVariance, still quadratic in z, and using
+    // the mean over a step is as accurate as using the midpoint, while every step, not every fixing date, costs a factorisation.
+    std::size_t numIntervals = intervalEnds.size();
+    const double *ends = intervalEnds.data();
+    const double *qMean = holdings.data();
+    double *qVariance = arena.allocate<double>(std::max<std::size_t>(numIntervals, timeSteps));
+    std::fill(qVariance, qVariance + numIntervals, 0.0);
+    if (numIntervals > timeSteps) {
+        numIntervals = timeSteps;
+        double *mergedEnds = arena.allocate<double>(numIntervals);
+        double *mergedMean = arena.allocate<double>(numIntervals);
+        std::size_t k = 0;
+        for (std::size_t s = 0; s < numIntervals; ++s) {
+            double from = s == 0 ? 0.0 : mergedEnds[s - 1];
+            mergedEnds[s] = s + 1 == numIntervals ? expiry : expiry * (s + 1) / numIntervals;
+            double sum = 0.0, sumSquares = 0.0;
+            for (double at = from; at < mergedEnds[s] && k < intervalEnds.size();) {
+                double until = std::min(intervalEnds[k], mergedEnds[s]);
+                sum += (until - at) * holdings[k];
+                sumSquares += (until - at) * holdings[k] * holdings[k];
+                at = until;
+                if (until >= intervalEnds[k]) {
+                    ++k;
+                }
+            }
+            double length = mergedEnds[s] - from;
+            mergedMean[s] = sum / length;
+            qVariance[s] = std::max(sumSquares / length - mergedMean[s] * mergedMean[s], 0.0);
+        }
+        ends = mergedEnds;
+        qMean = mergedMean;
+    }
+
+    unsigned int stepsTaken = 0;
+    for (std::size_t k = numIntervals; k-- > 0;) {
+        double start = k == 0 ? 0.0 : ends[k - 1];
+        double length = ends[k] - start;
+        if (length <= 0.0) {
+            continue;
+        }
+        for (unsigned int i = 1; i < n; ++i) {
+            double distance = qMean[k] - z[i];
+            diffusion[i] = 0.5 * volatility * volatility * (distance * distance + qVariance[k]);
+        }
+        unsigned int numSteps = std::max(1u, static_cast<unsigned int>(std::lround(timeSteps * length / expiry)));
+        double dt = length / numSteps;
+        unsigned int halvedSteps = stepsTaken < config.rannacherSteps ? std::min(config.rannacherSteps - stepsTaken, numSteps) : 0;
+        if (halvedSteps > 0) {
+            prepare(0.5 * dt, 1.0);
+            for (unsigned int s = 0; s < 2 * halvedSteps; ++s) {
+                step();
+            }
+        }
+        if (numSteps > halvedSteps) {
+            prepare(dt, 0.5);
+            for (unsigned int s = halvedSteps; s < numSteps; ++s) {
+                step();
+            }
+        }
+        stepsTaken += numSteps;
+    }
+
+    // Derivatives at z0 from its two neighbours
+    double hBelow = z[centre] - z[centre - 1];
+    double hAbove = z[centre + 1] - z[centre];
+    VecerValue result;
+    result.value = u[centre];
+    result.slope = (hBelow * hBelow * u[centre + 1] + (hAbove * hAbove - hBelow * hBelow) * u[centre] - hAbove * hAbove * u[centre - 1])
+                   / (hBelow * hAbove * (hBelow + hAbove));
+    result.curvature = below[centre] * u[centre - 1] - (below[centre] + above[centre]) * u[centre] + above[centre] * u[centre + 1];
+    return result;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include "EngineContext.hpp"
+#include "Option.hpp"
+#include "PricingEngine.hpp"
+
+// Finite-difference solver for Vecer's reduced Asian PDE. A fixed-strike arithmetic Asian is replicated by holding q(t) shares, where
+// q(t) = (1/N) sum over the fixings t_i >= t of exp(-r (T - t_i)), and the rest in cash. The portfolio ends at the average minus the
+// strike, and its value measured in shares, z = X / S, follows dZ = sigma (q(t) - Z) dW under the share measure. The option is therefore
+// worth S u(0, z0), where u solves
+//   u_t + sigma^2 / 2 (q(t) - z)^2 u_zz = 0,   u(T, z) = max(z, 0) for a call, max(-z, 0) for a put,
+// a one-dimensional problem however many fixings there are. Discrete fixings only make q piecewise constant.
+
+// Solves the tridiagonal system with subdiagonal lower[1..n-1], diagonal[0..n-1] and superdiagonal upper[0..n-2] by the Thomas
+// algorithm. values holds the right-hand side on entry and the solution on return; scratch needs 2n - 1 values.
+void solveTridiagonal(unsigned int n, const double *lower, const double *diagonal, const double *upper, double *values, double *scratch);
+
+// The Thomas algorithm split in two, for a matrix used with many right-hand sides: the elimination ratios (n - 1 values) and inverse
+// pivots (n values) are computed once, and each solve is then a forward and a backward sweep without divisions
+void factorTridiagonal(unsigned int n, const double *lower, const double *diagonal, const double *upper, double *ratios, double *inversePivots);
+void solveFactoredTridiagonal(unsigned int n, const double *lower, const double *ratios, const double *inversePivots, double *values);
+
+// u and its first two z-derivatives at one point
+struct VecerValue {
+    double value;
+    double slope;
+    double curvature;
+};
+
+// Solves the reduced PDE backwards from expiry with Crank-Nicolson and returns u(0, z0). The z grid has z0 as a node and is stretched
+// by a sinh map, fine around z0 and the payoff kink and coarse towards the far boundaries. holdings[k] is q on (intervalEnds[k - 1],
+// intervalEnds[k]], starting from 0, and the last interval end is expiry. Each interval gets a share of config.timeSteps proportional
+// to its length (at least one); a schedule with more intervals than config.timeSteps is instead solved in that many uniform steps,
+// each with the coefficient averaged over it. The first config.rannacherSteps steps from expiry are each taken as two implicit Euler half steps,
+// which damps the oscillations the payoff kink causes in Crank-Nicolson. The grid's buffers come from arena, which is left as it was found.
+VecerValue solveVecerPde(const std::vector<double> &intervalEnds, const std::vector<double> &holdings, double volatility, Option::Type type, double z0,
+                         const FiniteDifferenceConfig &config, PathArena &arena);
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ImportanceSampling.hpp"
+
+namespace {
+
+double norm(const std::vector<double> &values) {
+    double sumSquares = 0.0;
+    for (double value : values) {
+        sumSquares += value * value;
+    }
+    return std::sqrt(sumSquares);
+}
+
+// The objective at z and, if gradient is given, its gradient there. The average moves with z_j through every fixing after step j,
+// so d(average)/dz_j = diffusion_j * sum over those fixings of d(average)/d(log fixing), a suffix sum taken backwards.
+double objectiveAndGradient(const KernelParameters &parameters, AsianOption::AveragingType averaging, Option::Type type, const std::vector<double> &z,
+                            std::vector<double> *gradient) {
+    bool arithmetic = averaging == AsianOption::AveragingType::Arithmetic;
+    unsigned int numSteps = parameters.numSteps;
+    std::vector<double> logSpots(numSteps);
+    double logSpot = std::log(parameters.spot);
+    double sumSpot = parameters.initialSum;
+    double sumLogSpot = parameters.initialLogSum;
+    double sumSquares = 0.0;
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        logSpot += parameters.drift[j] + parameters.diffusion[j] * z[j];
+        logSpots[j] = logSpot;
+        sumSpot += std::exp(logSpot);
+        sumLogSpot += logSpot;
+        sumSquares += z[j] * z[j];
+    }
+
+    double average = arithmetic ? sumSpot / parameters.averagingPeriods : std::exp(sumLogSpot / parameters.averagingPeriods);
+    double sign = type == Option::Type::Call ? 1.0 : -1.0;
+    double payoff = sign * (average - parameters.strike);
+    if (!(payoff > 0.0)) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    if (gradient) {
+        gradient->resize(numSteps);
+        double laterFixings = 0.0;
+        for (unsigned int j = numSteps; j-- > 0;) {
+            laterFixings += (arithmetic ? std::exp(logSpots[j]) : average) / parameters.averagingPeriods;
+            (*gradient)[j] = sign * parameters.diffusion[j] * laterFixings / payoff - z[j];
+        }
+    }
+    return std::log(payoff) - 0.5 * sumSquares;
+}
+
+} // namespace
+
+double importanceSamplingObjective(const KernelParameters &parameters, AsianOption::AveragingType averaging, Option::Type type, const std::vector<double> &z) {
+    return objectiveAndGradient(parameters, averaging, type, z, nullptr);
+}
+
+std::vector<double> optimalDriftShift(const KernelParameters &parameters, AsianOption::AveragingType averaging, Option::Type type) {
+    unsigned int numSteps = parameters.numSteps;
+    std::vector<double> z(numSteps, 0.0);
+    if (numSteps == 0) {
+        return z;
+    }
+
+    // Starting point: the best multiple of the unit direction in which step j raises (call) or lowers (put) the numSteps - j fixings after it.
+    // Deep out of the money, the origin pays nothing and the ascent needs a point that does.
+    double sign = type == Option::Type::Call ? 1.0 : -1.0;
+    std::vector<double> direction(numSteps);
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        direction[j] = sign * parameters.diffusion[j] * (numSteps - j);
+    }
+    double directionNorm = norm(direction);
+    if (directionNorm > 0.0) {
+        for (double &component : direction) {
+            component /= directionNorm;
+        }
+    }
+
+    double bestValue = importanceSamplingObjective(parameters, averaging, type, z);
+    double bestScale = 0.0;
+    std::vector<double> candidate(numSteps);
+    for (double scale = 1.0 / 16.0; scale <= 64.0; scale *= 2.0) {
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            candidate[j] = scale * direction[j];
+        }
+        double value = importanceSamplingObjective(parameters, averaging, type, candidate);
+        if (value > bestValue) {
+            bestValue = value;
+            bestScale = scale;
+        }
+    }
+    if (bestValue == -std::numeric_limits<double>::infinity()) {
+        return z;
+    }
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        z[j] = bestScale * direction[j];
+    }
+
+    // Gradient ascent; a full step is the fixed-point iteration theta <- grad(payoff) / payoff, halved while it fails to improve
+    std::vector<double> gradient, trial(numSteps), trialGradient;
+    double value = objectiveAndGradient(parameters, averaging, type, z, &gradient);
+    double stepSize = 1.0;
+    for (unsigned int iteration = 0; iteration < 1000 && stepSize > 1e-12; ++iteration) {
+        if (norm(gradient) <= 1e-10 * (1.0 + norm(z))) {
+            break;
+        }
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            trial[j] = z[j] + stepSize * gradient[j];
+        }
+        double trialValue = objectiveAndGradient(parameters, averaging, type, trial, &trialGradient);
+        if (trialValue > value) {
+            z.swap(trial);
+            gradient.swap(trialGradient);
+            value = trialValue;
+            stepSize = std::min(1.0, 2.0 * stepSize);
+        } else {
+            stepSize *= 0.5;
+        }
+    }
+    return z;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingKernel.hpp"
+
+// Importance sampling for the GBM kernel. The normals z_j driving the simulated steps are drawn from N(theta_j, 1) instead of N(0, 1),
+// and each payoff is multiplied by the likelihood ratio exp(-theta . z + |theta|^2 / 2), which keeps the estimate unbiased. The shift
+// theta moves paths into the exercise region, so an out-of-the-money contract no longer wastes almost every path on a zero payoff.
+//
+// The drift is the one of Glasserman, Heidelberger and Shahabuddin: the point z maximising log(payoff(z)) - |z|^2 / 2, the most likely
+// path among those that pay, at which the likelihood-ratio weighted payoff has zero variance to first order. It satisfies
+// theta = grad(payoff)(theta) / payoff(theta).
+
+// Log of the payoff of the path driven by normals z, minus |z|^2 / 2; -infinity where the payoff is zero
+double importanceSamplingObjective(const KernelParameters &parameters, AsianOption::AveragingType averaging, Option::Type type, const std::vector<double> &z);
+
+// Shift of the normal driving each of the parameters' numSteps steps, found by gradient ascent on importanceSamplingObjective from the best
+// point along the direction that raises every fixing. All zeros when no path pays (e.g. a put struck at zero) or nothing is simulated.
+std::vector<double> optimalDriftShift(const KernelParameters &parameters, AsianOption::AveragingType averaging, Option::Type type);
@@ -0,0 +1,123 @@
+#include <chrono>
+#include "Instrumentation.hpp"
+
+#if defined(ASIAN_PRICING_INSTRUMENTATION_RDTSC) && defined(__x86_64__)
+#include <x86intrin.h>
+#define INSTRUMENT_WITH_RDTSC 1
+#endif
+
+namespace {
+
+// Push-only list of every thread's block; blocks are never freed, only handed to the next thread
+std::atomic<ThreadInstrumentation *> blocks{nullptr};
+std::atomic<unsigned int> numBlocks{0};
+
+void clearBlock(ThreadInstrumentation &block) {
+    for (auto &count : block.counters) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    for (unsigned int i = 0; i < numInstrumentedPhases; ++i) {
+        block.phaseTicks[i].store(0, std::memory_order_relaxed);
+        block.phaseCalls[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ThreadInstrumentation *claimBlock() {
+    for (ThreadInstrumentation *block = blocks.load(std::memory_order_acquire); block; block = block->next) {
+        bool free = false;
+        if (!block->inUse.load(std::memory_order_relaxed) && block->inUse.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+            return block;
+        }
+    }
+
+    ThreadInstrumentation *block = new ThreadInstrumentation;
+    clearBlock(*block);
+    block->inUse.store(true, std::memory_order_relaxed);
+    block->next = blocks.load(std::memory_order_relaxed);
+    while (!blocks.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    numBlocks.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+// Gives the block back when its thread exits; the counts stay in it
+struct BlockLease {
+    ThreadInstrumentation *block = claimBlock();
+    ~BlockLease() { block->inUse.store(false, std::memory_order_release); }
+};
+
+} // namespace
+
+ThreadInstrumentation &threadInstrumentation() {
+    thread_local BlockLease lease;
+    return *lease.block;
+}
+
+std::uint64_t instrumentationTicks() {
+#ifdef INSTRUMENT_WITH_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+const char *instrumentedPhaseName(InstrumentedPhase phase) {
+    switch (phase) {
+        case InstrumentedPhase::Chunk: return "chunk";
+        case InstrumentedPhase::RandomNumbers: return "random_numbers";
+        case InstrumentedPhase::PathStepping: return "path_stepping";
+        case InstrumentedPhase::Payoff: return "payoff";
+        case InstrumentedPhase::Statistics: return "statistics";
+        default: return "unknown";
+    }
+}
+
+const char *instrumentedCounterName(InstrumentedCounter counter) {
+    switch (counter) {
+        case InstrumentedCounter::Paths: return "paths";
+        case InstrumentedCounter::Steps: return "steps";
+        case InstrumentedCounter::Normals: return "normals";
+        case InstrumentedCounter::Blocks: return "blocks";
+        case InstrumentedCounter::Chunks: return "chunks";
+        default: return "unknown";
+    }
+}
+
+InstrumentationReport instrumentationReport() {
+    InstrumentationReport report;
+    report.enabled = ASIAN_PRICING_INSTRUMENTATION != 0;
+#ifdef INSTRUMENT_WITH_RDTSC
+    report.clock = "cycles";
+#endif
+    report.threads = numBlocks.load(std::memory_order_relaxed);
+    for (ThreadInstrumentation *block = blocks.load(std::memory_order_acquire); block; block = block->next) {
+        for (unsigned int i = 0; i < numInstrumentedCounters; ++i) {
+            report.counters[i] += block->counters[i].load(std::memory_order_relaxed);
+        }
+        for (unsigned int i = 0; i < numInstrumentedPhases; ++i) {
+            report.phaseTicks[i] += block->phaseTicks[i].load(std::memory_order_relaxed);
+            report.phaseCalls[i] += block->phaseCalls[i].load(std::memory_order_relaxed);
+        }
+    }
+    return report;
+}
+
+void resetInstrumentation() {
+    for (ThreadInstrumentation *block = blocks.load(std::memory_order_acquire); block; block = block->next) {
+        clearBlock(*block);
+    }
+}
+
+void writeInstrumentationJson(std::ostream &output, const InstrumentationReport &report) {
+    output << "{\n  \"enabled\": " << (report.enabled ? "true" : "false") << ",\n  \"clock\": \"" << report.clock
+           << "\",\n  \"threads\": " << report.threads << ",\n  \"counters\": {";
+    for (unsigned int i = 0; i < numInstrumentedCounters; ++i) {
+        output << (i ? ", " : "") << '"' << instrumentedCounterName(static_cast<InstrumentedCounter>(i)) << "\": " << report.counters[i];
+    }
+    output << "},\n  \"phases\": {";
+    for (unsigned int i = 0; i < numInstrumentedPhases; ++i) {
+        output << (i ? "," : "") << "\n    \"" << instrumentedPhaseName(static_cast<InstrumentedPhase>(i)) << "\": {\"ticks\": "
+               << report.phaseTicks[i] << ", \"calls\": " << report.phaseCalls[i] << '}';
+    }
+    output << "\n  }\n}\n";
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// Hot-path instrumentation for the engines: scoped phase timers and event counters, kept per thread and summed on demand.
+// Built in only when ASIAN_PRICING_INSTRUMENTATION is defined to 1 (CMake option ASIAN_PRICING_INSTRUMENTATION); otherwise the
+// INSTRUMENT_* macros expand to nothing and the engines compile exactly as without them. Defining ASIAN_PRICING_INSTRUMENTATION_RDTSC
+// as well times phases in TSC cycles read with rdtsc (x86-64 only) instead of steady_clock nanoseconds.
+//
+// Each thread writes only its own cache-aligned block of counters, with relaxed atomic stores, so recording needs no locks and no
+// read-modify-write; instrumentationReport() sums the blocks of every thread that has recorded anything. A block is handed to a
+// new thread once its thread exits, so short-lived worker threads do not grow the list. Counts accumulate until resetInstrumentation().
+
+#ifndef ASIAN_PRICING_INSTRUMENTATION
+#define ASIAN_PRICING_INSTRUMENTATION 0
+#endif
+
+// Where engine time goes. Phases do not nest, except Chunk, which spans the whole of each chunk of paths.
+enum class InstrumentedPhase {
+    Chunk,         // one chunk of paths, end to end
+    RandomNumbers, // drawing normals (or quasi-random points) and laying them out for a block
+    PathStepping,  // exp and log-spot steps, with the running sums the averages are built from
+    Payoff,        // turning the sums into averages and payoffs
+    Statistics,    // accumulating payoffs (and control variates) into running statistics
+    Count
+};
+
+enum class InstrumentedCounter {
+    Paths,   // simulated paths (an antithetic pair counts once)
+    Steps,   // simulated path steps
+    Normals, // random normals drawn
+    Blocks,  // path blocks simulated
+    Chunks,  // chunks of paths simulated
+    Count
+};
+
+const unsigned int numInstrumentedPhases = static_cast<unsigned int>(InstrumentedPhase::Count);
+const unsigned int numInstrumentedCounters = static_cast<unsigned int>(InstrumentedCounter::Count);
+
+// Totals over all threads
+struct InstrumentationReport {
+    bool enabled = false;
+    const char *clock = "ns";                                  // unit of the phase ticks, "ns" or "cycles"
+    unsigned int threads = 0;                                  // per-thread blocks: the most threads that have recorded at once
+    std::uint64_t counters[numInstrumentedCounters] = {};
+    std::uint64_t phaseTicks[numInstrumentedPhases] = {};
+    std::uint64_t phaseCalls[numInstrumentedPhases] = {};
+
+    std::uint64_t counter(InstrumentedCounter counter) const { return counters[static_cast<unsigned int>(counter)]; }
+    std::uint64_t ticks(InstrumentedPhase phase) const { return phaseTicks[static_cast<unsigned int>(phase)]; }
+    std::uint64_t calls(InstrumentedPhase phase) const { return phaseCalls[static_cast<unsigned int>(phase)]; }
+};
+
+const char *instrumentedPhaseName(InstrumentedPhase phase);
+const char *instrumentedCounterName(InstrumentedCounter counter);
+
+InstrumentationReport instrumentationReport();
+void resetInstrumentation(); // zeroes every thread's counts; call while no engine is running
+
+// {"enabled": ..., "clock": ..., "threads": ..., "counters": {...}, "phases": {"chunk": {"ticks": ..., "calls": ...}, ...}}
+void writeInstrumentationJson(std::ostream &output, const InstrumentationReport &report);
+
+// One thread's counts, written only by that thread
+struct alignas(64) ThreadInstrumentation {
+    std::atomic<std::uint64_t> counters[numInstrumentedCounters];
+    std::atomic<std::uint64_t> phaseTicks[numInstrumentedPhases];
+    std::atomic<std::uint64_t> phaseCalls[numInstrumentedPhases];
+    std::atomic<bool> inUse;
+    ThreadInstrumentation *next;
+};
+
+// The calling thread's block, claimed on first use
+ThreadInstrumentation &threadInstrumentation();
+
+// Current time in the instrumentation clock
+std::uint64_t instrumentationTicks();
+
+inline void addToOwnCount(std::atomic<std::uint64_t> &count, std::uint64_t amount) {
+    count.store(count.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline void countInstrumentedEvent(InstrumentedCounter counter, std::uint64_t amount) {
+    addToOwnCount(threadInstrumentation().counters[static_cast<unsigned int>(counter)], amount);
+}
+
+// Adds the time from construction to destruction to a phase
+class PhaseTimer {
+public:
+    explicit PhaseTimer(InstrumentedPhase phase) : phase(static_cast<unsigned int>(phase)), start(instrumentationTicks()) {}
+    ~PhaseTimer() {
+        std::uint64_t elapsed = instrumentationTicks() - start;
+        ThreadInstrumentation &counts = threadInstrumentation();
+        addToOwnCount(counts.phaseTicks[phase], elapsed);
+        addToOwnCount(counts.phaseCalls[phase], 1);
+    }
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+    unsigned int phase;
+    std::uint64_t start;
+};
+
+#define INSTRUMENT_CONCATENATE_INNER(a, b) a##b
+#define INSTRUMENT_CONCATENATE(a, b) INSTRUMENT_CONCATENATE_INNER(a, b)
+
+#if ASIAN_PRICING_INSTRUMENTATION
+// Times the rest of the enclosing scope as the given InstrumentedPhase
+#define INSTRUMENT_PHASE(phase) PhaseTimer INSTRUMENT_CONCATENATE(instrumentPhaseTimer, __LINE__)(InstrumentedPhase::phase)
+// Adds amount to the given InstrumentedCounter
+#define INSTRUMENT_COUNT(counter, amount) countInstrumentedEvent(InstrumentedCounter::counter, static_cast<std::uint64_t>(amount))
+#else
+#define INSTRUMENT_PHASE(phase) static_cast<void>(0)
+// Names amount without evaluating it, so variables only used for counting do not trip -Wunused
+#define INSTRUMENT_COUNT(counter, amount) static_cast<void>(sizeof(amount))
+#endif
@@ -0,0 +1,10 @@
+#include <cmath>
+#include "MathUtils.hpp"
+
+double normalCdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double normalPdf(double x) {
+    return std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Standard normal cumulative distribution function
+double normalCdf(double x);
+
+// Standard normal probability density function
+double normalPdf(double x);
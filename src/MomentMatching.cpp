@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cmath>
+#include "FastExp.hpp"
+#include "MathUtils.hpp"
+#include "MomentMatching.hpp"
+
+// Build one clone per instruction set where the toolchain supports it, as for the path kernel
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define MOMENT_MATCHING_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef MOMENT_MATCHING_TARGETS
+#define MOMENT_MATCHING_TARGETS
+#endif
+
+namespace {
+
+// Trapezoidal grid over the standard normal: spectrally accurate for smooth integrands, and the tails past 8 hold under 1e-15
+const unsigned int numNodes = 65;
+const double nodeSpacing = 0.25;
+const double firstNode = -8.0;
+
+} // namespace
+
+AverageDistribution makeAverageDistribution(const AsianOption &option, double spot, double riskFreeRate, double volatility) {
+    const std::vector<double> &times = option.getFixingTimes();
+    std::size_t k = times.size();
+    double weight = 1.0 / option.getAveragingPeriods();
+    double variance = volatility * volatility;
+
+    AverageDistribution distribution;
+    distribution.known = option.getPastFixings() * option.getPastAverage() * weight;
+    distribution.weightedForwards.resize(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        distribution.weightedForwards[i] = weight * spot * std::exp(riskFreeRate * times[i]);
+        distribution.mean += distribution.weightedForwards[i];
+        distribution.deterministic += times[i] == 0.0 || volatility == 0.0 ? distribution.weightedForwards[i] : 0.0;
+    }
+
+    // For sorted times, sum_ij x_i x_j f(min(t_i, t_j)) = sum_i f(t_i) x_i (x_i + 2 sum_{j > i} x_j), one backward pass.
+    // E[R^2] takes f(t) = exp(sigma^2 t), the covariance of the log fixings.
+    double suffix = 0.0;
+    for (std::size_t i = k; i-- > 0;) {
+        double x = distribution.weightedForwards[i];
+        distribution.secondMoment += std::exp(variance * times[i]) * x * (x + 2.0 * suffix);
+        suffix += x;
+    }
+
+    // Loadings of the log fixings on the log geometric average of the same fixings, Cov(log S_i, log G) = weight sigma^2 sum_j min(t_i, t_j)
+    distribution.loadings.assign(k, 0.0);
+    double earlierTimes = 0.0;
+    double logVariance = 0.0;
+    for (std::size_t i = 0; i < k; ++i) {
+        earlierTimes += times[i];
+        distribution.loadings[i] = weight * variance * (earlierTimes + times[i] * (k - 1 - i));
+        logVariance += weight * distribution.loadings[i];
+    }
+    double largestConditionalVariance = 0.0;
+    for (std::size_t i = 0; i < k; ++i) {
+        distribution.loadings[i] = logVariance > 0.0 ? distribution.loadings[i] / std::sqrt(logVariance) : 0.0;
+        largestConditionalVariance = std::max(largestConditionalVariance, variance * times[i] - distribution.loadings[i] * distribution.loadings[i]);
+    }
+
+    // Given Z = z, log S_i is normal with mean shifted by loading_i z and covariances c_ij = sigma^2 min(t_i, t_j) - loading_i loading_j,
+    // so with g_i = E[S_i | z] / N, Var(R | z) = sum_ij g_i g_j (exp(c_ij) - 1). Bounding exp(c) - 1 by c + c^2 exp(max c) / 2 splits
+    // it into min-sums that the backward pass handles; |c_ij| never exceeds the largest c_ii.
+    double remainderFactor = 0.5 * std::exp(largestConditionalVariance);
+    std::vector<double> conditionalForwards(k), nodeRatios(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        double loading = distribution.loadings[i];
+        conditionalForwards[i] = distribution.weightedForwards[i] * std::exp(loading * firstNode - 0.5 * loading * loading);
+        nodeRatios[i] = std::exp(loading * nodeSpacing);
+    }
+    distribution.conditionalMean.resize(numNodes);
+    distribution.conditionalVariance.resize(numNodes);
+    distribution.nodeWeights.resize(numNodes);
+    double totalWeight = 0.0;
+    for (unsigned int node = 0; node < numNodes; ++node) {
+        double sumMin = 0.0, sumMinSquared = 0.0, sumMinLoadings = 0.0, sumLoading = 0.0, sumLoadingSquared = 0.0, mean = 0.0;
+        double suffixForwards = 0.0, suffixLoaded = 0.0;
+        for (std::size_t i = k; i-- > 0;) {
+            double g = conditionalForwards[i];
+            double loaded = g * distribution.loadings[i];
+            double m = variance * times[i];
+            sumMin += m * g * (g + 2.0 * suffixForwards);
+            sumMinSquared += m * m * g * (g + 2.0 * suffixForwards);
+            sumMinLoadings += m * loaded * (loaded + 2.0 * suffixLoaded);
+            sumLoading += loaded;
+            sumLoadingSquared += loaded * distribution.loadings[i];
+            mean += g;
+            suffixForwards += g;
+            suffixLoaded += loaded;
+            conditionalForwards[i] *= nodeRatios[i];
+        }
+        double linear = sumMin - sumLoading * sumLoading;
+        double quadratic = sumMinSquared - 2.0 * sumMinLoadings + sumLoadingSquared * sumLoadingSquared;
+        double z = firstNode + node * nodeSpacing;
+        distribution.conditionalMean[node] = mean;
+        distribution.conditionalVariance[node] = std::max(linear + remainderFactor * quadratic, 0.0);
+        distribution.nodeWeights[node] = normalPdf(z);
+        totalWeight += distribution.nodeWeights[node];
+    }
+    for (double &nodeWeight : distribution.nodeWeights) {
+        nodeWeight /= totalWeight;
+    }
+    return distribution;
+}
+
+namespace {
+
+// momentMatchingPayoffs on one block of count <= momentMatchingLanes contracts; the unused lanes repeat the last contract and are
+// discarded. The loops over the fixings and nodes run across the lanes innermost, and a lane whose root has converged stops moving
+// while the others finish, so each lane ends exactly where it would on its own.
+MOMENT_MATCHING_TARGETS
+void payoffLanes(const AverageDistribution &distribution, const double *strikes, const Option::Type *types, unsigned int count,
+                 MomentMatchingResult *results) {
+    const unsigned int lanes = momentMatchingLanes;
+    const std::vector<double> &means = distribution.conditionalMean;
+    const std::size_t numFixings = distribution.loadings.size();
+    double logVariance = distribution.mean > 0.0 ? std::log(distribution.secondMoment / (distribution.mean * distribution.mean)) : 0.0;
+
+    double remainingStrike[lanes], z[lanes];
+    bool call[lanes], undecided[lanes], searching[lanes];
+    for (unsigned int k = 0; k < lanes; ++k) {
+        unsigned int contract = std::min(k, count - 1);
+        call[k] = types[contract] == Option::Type::Call;
+        remainingStrike[k] = strikes[contract] - distribution.known;
+        z[k] = 0.0;
+
+        // Exercise is certain (or impossible) once the fixings that are already known, today's spot included, cover the strike
+        undecided[k] = remainingStrike[k] > distribution.deterministic && logVariance > 0.0;
+        searching[k] = undecided[k];
+        if (!undecided[k]) {
+            continue;
+        }
+
+        // E[R | Z = z] is increasing and convex in z, nearly exponential. Newton on it, started by interpolating the log of the
+        // tabulated means, finds the exercise boundary z* in two or three passes over the fixings.
+        std::size_t above = std::lower_bound(means.begin(), means.end(), remainingStrike[k]) - means.begin();
+        above = std::min<std::size_t>(std::max<std::size_t>(above, 1), numNodes - 1);
+        z[k] = firstNode + above * nodeSpacing;
+        if (means[above - 1] > distribution.deterministic) {
+            double low = std::log(means[above - 1] - distribution.deterministic);
+            double high = std::log(means[above] - distribution.deterministic);
+            z[k] -= nodeSpacing * (high - std::log(remainingStrike[k] - distribution.deterministic)) / (high - low);
+        }
+    }
+
+    // With z kept within +-40 the exponents stay far inside expKernel's range for any volatility and expiry a contract could have
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        double value[lanes], slope[lanes];
+        for (unsigned int k = 0; k < lanes; ++k) {
+            value[k] = -remainingStrike[k];
+            slope[k] = 0.0;
+        }
+        for (std::size_t i = 0; i < numFixings; ++i) {
+            double loading = distribution.loadings[i];
+            double forward = distribution.weightedForwards[i];
+            double shift = 0.5 * loading * loading;
+            for (unsigned int k = 0; k < lanes; ++k) {
+                double g = forward * expKernel(loading * z[k] - shift);
+                value[k] += g;
+                slope[k] += loading * g;
+            }
+        }
+        bool searchingAny = false;
+        for (unsigned int k = 0; k < lanes; ++k) {
+            if (searching[k]) {
+                double step = value[k] / slope[k];
+                z[k] = std::min(std::max(z[k] - step, -40.0), 40.0);
+                searching[k] = !(std::abs(step) < 1e-12);
+                searchingAny |= searching[k];
+            }
+        }
+        if (!searchingAny) {
+            break;
+        }
+    }
+
+    double lower[lanes];
+    for (unsigned int k = 0; k < lanes; ++k) {
+        lower[k] = call[k] ? -remainingStrike[k] * normalCdf(-z[k]) : remainingStrike[k] * normalCdf(z[k]);
+    }
+    for (std::size_t i = 0; i < numFixings; ++i) {
+        double loading = distribution.loadings[i];
+        double forward = distribution.weightedForwards[i];
+        for (unsigned int k = 0; k < lanes; ++k) {
+            lower[k] += call[k] ? forward * normalCdf(loading - z[k]) : -forward * normalCdf(z[k] - loading);
+        }
+    }
+
+    // Jensen gap per node, (sqrt(v + d^2) - |d|) / 2 written without cancellation
+    double gap[lanes] = {};
+    for (unsigned int node = 0; node < numNodes; ++node) {
+        double v = distribution.conditionalVariance[node];
+        if (!(v > 0.0)) {
+            continue;
+        }
+        double mean = means[node];
+        double weight = distribution.nodeWeights[node];
+        for (unsigned int k = 0; k < lanes; ++k) {
+            double distance = std::abs(mean - remainingStrike[k]);
+            gap[k] += weight * 0.5 * v / (std::sqrt(v + distance * distance) + distance);
+        }
+    }
+
+    for (unsigned int k = 0; k < count; ++k) {
+        MomentMatchingResult &result = results[k];
+        result = MomentMatchingResult();
+        if (!undecided[k]) {
+            double intrinsic = call[k] ? distribution.mean - remainingStrike[k] : remainingStrike[k] - distribution.mean;
+            result.price = result.lognormalPrice = result.lowerBound = result.upperBound = std::max(intrinsic, 0.0);
+            continue;
+        }
+
+        // Black's formula on the lognormal with R's mean and second moment
+        double stdDevLog = std::sqrt(logVariance);
+        double d1 = (std::log(distribution.mean / remainingStrike[k]) + 0.5 * logVariance) / stdDevLog;
+        double d2 = d1 - stdDevLog;
+        result.lognormalPrice = call[k] ? distribution.mean * normalCdf(d1) - remainingStrike[k] * normalCdf(d2)
+                                        : remainingStrike[k] * normalCdf(-d2) - distribution.mean * normalCdf(-d1);
+
+        // The bracket is rigorous, so moving the lognormal value into it can only bring it closer to the exact price
+        result.lowerBound = std::max(lower[k], 0.0);
+        result.upperBound = result.lowerBound + gap[k];
+        result.price = std::min(std::max(result.lognormalPrice, result.lowerBound), result.upperBound);
+        result.errorBound = std::max(result.price - result.lowerBound, result.upperBound - result.price);
+    }
+}
+
+} // namespace
+
+MomentMatchingResult momentMatchingPayoff(const AverageDistribution &distribution, double strike, Option::Type type) {
+    MomentMatchingResult result;
+    payoffLanes(distribution, &strike, &type, 1, &result);
+    return result;
+}
+
+void momentMatchingPayoffs(const AverageDistribution &distribution, const double *strikes, const Option::Type *types, std::size_t count,
+                           MomentMatchingResult *results) {
+    for (std::size_t first = 0; first < count; first += momentMatchingLanes) {
+        unsigned int width = static_cast<unsigned int>(std::min<std::size_t>(momentMatchingLanes, count - first));
+        payoffLanes(distribution, strikes + first, types + first, width, results + first);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingResult.hpp"
+
+// Analytic approximation of arithmetic-average options. The remaining part of the average, R = (1/N) sum_i S(t_i) over the fixings still
+// to come, is replaced by a lognormal with the same first two moments (Levy; Turnbull and Wakeman), and the option is priced with
+// Black's formula on R against the strike less the past fixings' share. The moments of the discrete average are exact sums over the
+// schedule, O(N) for N fixings.
+//
+// The approximation comes with a bracket that contains the exact price. With Z the standardised log of the geometric average of the
+// same fixings, conditioning on Z gives
+//   lower = E[(E[A | Z] - K)^+]                                  (Jensen; Curran, Rogers and Shi)
+//   upper = lower + E[(sqrt(Var(A | Z) + d^2) - |d|) / 2],  d = E[A | Z] - K
+// the upper bound because no variable with mean d and variance v has E[X^+] above (d + sqrt(d^2 + v)) / 2 (Lo, Scarf). The lower bound
+// is in closed form; the upper one is integrated over Z on a fixed grid, with Var(A | Z) bounded above by its Taylor expansion to
+// second order in the conditional covariances, which keeps every node O(N). Puts are bracketed the same way. The bracket is usually
+// much narrower than the lognormal approximation's own error, so the reported price is the lognormal value moved into it.
+
+// Distribution of an average's remaining part under GBM, computed once per market and schedule and shared by every strike and type
+struct AverageDistribution {
+    double known = 0.0;        // past fixings' share of the average
+    double mean = 0.0;         // E[R]
+    double secondMoment = 0.0; // E[R^2]
+    double deterministic = 0.0; // the part of R already certain: fixings today, or every fixing without volatility
+    std::vector<double> weightedForwards; // E[S(t_i)] / N per remaining fixing
+    std::vector<double> loadings;         // Cov(log S(t_i), Z), Z standard normal
+    std::vector<double> conditionalMean;     // E[R | Z = z] on the quadrature nodes
+    std::vector<double> conditionalVariance; // upper bound on Var(R | Z = z) on the same nodes
+    std::vector<double> nodeWeights;         // the nodes' shares of the standard normal measure
+};
+
+// Distribution of the remaining part of an arithmetic contract's average
+AverageDistribution makeAverageDistribution(const AsianOption &option, double spot, double riskFreeRate, double volatility);
+
+// Contracts on one distribution priced together by momentMatchingPayoffs, one per lane
+const unsigned int momentMatchingLanes = 8;
+
+// Undiscounted moment-matching value of the payoff and its bracket, for a strike and type on the distribution
+MomentMatchingResult momentMatchingPayoff(const AverageDistribution &distribution, double strike, Option::Type type);
+
+// momentMatchingPayoff for count contracts on the same distribution, results[i] for strikes[i] and types[i]. The contracts go through
+// structure-of-arrays lanes of momentMatchingLanes: the root finds share each pass over the fixings, with a vectorisable exp, and the
+// bracket shares each pass over the nodes. The lanes are compiled for AVX-512, AVX2 and baseline x86-64. A lane's result does not
+// depend on the contracts beside it, so every result equals momentMatchingPayoff.
+void momentMatchingPayoffs(const AverageDistribution &distribution, const double *strikes, const Option::Type *types, std::size_t count,
+                           MomentMatchingResult *results);
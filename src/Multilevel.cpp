@@ -0,0 +1,109 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "Multilevel.hpp"
+#include "PathKernel.hpp"
+
+namespace {
+
+// Indices (0 = today, i = after step i) of the fixings simulated with the given stride: every stride-th one and the last
+std::vector<unsigned int> gridPoints(unsigned int numSteps, unsigned int stride) {
+    std::vector<unsigned int> points = {0};
+    for (unsigned int i = stride; i < numSteps; i += stride) {
+        points.push_back(i);
+    }
+    if (numSteps > 0) {
+        points.push_back(numSteps);
+    }
+    return points;
+}
+
+// Number of fixings each index stands for on a grid: its own if it is a fixing after today, plus its interpolation weights in the
+// fixings between it and its neighbours; zero off the grid
+std::vector<double> fixingWeights(const std::vector<unsigned int> &points, const std::vector<double> &variance) {
+    std::vector<double> weights(variance.size(), 0.0);
+    for (std::size_t p = 0; p + 1 < points.size(); ++p) {
+        unsigned int a = points[p];
+        unsigned int b = points[p + 1];
+        weights[b] += 1.0;
+        double span = variance[b] - variance[a];
+        for (unsigned int i = a + 1; i < b; ++i) {
+            double w = span > 0.0 ? (variance[i] - variance[a]) / span : static_cast<double>(i - a) / (b - a);
+            weights[a] += 1.0 - w;
+            weights[b] += w;
+        }
+    }
+    return weights;
+}
+
+} // namespace
+
+unsigned int multilevelLevels(unsigned int numSteps) {
+    unsigned int levels = 1;
+    while ((1ull << (levels - 1)) < numSteps) {
+        ++levels;
+    }
+    return levels;
+}
+
+MultilevelGrid makeMultilevelGrid(const KernelParameters &parameters, unsigned int level) {
+    unsigned int numSteps = parameters.numSteps;
+    unsigned int finest = multilevelLevels(numSteps) - 1;
+    if (level > finest) {
+        throw std::invalid_argument("makeMultilevelGrid: level " + std::to_string(level) + " is finer than the schedule");
+    }
+
+    // Cumulative drift and variance of the log-spot at every fixing index
+    std::vector<double> drift(numSteps + 1, 0.0), variance(numSteps + 1, 0.0);
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        drift[j + 1] = drift[j] + parameters.drift[j];
+        variance[j + 1] = variance[j] + parameters.diffusion[j] * parameters.diffusion[j];
+    }
+
+    unsigned int stride = 1u << (finest - level);
+    std::vector<unsigned int> points = gridPoints(numSteps, stride);
+    std::vector<double> weights = fixingWeights(points, variance);
+
+    MultilevelGrid grid;
+    for (std::size_t p = 0; p < points.size(); ++p) {
+        grid.weight.push_back(weights[points[p]]);
+        if (p + 1 < points.size()) {
+            grid.drift.push_back(drift[points[p + 1]] - drift[points[p]]);
+            grid.diffusion.push_back(std::sqrt(variance[points[p + 1]] - variance[points[p]]));
+        }
+    }
+
+    // The coarser grid takes every other point of this one, so its weights sit on points this level simulates
+    if (level > 0) {
+        std::vector<double> coarseWeights = fixingWeights(gridPoints(numSteps, 2 * stride), variance);
+        for (unsigned int point : points) {
+            grid.coarseWeight.push_back(coarseWeights[point]);
+        }
+    }
+    return grid;
+}
+
+void simulateMultilevelBlock(const MultilevelGrid &grid, double spot, bool logarithms, const double *normals, double *fine, double *coarse) {
+    bool hasCoarse = !grid.coarseWeight.empty();
+    double start = logarithms ? std::log(spot) : spot;
+    double logSpot[pathBlockWidth];
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        logSpot[k] = std::log(spot);
+        fine[k] = grid.weight[0] * start;
+        coarse[k] = hasCoarse ? grid.coarseWeight[0] * start : 0.0;
+    }
+
+    for (unsigned int j = 0; j < grid.numSteps(); ++j) {
+        const double *stepNormals = normals + j * pathBlockWidth;
+        double drift = grid.drift[j];
+        double diffusion = grid.diffusion[j];
+        double fineWeight = grid.weight[j + 1];
+        double coarseWeight = hasCoarse ? grid.coarseWeight[j + 1] : 0.0;
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            logSpot[k] += drift + diffusion * stepNormals[k];
+            double fixing = logarithms ? logSpot[k] : fastExp(logSpot[k]);
+            fine[k] += fineWeight * fixing;
+            coarse[k] += coarseWeight * fixing;
+        }
+    }
+}
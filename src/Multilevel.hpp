@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include "PricingKernel.hpp"
+
+// Monitoring grids for multilevel Monte Carlo. Level l of L simulates a path only at every 2^(L - l)-th remaining fixing date (and the
+// last), so level L is the contract's own schedule and level 0 a single step to expiry. A fixing between two grid points a and b is
+// replaced by the interpolation (1 - w) S_a + w S_b with w = (v_i - v_a) / (v_b - v_a), v the cumulative variance of the log-spot:
+// the conditional mean of S_i given the grid to leading order, and exactly that of log S_i for the geometric average. Each grid point
+// therefore stands for a weighted number of fixings, and a path costs one step per grid point however many fixings it covers.
+
+struct MultilevelGrid {
+    std::vector<double> drift;        // per step between consecutive grid points
+    std::vector<double> diffusion;
+    std::vector<double> weight;       // per grid point, today first: the number of fixings it stands for
+    std::vector<double> coarseWeight; // the next coarser level's weights on the same points, zero where it has none; empty on level 0
+
+    unsigned int numSteps() const { return static_cast<unsigned int>(drift.size()); }
+};
+
+// Number of levels for a schedule of numSteps simulated steps, so that the finest is the schedule itself
+unsigned int multilevelLevels(unsigned int numSteps);
+
+// Grid of the given level, from the step coefficients of the contract's own schedule
+MultilevelGrid makeMultilevelGrid(const KernelParameters &parameters, unsigned int level);
+
+// Advances a block of pathBlockWidth paths from spot over the grid, normals laid out step-major as for the block kernel.
+// On return fine[k] and coarse[k] hold path k's weighted sums of the grid fixings under the level's and the coarser level's weights,
+// today's spot included; of the fixings themselves, or of their logarithms when logarithms is set.
+void simulateMultilevelBlock(const MultilevelGrid &grid, double spot, bool logarithms, const double *normals, double *fine, double *coarse);
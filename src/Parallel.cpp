@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include "Parallel.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+// Shared with the helper tasks, which may still be queued on the pool after the call has returned
+struct LoopState {
+    std::mutex mutex;
+    std::condition_variable idle;
+    unsigned int running = 0; // helpers inside the loop
+    bool finished = false;    // set by the caller; helpers starting later return at once
+};
+
+} // namespace
+
+void parallelFor(ThreadPool &pool, unsigned int count, unsigned int numThreads, const std::function<void(unsigned int)>& body) {
+    unsigned int workers = std::min(std::min(std::max(numThreads, 1u), count), pool.size() + 1);
+
+    if (workers <= 1) {
+        for (unsigned int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<unsigned int> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto work = [&]() {
+        try {
+            for (unsigned int i = next++; i < count; i = next++) {
+                body(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = count; // stop handing out work to the other threads
+        }
+    };
+
+    std::shared_ptr<LoopState> state = std::make_shared<LoopState>();
+    for (unsigned int t = 1; t < workers; ++t) {
+        pool.submit([state, &work]() {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->finished) {
+                    return;
+                }
+                ++state->running;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->running == 0) {
+                state->idle.notify_all();
+            }
+        });
+    }
+    work();
+
+    // Every index has been handed out; wait for the helpers still finishing theirs
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished = true;
+        state->idle.wait(lock, [&state]() { return state->running == 0; });
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
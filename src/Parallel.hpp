@@ -0,0 +1,11 @@
+#pragma once
+
+#include <functional>
+
+class ThreadPool;
+
+// Runs body(index) for every index in [0, count) on the calling thread and up to numThreads - 1 workers of pool.
+// Indices are handed out dynamically so uneven work is balanced; any exception thrown by body is rethrown once all threads have stopped.
+// The caller only waits for workers that have started on the loop, so a busy pool, or a call made from one of its own workers, never
+// deadlocks: the calling thread then does the work the workers did not get to.
+void parallelFor(ThreadPool &pool, unsigned int count, unsigned int numThreads, const std::function<void(unsigned int)>& body);
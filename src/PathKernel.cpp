@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cmath>
+#include "FastExp.hpp"
+#include "PathKernel.hpp"
+
+// Build one clone of the kernel per instruction set and dispatch at load time where the toolchain supports it
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define PATH_KERNEL_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef PATH_KERNEL_TARGETS
+#define PATH_KERNEL_TARGETS
+#endif
+
+namespace {
+
+// The kernels add |step| to reach[k] as they go, so by the triangle inequality reach[k] bounds every |log-spot| of path k. A block
+// whose bounds all stay below this limit (left well inside [-708, 709] for rounding) never needs the clamp; any other is re-run with it.
+const double expKernelReach = 700.0;
+
+inline bool withinExpRange(const double *reach) {
+    bool within = true;
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        within &= reach[k] <= expKernelReach;
+    }
+    return within;
+}
+
+template <bool Saturate>
+inline __attribute__((always_inline)) bool pathBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                                                     double *sumSpot, double *sumLogSpot) {
+    double logSpot[pathBlockWidth];
+    double reach[pathBlockWidth];
+    double logSpot0 = std::log(spot);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        logSpot[k] = logSpot0;
+        reach[k] = std::fabs(logSpot0);
+        sumSpot[k] = spot;
+        sumLogSpot[k] = logSpot0;
+    }
+
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        const double *stepNormals = normals + j * pathBlockWidth;
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double step = drift + diffusion * stepNormals[k];
+            logSpot[k] += step;
+            reach[k] += std::fabs(step);
+            sumSpot[k] += expKernel<Saturate>(logSpot[k]);
+            sumLogSpot[k] += logSpot[k];
+        }
+    }
+    return withinExpRange(reach);
+}
+
+template <bool Saturate>
+inline __attribute__((always_inline)) bool scheduleBlock(double spot, const double *drift, const double *diffusion, double diffusionSign,
+                                                         const double *normals, unsigned int numSteps, double initialSum, double initialLogSum,
+                                                         double *sumSpot, double *sumLogSpot) {
+    double logSpot[pathBlockWidth];
+    double reach[pathBlockWidth];
+    double logSpot0 = std::log(spot);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        logSpot[k] = logSpot0;
+        reach[k] = std::fabs(logSpot0);
+        sumSpot[k] = initialSum;
+        sumLogSpot[k] = initialLogSum;
+    }
+
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        const double *stepNormals = normals + j * pathBlockWidth;
+        double stepDrift = drift[j];
+        double stepDiffusion = diffusionSign * diffusion[j];
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double step = stepDrift + stepDiffusion * stepNormals[k];
+            logSpot[k] += step;
+            reach[k] += std::fabs(step);
+            sumSpot[k] += expKernel<Saturate>(logSpot[k]);
+            sumLogSpot[k] += logSpot[k];
+        }
+    }
+    return withinExpRange(reach);
+}
+
+template <bool Saturate>
+inline __attribute__((always_inline)) bool sensitivityBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                                                            double *sumSpot, double *sumLogSpot, double *sumSpotStep, double *sumSpotNormal,
+                                                            double *sumNormal) {
+    double logSpot[pathBlockWidth];
+    double reach[pathBlockWidth];
+    double brownian[pathBlockWidth];
+    double logSpot0 = std::log(spot);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        logSpot[k] = logSpot0;
+        reach[k] = std::fabs(logSpot0);
+        brownian[k] = 0.0;
+        sumSpot[k] = spot;
+        sumLogSpot[k] = logSpot0;
+        sumSpotStep[k] = 0.0;
+        sumSpotNormal[k] = 0.0;
+        sumNormal[k] = 0.0;
+    }
+
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        const double *stepNormals = normals + j * pathBlockWidth;
+        double step = j + 1.0;
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double increment = drift + diffusion * stepNormals[k];
+            logSpot[k] += increment;
+            reach[k] += std::fabs(increment);
+            brownian[k] += stepNormals[k];
+            double spotK = expKernel<Saturate>(logSpot[k]);
+            sumSpot[k] += spotK;
+            sumLogSpot[k] += logSpot[k];
+            sumSpotStep[k] += step * spotK;
+            sumSpotNormal[k] += spotK * brownian[k];
+            sumNormal[k] += brownian[k];
+        }
+    }
+    return withinExpRange(reach);
+}
+
+// Leaves the final log-spots in finish rather than logSpot, so a rejected tile can be re-run from the same start
+template <bool Saturate>
+inline __attribute__((always_inline)) bool pathTile(const double *drift, const double *diffusion, const double *normals, unsigned int numSteps,
+                                                    const double *logSpot, double *finish, double *spots, double *logSpots) {
+    double current[pathBlockWidth];
+    double reach[pathBlockWidth];
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        current[k] = logSpot[k];
+        reach[k] = std::fabs(logSpot[k]);
+    }
+
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        const double *stepNormals = normals + j * pathBlockWidth;
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double step = drift[j] + diffusion[j] * stepNormals[k];
+            current[k] += step;
+            reach[k] += std::fabs(step);
+            logSpots[j * pathBlockWidth + k] = current[k];
+            spots[j * pathBlockWidth + k] = expKernel<Saturate>(current[k]);
+        }
+    }
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        finish[k] = current[k];
+    }
+    return withinExpRange(reach);
+}
+
+} // namespace
+
+double fastExp(double x) {
+    return expKernel<true>(x);
+}
+
+PATH_KERNEL_TARGETS
+void simulatePathBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                       double *sumSpot, double *sumLogSpot) {
+    if (!pathBlock<false>(spot, drift, diffusion, normals, numSteps, sumSpot, sumLogSpot)) {
+        pathBlock<true>(spot, drift, diffusion, normals, numSteps, sumSpot, sumLogSpot);
+    }
+}
+
+PATH_KERNEL_TARGETS
+void simulateScheduleBlock(double spot, const double *drift, const double *diffusion, double diffusionSign, const double *normals, unsigned int numSteps,
+                           double initialSum, double initialLogSum, double *sumSpot, double *sumLogSpot) {
+    if (!scheduleBlock<false>(spot, drift, diffusion, diffusionSign, normals, numSteps, initialSum, initialLogSum, sumSpot, sumLogSpot)) {
+        scheduleBlock<true>(spot, drift, diffusion, diffusionSign, normals, numSteps, initialSum, initialLogSum, sumSpot, sumLogSpot);
+    }
+}
+
+PATH_KERNEL_TARGETS
+void simulateSensitivityBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                              double *sumSpot, double *sumLogSpot, double *sumSpotStep, double *sumSpotNormal, double *sumNormal) {
+    if (!sensitivityBlock<false>(spot, drift, diffusion, normals, numSteps, sumSpot, sumLogSpot, sumSpotStep, sumSpotNormal, sumNormal)) {
+        sensitivityBlock<true>(spot, drift, diffusion, normals, numSteps, sumSpot, sumLogSpot, sumSpotStep, sumSpotNormal, sumNormal);
+    }
+}
+
+PATH_KERNEL_TARGETS
+void advancePathTile(const double *drift, const double *diffusion, const double *normals, unsigned int numSteps,
+                     double *logSpot, double *spots, double *logSpots) {
+    double finish[pathBlockWidth];
+    if (!pathTile<false>(drift, diffusion, normals, numSteps, logSpot, finish, spots, logSpots)) {
+        pathTile<true>(drift, diffusion, normals, numSteps, logSpot, finish, spots, logSpots);
+    }
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        logSpot[k] = finish[k];
+    }
+}
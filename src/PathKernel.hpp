@@ -0,0 +1,34 @@
+#pragma once
+
+// Number of paths advanced together by the block kernel (one AVX-512 register, or two AVX2 registers, of doubles)
+const unsigned int pathBlockWidth = 8;
+
+// Branch-free exp() that the compiler can vectorise; accurate to a couple of ulp on [-708, 709], and saturating outside it.
+// The block kernels below use the same approximation and fall back to the saturating form for any block that could leave that range.
+double fastExp(double x);
+
+// Advances a block of pathBlockWidth GBM paths through numSteps log-space steps, stored structure-of-arrays:
+// normals[j * pathBlockWidth + k] is the normal driving step j of path k. Every path starts at spot, which counts as its first fixing.
+// On return sumSpot[k] holds the sum of the fixings of path k and sumLogSpot[k] the sum of their logarithms.
+// The kernel is compiled for AVX-512, AVX2 and baseline x86-64 and the best version is picked at load time.
+void simulatePathBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                       double *sumSpot, double *sumLogSpot);
+
+// simulatePathBlock for a schedule with per-step coefficients: step j moves the log-spot of path k by
+// drift[j] + diffusionSign * diffusion[j] * normals[j * pathBlockWidth + k], with diffusionSign -1 for the antithetic paths.
+// The sums start from initialSum and initialLogSum, the fixings already known before the first step (past fixings of a seasoned
+// contract, and the spot when it is a fixing), so every path starts at spot whether or not it counts towards the average.
+void simulateScheduleBlock(double spot, const double *drift, const double *diffusion, double diffusionSign, const double *normals, unsigned int numSteps,
+                           double initialSum, double initialLogSum, double *sumSpot, double *sumLogSpot);
+
+// Same paths as simulatePathBlock, also accumulating what pathwise sensitivities need. With W_i the sum of the first i normals of a path,
+// on return sumSpotStep[k] holds sum_i i * S_i, sumSpotNormal[k] holds sum_i S_i * W_i and sumNormal[k] holds sum_i W_i, over all fixings i.
+void simulateSensitivityBlock(double spot, double drift, double diffusion, const double *normals, unsigned int numSteps,
+                              double *sumSpot, double *sumLogSpot, double *sumSpotStep, double *sumSpotNormal, double *sumNormal);
+
+// Advances a block of pathBlockWidth paths through numSteps steps of a schedule with per-step coefficients: step j moves the log-spot
+// of path k by drift[j] + diffusion[j] * normals[j * pathBlockWidth + k]. logSpot[k] holds the starting log-spot of path k and is
+// updated in place, so a long schedule can be advanced one tile at a time; spots and logSpots receive every new fixing in the
+// normals' layout.
+void advancePathTile(const double *drift, const double *diffusion, const double *normals, unsigned int numSteps,
+                     double *logSpot, double *spots, double *logSpots);
@@ -0,0 +1,27 @@
+#include <cmath>
+#include <stdexcept>
+#include "PathStream.hpp"
+
+StepTable makeStepTable(double spot, double riskFreeRate, double volatility, const std::vector<double> &fixingTimes) {
+    if (!fixingTimes.empty() && fixingTimes.front() < 0.0) {
+        throw std::invalid_argument("makeStepTable requires fixing times on or after today");
+    }
+
+    StepTable table;
+    table.spot = spot;
+    table.logSpot = std::log(spot);
+    table.spotIsFixing = !fixingTimes.empty() && fixingTimes.front() == 0.0;
+
+    double driftRate = riskFreeRate - 0.5 * volatility * volatility;
+    double previous = 0.0;
+    for (std::size_t i = table.spotIsFixing ? 1 : 0; i < fixingTimes.size(); ++i) {
+        double step = fixingTimes[i] - previous;
+        if (!(step > 0.0)) {
+            throw std::invalid_argument("makeStepTable requires strictly increasing fixing times");
+        }
+        table.drift.push_back(driftRate * step);
+        table.diffusion.push_back(volatility * std::sqrt(step));
+        previous = fixingTimes[i];
+    }
+    return table;
+}
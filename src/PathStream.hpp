@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "EngineContext.hpp"
+#include "PathKernel.hpp"
+#include "RandomStream.hpp"
+
+// Streaming GBM paths: the drift and diffusion of every step are tabulated once per pricing call, and paths are advanced one tile of
+// steps at a time with each fixing pushed to a consumer as soon as it is simulated. Nothing proportional to the number of fixings is
+// kept per path, so daily-averaged contracts with thousands of fixings cost time but no memory, and geometric averages are built
+// from log-spots so they cannot overflow.
+
+// Per-step coefficients of a fixing schedule. Step j moves the log-spot from fixing time t_j to t_{j+1}, starting from today
+// (the first step is skipped when a fixing falls today, in which case the spot itself is the first fixing).
+struct StepTable {
+    double spot;
+    double logSpot;
+    bool spotIsFixing;
+    std::vector<double> drift;     // (r - sigma^2 / 2)(t_{j+1} - t_j)
+    std::vector<double> diffusion; // sigma sqrt(t_{j+1} - t_j)
+
+    unsigned int numSteps() const { return static_cast<unsigned int>(drift.size()); }
+    unsigned int numFixings() const { return numSteps() + (spotIsFixing ? 1 : 0); }
+};
+
+// Step table for fixings at the given times in years from today. Times must be non-negative and strictly increasing; a fixing at
+// time 0 is the spot. An empty schedule (every fixing already observed) gives an empty table. Throws std::invalid_argument otherwise.
+StepTable makeStepTable(double spot, double riskFreeRate, double volatility, const std::vector<double> &fixingTimes);
+
+// Steps advanced per tile; bounds the streaming generator's buffers whatever the length of the schedule
+const unsigned int pathTileSteps = 64;
+
+// Simulates blocks of up to pathBlockWidth paths of a step table and pushes their fixings to a consumer.
+// Path k of a block uses the same normals as in the block kernels (the stream's next numSteps normals after path k - 1), so it
+// reproduces them up to rounding. Philox streams are read lane by lane by seeking; a Mersenne Twister stream cannot seek, so the
+// whole block's normals are drawn up front, which costs numSteps * pathBlockWidth doubles.
+class PathStreamer {
+public:
+    // The tile buffers come from the arena and live until it is rewound
+    PathStreamer(const StepTable &table, PathArena &arena)
+            : table(table), normals(arena.allocate<double>(pathTileSteps * pathBlockWidth)), spots(arena.allocate<double>(pathTileSteps * pathBlockWidth)),
+              logSpots(arena.allocate<double>(pathTileSteps * pathBlockWidth)), laneNormals(arena.allocate<double>(pathTileSteps)) {
+        std::fill(normals, normals + pathTileSteps * pathBlockWidth, 0.0); // lanes past a short block's width stay finite
+    }
+
+    // Simulates the next width paths of the stream, calling consumer(fixing, spots, logSpots) for every fixing in time order;
+    // spots and logSpots hold pathBlockWidth lanes, of which the first width are live
+    template <typename Consumer>
+    void simulateBlock(NormalStream &stream, unsigned int width, Consumer &&consumer) {
+        const unsigned int numSteps = table.numSteps();
+        double logSpot[pathBlockWidth];
+        std::fill(logSpot, logSpot + pathBlockWidth, table.logSpot);
+
+        unsigned int fixing = 0;
+        if (table.spotIsFixing) {
+            std::fill(spots, spots + pathBlockWidth, table.spot);
+            std::fill(logSpots, logSpots + pathBlockWidth, table.logSpot);
+            consumer(fixing++, spots, logSpots);
+        }
+
+        const bool seekable = stream.seekable();
+        const std::uint64_t origin = stream.tell();
+        const double *blockNormals = seekable ? nullptr : stream.draw(static_cast<std::size_t>(width) * numSteps);
+
+        for (unsigned int first = 0; first < numSteps; first += pathTileSteps) {
+            unsigned int count = std::min(pathTileSteps, numSteps - first);
+            for (unsigned int k = 0; k < width; ++k) {
+                const double *lane = blockNormals + static_cast<std::size_t>(k) * numSteps + first;
+                if (seekable) {
+                    stream.seek(origin + static_cast<std::uint64_t>(k) * numSteps + first);
+                    stream.fill(laneNormals, count);
+                    lane = laneNormals;
+                }
+                for (unsigned int j = 0; j < count; ++j) {
+                    normals[j * pathBlockWidth + k] = lane[j];
+                }
+            }
+
+            advancePathTile(table.drift.data() + first, table.diffusion.data() + first, normals, count, logSpot, spots, logSpots);
+            for (unsigned int j = 0; j < count; ++j) {
+                consumer(fixing++, spots + j * pathBlockWidth, logSpots + j * pathBlockWidth);
+            }
+        }
+
+        if (seekable) {
+            stream.seek(origin + static_cast<std::uint64_t>(width) * numSteps);
+        }
+    }
+
+private:
+    const StepTable &table;
+    double *normals;     // one tile, step-major
+    double *spots;       // one tile of fixings, step-major
+    double *logSpots;
+    double *laneNormals; // one tile of one path's normals
+};
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "PriceCache.hpp"
+#include "EngineContext.hpp"
+#include "Parallel.hpp"
+
+namespace {
+
+// Second derivatives of the natural cubic spline through n equally spaced values y[0], y[stride], ..., written with the same stride.
+// The interior equations M_{i-1} + 4 M_i + M_{i+1} = 6 (y_{i+1} - 2 y_i + y_{i-1}) / h^2 are tridiagonal and solved by the Thomas algorithm.
+void naturalSplineCurvature(const double *y, std::size_t stride, unsigned int n, double h, double *curvature) {
+    curvature[0] = 0.0;
+    curvature[(n - 1) * stride] = 0.0;
+    if (n < 3) {
+        return;
+    }
+
+    std::vector<double> upper(n), rhs(n);
+    for (unsigned int i = 1; i + 1 < n; ++i) {
+        double d = 6.0 * (y[(i + 1) * stride] - 2.0 * y[i * stride] + y[(i - 1) * stride]) / (h * h);
+        double pivot = 4.0 - (i > 1 ? upper[i - 1] : 0.0);
+        upper[i] = 1.0 / pivot;
+        rhs[i] = (d - (i > 1 ? rhs[i - 1] : 0.0)) / pivot;
+    }
+    double next = 0.0;
+    for (unsigned int i = n - 1; i-- > 1;) {
+        next = rhs[i] - upper[i] * next;
+        curvature[i * stride] = next;
+    }
+}
+
+// Value, slope and curvature at fraction t of one spline piece of width h between values y0, y1 with curvatures m0, m1
+struct SplinePoint {
+    double value;
+    double slope;
+    double curvature;
+};
+
+SplinePoint splinePiece(double t, double h, double y0, double y1, double m0, double m1) {
+    double a = 1.0 - t;
+    double b = t;
+    SplinePoint point;
+    point.value = a * y0 + b * y1 + ((a * a * a - a) * m0 + (b * b * b - b) * m1) * h * h / 6.0;
+    point.slope = (y1 - y0) / h + ((3.0 * b * b - 1.0) * m1 - (3.0 * a * a - 1.0) * m0) * h / 6.0;
+    point.curvature = a * m0 + b * m1;
+    return point;
+}
+
+// Piece of an axis holding x, and the fraction of the way across it
+std::pair<unsigned int, double> locate(const GridAxis &axis, double x) {
+    double position = (x - axis.lower) / axis.step();
+    unsigned int piece = std::min(static_cast<unsigned int>(position), axis.points - 2);
+    return {piece, position - piece};
+}
+
+void checkAxis(const GridAxis &axis, const char *name) {
+    if (axis.points < 2 || !(axis.upper > axis.lower)) {
+        throw std::invalid_argument(std::string("PriceSurface requires at least two increasing ") + name + " nodes");
+    }
+}
+
+} // namespace
+
+PriceSurface::PriceSurface(const AsianOption &option, double riskFreeRate, const GridAxis &spotAxis, const GridAxis &volatilityAxis,
+                           unsigned int numSimulations, const SimulationConfig &config)
+        : spotAxis(spotAxis), volatilityAxis(volatilityAxis) {
+    checkAxis(spotAxis, "spot");
+    checkAxis(volatilityAxis, "volatility");
+    if (!(volatilityAxis.lower > 0.0)) {
+        throw std::invalid_argument("PriceSurface requires positive volatilities");
+    }
+
+    const unsigned int numSpots = spotAxis.points;
+    const unsigned int numVolatilities = volatilityAxis.points;
+    std::size_t numNodes = static_cast<std::size_t>(numSpots) * numVolatilities;
+    prices.resize(numNodes);
+    spotCurvature.resize(numNodes);
+    volatilityCurvature.resize(numNodes);
+    crossCurvature.resize(numNodes);
+
+    // Nodes are priced one per thread; each node on its own reproduces calculatePriceGBM with this configuration
+    SimulationConfig nodeConfig = config;
+    nodeConfig.numThreads = 1;
+    EngineContext &context = config.context ? *config.context : EngineContext::shared();
+    parallelFor(context.threadPool(), static_cast<unsigned int>(numNodes), config.numThreads, [&](unsigned int node) {
+        unsigned int i = node % numSpots;
+        unsigned int j = node / numSpots;
+        prices[node] = PricingEngine::calculatePriceGBM(option, spotAxis.node(i), riskFreeRate, volatilityAxis.node(j), numSimulations, nodeConfig).price;
+    });
+
+    for (unsigned int j = 0; j < numVolatilities; ++j) {
+        naturalSplineCurvature(&prices[index(0, j)], 1, numSpots, spotAxis.step(), &spotCurvature[index(0, j)]);
+    }
+    for (unsigned int i = 0; i < numSpots; ++i) {
+        naturalSplineCurvature(&prices[index(i, 0)], numSpots, numVolatilities, volatilityAxis.step(), &volatilityCurvature[index(i, 0)]);
+        naturalSplineCurvature(&spotCurvature[index(i, 0)], numSpots, numVolatilities, volatilityAxis.step(), &crossCurvature[index(i, 0)]);
+    }
+}
+
+bool PriceSurface::contains(double spot, double volatility) const {
+    return spotAxis.contains(spot) && volatilityAxis.contains(volatility);
+}
+
+SurfaceQuote PriceSurface::quote(double spot, double volatility) const {
+    if (!contains(spot, volatility)) {
+        throw std::out_of_range("PriceSurface::quote outside the grid");
+    }
+    std::pair<unsigned int, double> s = locate(spotAxis, spot);
+    std::pair<unsigned int, double> v = locate(volatilityAxis, volatility);
+    unsigned int i = s.first;
+    double hSpot = spotAxis.step();
+
+    // Along spot on the two bracketing volatility rows: the spline values and their volatility curvatures, with spot derivatives
+    SplinePoint values[2], curvatures[2];
+    for (unsigned int r = 0; r < 2; ++r) {
+        unsigned int j = v.first + r;
+        values[r] = splinePiece(s.second, hSpot, prices[index(i, j)], prices[index(i + 1, j)], spotCurvature[index(i, j)], spotCurvature[index(i + 1, j)]);
+        curvatures[r] = splinePiece(s.second, hSpot, volatilityCurvature[index(i, j)], volatilityCurvature[index(i + 1, j)],
+                                    crossCurvature[index(i, j)], crossCurvature[index(i + 1, j)]);
+    }
+
+    // Then along volatility; the tensor-product spline is linear in its data, so each spot derivative is interpolated the same way
+    double hVolatility = volatilityAxis.step();
+    SplinePoint price = splinePiece(v.second, hVolatility, values[0].value, values[1].value, curvatures[0].value, curvatures[1].value);
+    SurfaceQuote quote;
+    quote.price = price.value;
+    quote.vega = price.slope;
+    quote.delta = splinePiece(v.second, hVolatility, values[0].slope, values[1].slope, curvatures[0].slope, curvatures[1].slope).value;
+    quote.gamma = splinePiece(v.second, hVolatility, values[0].curvature, values[1].curvature, curvatures[0].curvature, curvatures[1].curvature).value;
+    return quote;
+}
+
+double PriceSurface::nodePrice(unsigned int spotIndex, unsigned int volatilityIndex) const {
+    return prices[index(spotIndex, volatilityIndex)];
+}
+
+const GridAxis &PriceSurface::getSpotAxis() const {
+    return spotAxis;
+}
+
+const GridAxis &PriceSurface::getVolatilityAxis() const {
+    return volatilityAxis;
+}
+
+std::size_t PriceSurface::memoryBytes() const {
+    return sizeof(PriceSurface) + 4 * prices.size() * sizeof(double);
+}
+
+std::size_t PriceSurface::index(unsigned int spotIndex, unsigned int volatilityIndex) const {
+    return static_cast<std::size_t>(volatilityIndex) * spotAxis.points + spotIndex;
+}
+
+PriceCache::PriceCache(const PriceCacheConfig &config) : config(config) {
+    if (!(config.spotWidth > 0.0 && config.spotWidth < 1.0) || !(config.volatilityWidth > 0.0 && config.volatilityWidth < 1.0)) {
+        throw std::invalid_argument("PriceCache requires grid widths between 0 and 1");
+    }
+    if (config.spotPoints < 2 || config.volatilityPoints < 2) {
+        throw std::invalid_argument("PriceCache requires at least two nodes on each axis");
+    }
+    std::size_t surfaceBytes = sizeof(PriceSurface) + 4 * static_cast<std::size_t>(config.spotPoints) * config.volatilityPoints * sizeof(double);
+    if (surfaceBytes > config.maxBytes) {
+        throw std::invalid_argument("PriceCache::maxBytes is too small for one surface");
+    }
+}
+
+SurfaceQuote PriceCache::quote(const AsianOption &option, double spot, double riskFreeRate, double volatility) {
+    Key key = makeKey(option, riskFreeRate);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto found = entries.find(key);
+    bool cached = found != entries.end();
+    if (cached) {
+        if (found->second.surface->contains(spot, volatility)) {
+            ++statistics.hits;
+            recency.splice(recency.begin(), recency, found->second.recent);
+            return found->second.surface->quote(spot, volatility);
+        }
+        ++statistics.invalidations;
+        evict(key);
+    }
+
+    // Share a build already under way when it will cover these inputs
+    auto building = pending.find(key);
+    if (building != pending.end() && building->second.spotAxis.contains(spot) && building->second.volatilityAxis.contains(volatility)) {
+        ++statistics.hits;
+        std::shared_future<SharedSurface> surface = building->second.surface;
+        lock.unlock();
+        return surface.get()->quote(spot, volatility);
+    }
+    if (!cached) {
+        ++statistics.builds;
+    }
+
+    std::promise<SharedSurface> promise;
+    std::shared_future<SharedSurface> future = promise.get_future().share();
+    GridAxis spots = spotAxis(spot);
+    GridAxis volatilities = volatilityAxis(volatility);
+    unsigned long long build = nextBuild++;
+    pending[key] = Pending{spots, volatilities, future, build};
+    lock.unlock();
+
+    // Under the lock: drops the pending entry unless a later build has taken its place
+    auto finish = [&]() {
+        auto current = pending.find(key);
+        if (current != pending.end() && current->second.build == build) {
+            pending.erase(current);
+        }
+    };
+
+    SharedSurface surface;
+    try {
+        surface = std::make_shared<const PriceSurface>(option, riskFreeRate, spots, volatilities, config.numSimulations, config.simulation);
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        lock.lock();
+        finish();
+        throw;
+    }
+    promise.set_value(surface);
+
+    lock.lock();
+    finish();
+    publish(key, surface, surface->memoryBytes() + option.getFixingTimes().size() * sizeof(double));
+    lock.unlock();
+    return surface->quote(spot, volatility);
+}
+
+void PriceCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    recency.clear();
+    statistics.entries = 0;
+    statistics.bytes = 0;
+}
+
+PriceCacheStatistics PriceCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+PriceCache::Key PriceCache::makeKey(const AsianOption &option, double riskFreeRate) {
+    return Key(option.getStrike(), option.getExpiry(), option.getType(), option.getAveragingType(), option.getFixingTimes(),
+               option.getPastFixings(), option.getPastAverage(), riskFreeRate);
+}
+
+GridAxis PriceCache::spotAxis(double spot) const {
+    return GridAxis{spot * (1.0 - config.spotWidth), spot * (1.0 + config.spotWidth), config.spotPoints};
+}
+
+GridAxis PriceCache::volatilityAxis(double volatility) const {
+    return GridAxis{volatility * (1.0 - config.volatilityWidth), volatility * (1.0 + config.volatilityWidth), config.volatilityPoints};
+}
+
+// Stores a finished surface, replacing any the key already has; a contract whose schedule alone overflows the bound is not kept
+void PriceCache::publish(const Key &key, const SharedSurface &surface, std::size_t bytes) {
+    if (entries.count(key) > 0) {
+        evict(key);
+    }
+    while (!recency.empty() && statistics.bytes + bytes > config.maxBytes) {
+        evict(*recency.back());
+        ++statistics.evictions;
+    }
+    if (statistics.bytes + bytes <= config.maxBytes) {
+        auto inserted = entries.emplace(key, Entry{surface, bytes, recency.end()}).first;
+        recency.push_front(&inserted->first);
+        inserted->second.recent = recency.begin();
+        statistics.bytes += bytes;
+        statistics.entries = entries.size();
+    }
+}
+
+void PriceCache::evict(const Key &key) {
+    auto found = entries.find(key);
+    recency.erase(found->second.recent);
+    statistics.bytes -= found->second.bytes;
+    entries.erase(found);
+    statistics.entries = entries.size();
+}
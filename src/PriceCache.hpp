@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingEngine.hpp"
+
+// Pre-built price surfaces for contracts that are priced again and again at nearby market inputs. A surface holds GBM prices on a
+// grid of (spot, volatility) nodes, all simulated with the same configuration, so every node sees the same normals (common random
+// numbers) and the Monte Carlo noise moves smoothly across the grid instead of jumping from node to node. Queries are answered by
+// a bicubic spline through the nodes in well under a microsecond, with delta, gamma and vega from the spline's derivatives.
+
+// Equally spaced nodes lower, lower + step, ..., upper
+struct GridAxis {
+    double lower;
+    double upper;
+    unsigned int points;
+
+    double step() const { return (upper - lower) / (points - 1); }
+    double node(unsigned int i) const { return lower + i * step(); }
+    bool contains(double x) const { return x >= lower && x <= upper; }
+};
+
+// An interpolated price and its sensitivities to spot and volatility
+struct SurfaceQuote {
+    double price;
+    double delta;
+    double gamma;
+    double vega;
+};
+
+// Prices of one contract at one rate over a (spot, volatility) grid, with the spline curvatures needed to interpolate them
+class PriceSurface {
+public:
+    // Prices the option with calculatePriceGBM at every node, spreading the nodes over config.numThreads threads. Each axis needs at
+    // least two points, and the volatility axis must be positive; throws std::invalid_argument otherwise.
+    PriceSurface(const AsianOption &option, double riskFreeRate, const GridAxis &spotAxis, const GridAxis &volatilityAxis,
+                 unsigned int numSimulations, const SimulationConfig &config);
+
+    bool contains(double spot, double volatility) const;
+
+    // Natural bicubic spline of the node prices at (spot, volatility); throws std::out_of_range outside the grid
+    SurfaceQuote quote(double spot, double volatility) const;
+
+    // Node price, as simulated
+    double nodePrice(unsigned int spotIndex, unsigned int volatilityIndex) const;
+
+    const GridAxis &getSpotAxis() const;
+    const GridAxis &getVolatilityAxis() const;
+    std::size_t memoryBytes() const;
+
+private:
+    std::size_t index(unsigned int spotIndex, unsigned int volatilityIndex) const;
+
+    GridAxis spotAxis;
+    GridAxis volatilityAxis;
+    std::vector<double> prices;              // node values, spot varying fastest
+    std::vector<double> spotCurvature;       // d2/dspot2 of the spline through each row of constant volatility
+    std::vector<double> volatilityCurvature; // d2/dvol2 of the spline through each column of constant spot
+    std::vector<double> crossCurvature;      // d2/dvol2 of spotCurvature
+};
+
+struct PriceCacheConfig {
+    double spotWidth = 0.2;              // a surface built at spot S covers S (1 - w) to S (1 + w)
+    double volatilityWidth = 0.5;        // and volatility sigma (1 - w) to sigma (1 + w); must be below 1
+    unsigned int spotPoints = 17;
+    unsigned int volatilityPoints = 9;
+    unsigned int numSimulations = 20000; // paths per node
+    SimulationConfig simulation;         // seed and threads used to build every surface
+    std::size_t maxBytes = 16 << 20;     // bound on the memory held by all surfaces
+};
+
+// Counters since construction
+struct PriceCacheStatistics {
+    unsigned long long hits = 0;          // queries answered from an existing surface, or one another query was building
+    unsigned long long builds = 0;        // surfaces built for contracts not in the cache
+    unsigned long long invalidations = 0; // surfaces rebuilt because the inputs left their grid
+    unsigned long long evictions = 0;     // least recently used surfaces dropped to stay within maxBytes
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+};
+
+// Surfaces keyed on everything that fixes the contract's price apart from spot and volatility: its terms, schedule, past fixings and
+// the rate. A query outside its contract's grid discards that surface and builds a new one centred on the query. Surfaces are
+// evicted least recently used first to keep their total size within maxBytes. All members are safe to call from several threads.
+// Surfaces are built without holding the cache, so queries for other contracts carry on meanwhile. A query for a contract whose
+// surface is being built waits for that build if its inputs fall inside the new grid, and starts a build of its own otherwise; the
+// later of two such builds to finish replaces the earlier. A build that throws fails every query waiting on it.
+class PriceCache {
+public:
+    // Throws std::invalid_argument if the grid settings are invalid or one surface cannot fit in maxBytes
+    explicit PriceCache(const PriceCacheConfig &config = PriceCacheConfig());
+
+    SurfaceQuote quote(const AsianOption &option, double spot, double riskFreeRate, double volatility);
+
+    void clear();
+    PriceCacheStatistics getStatistics() const;
+
+private:
+    using Key = std::tuple<double, double, Option::Type, AsianOption::AveragingType, std::vector<double>, unsigned int, double, double>;
+
+    using SharedSurface = std::shared_ptr<const PriceSurface>;
+
+    struct Entry {
+        SharedSurface surface;
+        std::size_t bytes;
+        std::list<const Key *>::iterator recent;
+    };
+
+    // A surface being built outside the lock, with the grid it will cover
+    struct Pending {
+        GridAxis spotAxis;
+        GridAxis volatilityAxis;
+        std::shared_future<SharedSurface> surface;
+        unsigned long long build; // tells a finishing build whether a later one has replaced it
+    };
+
+    static Key makeKey(const AsianOption &option, double riskFreeRate);
+    GridAxis spotAxis(double spot) const;
+    GridAxis volatilityAxis(double volatility) const;
+    void publish(const Key &key, const SharedSurface &surface, std::size_t bytes);
+    void evict(const Key &key);
+
+    PriceCacheConfig config;
+    mutable std::mutex mutex;
+    std::map<Key, Entry> entries;
+    std::map<Key, Pending> pending; // the latest build started for each key, until it finishes
+    unsigned long long nextBuild = 0;
+    std::list<const Key *> recency; // most recently used first
+    PriceCacheStatistics statistics;
+};
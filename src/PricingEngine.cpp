@@ -1,144 +1,1394 @@
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
+#include <map>
 #include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "PricingEngine.hpp"
+#include "Adjoint.hpp"
 #include "AsianOption.hpp"
+#include "BrownianBridge.hpp"
+#include "EngineContext.hpp"
+#include "FiniteDifference.hpp"
+#include "ImportanceSampling.hpp"
+#include "Instrumentation.hpp"
+#include "MathUtils.hpp"
+#include "MomentMatching.hpp"
+#include "Multilevel.hpp"
+#include "Parallel.hpp"
+#include "PathKernel.hpp"
+#include "PricingKernel.hpp"
+#include "RandomStream.hpp"
+#include "SobolSequence.hpp"
 
-double PricingEngine::calculatePriceNaive(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
+namespace {
+
+EngineContext &engineContext(const SimulationConfig &config) {
+    return config.context ? *config.context : EngineContext::shared();
+}
+
+// Each chunk gets an independent stream identified by the base seed, the stream id (high word) and its chunk index (low word).
+// The stream is the lease's, restarted, so its buffers are reused from chunk to chunk.
+NormalStream &startChunkStream(EngineContext::Lease &lease, const SimulationConfig &config, unsigned int chunk) {
+    return lease.stream(config.generator, config.seed, static_cast<std::uint64_t>(config.streamId) << 32 | (config.firstChunk + chunk));
+}
+
+// Simulates numSimulations paths in chunks of PricingEngine::pathsPerChunk, calling simulateChunk(stream, arena, numPaths) for every
+// chunk with scratch memory leased from the configuration's context. Partial sums (a double, or any default-constructible type with
+// operator+=) are reduced in chunk order, so the total does not depend on the number of threads.
+template <typename ChunkFunction>
+auto sumOverChunks(unsigned int numSimulations, const SimulationConfig &config, ChunkFunction simulateChunk) {
+    using Sum = decltype(simulateChunk(std::declval<NormalStream &>(), std::declval<PathArena &>(), 0u));
+    unsigned int numChunks = (numSimulations + PricingEngine::pathsPerChunk - 1) / PricingEngine::pathsPerChunk;
+    std::vector<Sum> chunkSums(numChunks, Sum());
+    EngineContext &context = engineContext(config);
+
+    parallelFor(context.threadPool(), numChunks, config.numThreads, [&](unsigned int chunk) {
+        INSTRUMENT_PHASE(Chunk);
+        INSTRUMENT_COUNT(Chunks, 1);
+        unsigned int numPaths = std::min(PricingEngine::pathsPerChunk, numSimulations - chunk * PricingEngine::pathsPerChunk);
+        EngineContext::Lease lease = context.acquire();
+        chunkSums[chunk] = simulateChunk(startChunkStream(lease, config, chunk), lease.arena(), numPaths);
+    });
+
+    Sum total = Sum();
+    for (const Sum &chunkSum : chunkSums) {
+        total += chunkSum;
+    }
+    return total;
+}
+
+// Average of one path from the block kernel's running sums; the geometric average uses the log-sum, so no product can overflow
+double blockAverage(const AsianOption &asianOption, double sumSpot, double sumLogSpot) {
+    if (asianOption.getAveragingType() == AsianOption::AveragingType::Arithmetic) {
+        return sumSpot / asianOption.getAveragingPeriods();
+    } else { // AsianOption::Geometric
+        return std::exp(sumLogSpot / asianOption.getAveragingPeriods());
+    }
+}
+
+// Turns the statistics of the undiscounted per-sample payoffs into a discounted PricingResult
+PricingResult makeResult(const RunningStatistics &payoffs, double discount, std::chrono::steady_clock::time_point start) {
+    PricingResult result;
+    result.price = payoffs.getMean() * discount;
+    result.variance = payoffs.getVariance() * discount * discount;
+    result.pathsUsed = payoffs.getCount();
+    result.standardError = result.pathsUsed > 0 ? std::sqrt(result.variance / result.pathsUsed) : 0.0;
+    result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// The one run-time type check: the engines price AsianOption contracts only
+const AsianOption &asAsianOption(const Option &option, const char *method) {
     const AsianOption *asianOption = dynamic_cast<const AsianOption *>(&option);
+    if (!asianOption) {
+        throw std::invalid_argument(std::string(method) + " requires an AsianOption");
+    }
+    return *asianOption;
+}
 
-    if (asianOption) {
+// Prices with one path scheme, instantiating the kernel for the contract's averaging and payoff
+template <typename Scheme>
+PricingResult priceWithScheme(const AsianOption &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<double> dist(0.0, 1.0);
+    RunningStatistics payoffs = withPolicies(option, [&](auto averaging, auto payoff) {
+        return sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+            return simulateChunk<decltype(averaging), decltype(payoff), Scheme>(stream, arena, numPaths, parameters);
+        });
+    });
 
-        double dt = asianOption->getExpiry() / asianOption->getAveragingPeriods();
-        double sumPayoffs = 0.0;
+    return makeResult(payoffs, std::exp(-riskFreeRate * option.getExpiry()), start);
+}
 
-        for (unsigned int i = 0; i < numSimulations; ++i) {
-            double sumSpot = 0.0;
-            double productSpot = 1.0;
-            double spotPath = spot;
+// Running estimates at every checkpoint of one growing path set. Chunk c supplies the statistics of its leading paths for each checkpoint
+// that ends inside it, plus its full statistics; merging full chunks in order and then the partial one reproduces sumOverChunks exactly.
+template <typename Scheme>
+std::vector<PricingResult> convergenceWithScheme(const AsianOption &option, double spot, double riskFreeRate, double volatility, const std::vector<unsigned int> &checkpoints, const SimulationConfig &config) {
+    KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
 
-            for (unsigned int j = 0; j < asianOption->getAveragingPeriods(); ++j) {
-                if (j > 0) {
-                    double randNormal = dist(gen);
-                    spotPath *= std::exp((riskFreeRate - 0.5 * volatility * volatility) * dt +
-                                         volatility * std::sqrt(dt) * randNormal);
-                }
-                sumSpot += spotPath;
-                productSpot *= spotPath;
-            }
+    unsigned int numSimulations = checkpoints.back();
+    unsigned int numChunks = (numSimulations + PricingEngine::pathsPerChunk - 1) / PricingEngine::pathsPerChunk;
+    std::vector<std::vector<unsigned int>> chunkPrefixes(numChunks);
+    for (unsigned int checkpoint : checkpoints) {
+        unsigned int chunk = (checkpoint - 1) / PricingEngine::pathsPerChunk;
+        chunkPrefixes[chunk].push_back(checkpoint - chunk * PricingEngine::pathsPerChunk);
+    }
+    for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+        unsigned int numPaths = std::min(PricingEngine::pathsPerChunk, numSimulations - chunk * PricingEngine::pathsPerChunk);
+        if (chunkPrefixes[chunk].empty() || chunkPrefixes[chunk].back() != numPaths) {
+            chunkPrefixes[chunk].push_back(numPaths);
+        }
+    }
+
+    std::vector<std::vector<RunningStatistics>> chunkSnapshots(numChunks);
+    withPolicies(option, [&](auto averaging, auto payoff) {
+        parallelFor(engineContext(config).threadPool(), numChunks, config.numThreads, [&](unsigned int chunk) {
+            INSTRUMENT_PHASE(Chunk);
+            INSTRUMENT_COUNT(Chunks, 1);
+            EngineContext::Lease lease = engineContext(config).acquire();
+            chunkSnapshots[chunk] = simulateChunkPrefixes<decltype(averaging), decltype(payoff), Scheme>(startChunkStream(lease, config, chunk), lease.arena(),
+                                                                                                          chunkPrefixes[chunk], parameters);
+        });
+    });
 
-            double avgSpot;
-            if (asianOption->getAveragingType() == AsianOption::AveragingType::Arithmetic) {
-                avgSpot = sumSpot / asianOption->getAveragingPeriods();
-            } else { // AsianOption::Geometric
-                avgSpot = std::pow(productSpot, 1.0 / asianOption->getAveragingPeriods());
+    // Full-chunk entries that are not checkpoints were only needed for the merge and are skipped
+    double discount = std::exp(-riskFreeRate * option.getExpiry());
+    std::vector<PricingResult> results;
+    RunningStatistics completedChunks;
+    std::size_t next = 0;
+    for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+        for (const RunningStatistics &snapshot : chunkSnapshots[chunk]) {
+            RunningStatistics payoffs = completedChunks;
+            payoffs += snapshot;
+            if (payoffs.getCount() == checkpoints[next]) {
+                results.push_back(makeResult(payoffs, discount, start));
+                ++next;
             }
+        }
+        completedChunks += chunkSnapshots[chunk].back();
+    }
+
+    double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (PricingResult &result : results) {
+        result.wallTime = wallTime;
+    }
+    return results;
+}
+
+// Single-pass means, variances and covariance of the arithmetic payoff Y and the geometric control payoff X,
+// the bivariate form of the Welford update used by RunningStatistics
+struct ControlVariateStatistics {
+    unsigned long long count = 0;
+    double meanX = 0.0;
+    double meanY = 0.0;
+    double m2X = 0.0;
+    double m2Y = 0.0;
+    double coMoment = 0.0;
+
+    void add(double x, double y) {
+        ++count;
+        double deltaX = x - meanX;
+        double deltaY = y - meanY;
+        meanX += deltaX / count;
+        meanY += deltaY / count;
+        m2X += deltaX * (x - meanX);
+        m2Y += deltaY * (y - meanY);
+        coMoment += deltaX * (y - meanY);
+    }
+
+    ControlVariateStatistics &operator+=(const ControlVariateStatistics &other) {
+        if (other.count == 0) {
+            return *this;
+        }
+        if (count == 0) {
+            *this = other;
+            return *this;
+        }
+        double total = static_cast<double>(count + other.count);
+        double weight = static_cast<double>(count) * other.count / total;
+        double deltaX = other.meanX - meanX;
+        double deltaY = other.meanY - meanY;
+        meanX += deltaX * other.count / total;
+        meanY += deltaY * other.count / total;
+        m2X += other.m2X + deltaX * deltaX * weight;
+        m2Y += other.m2Y + deltaY * deltaY * weight;
+        coMoment += other.coMoment + deltaX * deltaY * weight;
+        count += other.count;
+        return *this;
+    }
+};
+
+// Per-sample statistics of the discounted price and of each sensitivity estimator
+struct GreekStatistics {
+    RunningStatistics price, delta, gamma, vega, rho;
+
+    GreekStatistics &operator+=(const GreekStatistics &other) {
+        price += other.price;
+        delta += other.delta;
+        gamma += other.gamma;
+        vega += other.vega;
+        rho += other.rho;
+        return *this;
+    }
+};
+
+// Per-sample statistics of a variable number of estimators, merged element by element
+struct StatisticsVector {
+    std::vector<RunningStatistics> values;
+
+    StatisticsVector &operator+=(const StatisticsVector &other) {
+        if (values.size() < other.values.size()) {
+            values.resize(other.values.size());
+        }
+        for (std::size_t i = 0; i < other.values.size(); ++i) {
+            values[i] += other.values[i];
+        }
+        return *this;
+    }
+};
+
+// Per-sample statistics of the likelihood-ratio weighted payoff f w and of f^2 w, whose mean is the second moment of the unweighted
+// payoff under the original measure, so plain Monte Carlo's variance comes from the same paths
+struct ImportanceSamplingStatistics {
+    RunningStatistics weighted, secondMoment;
+
+    ImportanceSamplingStatistics &operator+=(const ImportanceSamplingStatistics &other) {
+        weighted += other.weighted;
+        secondMoment += other.secondMoment;
+        return *this;
+    }
+};
+
+// Per-sample statistics of a multilevel level's correction P_l - P_{l-1} and of its own payoff P_l
+struct MultilevelStatistics {
+    RunningStatistics correction, payoff;
+
+    MultilevelStatistics &operator+=(const MultilevelStatistics &other) {
+        correction += other.correction;
+        payoff += other.payoff;
+        return *this;
+    }
+};
+
+// Advances a GBM path from fixing first to fixing last, adding each new fixing (arithmetic) or its log (geometric) to sum.
+// steps[i] is t_{i+1} - t_i and rootSteps[i] its square root.
+void advancePath(double &logSpot, double &sum, double drift, double volatility, const std::vector<double> &steps, const std::vector<double> &rootSteps,
+                 const std::vector<double> &normals, unsigned int first, unsigned int last, bool arithmetic) {
+    for (unsigned int i = first; i < last; ++i) {
+        logSpot = logSpot + drift * steps[i] + volatility * rootSteps[i] * normals[i];
+        sum = sum + (arithmetic ? std::exp(logSpot) : logSpot);
+    }
+}
 
-            sumPayoffs += option.payoff(avgSpot);
+// Reverse sweep of advancePath over the same steps, taken last to first. Every fixing adds to sum with unit weight, so the adjoint of
+// sum is the same throughout; logSpotAdjoint enters as that of the final log-spot and leaves as that of the starting one. fixings[i - first]
+// is exp(logSpot) after step i, needed for the arithmetic average only. Adds to the adjoints of the drift, the volatility and every date.
+void advancePathAdjoint(double &logSpotAdjoint, double sumAdjoint, double &driftAdjoint, double &volatilityAdjoint, std::vector<double> &timeAdjoints,
+                        double drift, double volatility, const std::vector<double> &steps, const std::vector<double> &rootSteps,
+                        const std::vector<double> &normals, const std::vector<double> &fixings, unsigned int first, unsigned int last, bool arithmetic) {
+    for (unsigned int i = last; i-- > first;) {
+        logSpotAdjoint += sumAdjoint * (arithmetic ? fixings[i - first] : 1.0);
+        driftAdjoint += logSpotAdjoint * steps[i];
+        volatilityAdjoint += logSpotAdjoint * rootSteps[i] * normals[i];
+        // d/dstep of drift * step + volatility * sqrt(step) * z, and step = t_{i+1} - t_i
+        double stepAdjoint = logSpotAdjoint * (drift + 0.5 * volatility * normals[i] / rootSteps[i]);
+        timeAdjoints[i + 1] += stepAdjoint;
+        timeAdjoints[i] -= stepAdjoint;
+    }
+}
+
+// Undiscounted closed-form expectation of a geometric-average payoff over the option's schedule. With m past fixings of geometric
+// average G_p and remaining fixings at t_1, ..., t_k out of N in all, log G is normal with mean
+// (m log G_p + k log(spot) + (r - sigma^2/2) sum_i t_i) / N and variance sigma^2 / N^2 * sum_ij min(t_i, t_j).
+double geometricExpectedPayoff(const AsianOption &option, double spot, double riskFreeRate, double volatility) {
+    Option::Type type = option.getType();
+    double strike = option.getStrike();
+    double n = option.getAveragingPeriods();
+    double meanLog, varianceLog;
+
+    if (option.hasUniformSchedule()) { // fixings at 0, dt, ..., (n-1)dt have closed-form sums
+        double dt = option.getExpiry() / n;
+        double meanTime = dt * (n - 1.0) / 2.0;
+        double sumMinTimes = dt * (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+        meanLog = std::log(spot) + (riskFreeRate - 0.5 * volatility * volatility) * meanTime;
+        varianceLog = volatility * volatility * sumMinTimes / (n * n);
+    } else {
+        // For sorted times t_0 <= ... <= t_{k-1}, sum_ij min(t_i, t_j) = sum_i (2 (k - i) - 1) t_i with i counted from 0
+        const std::vector<double> &times = option.getFixingTimes();
+        double k = static_cast<double>(times.size());
+        double sumTimes = 0.0;
+        double sumMinTimes = 0.0;
+        for (std::size_t i = 0; i < times.size(); ++i) {
+            sumTimes += times[i];
+            sumMinTimes += (2.0 * (k - i) - 1.0) * times[i];
         }
+        double pastLogSum = option.getPastFixings() > 0 ? option.getPastFixings() * std::log(option.getPastAverage()) : 0.0;
+        meanLog = (pastLogSum + k * std::log(spot) + (riskFreeRate - 0.5 * volatility * volatility) * sumTimes) / n;
+        varianceLog = volatility * volatility * sumMinTimes / (n * n);
+    }
+    double forward = std::exp(meanLog + 0.5 * varianceLog);
+
+    if (varianceLog <= 0.0 || strike <= 0.0) { // the average is known, or the option is certain to be exercised
+        double intrinsic = type == Option::Type::Call ? forward - strike : strike - forward;
+        return std::max(intrinsic, 0.0);
+    }
+
+    double stdDevLog = std::sqrt(varianceLog);
+    double d1 = (meanLog - std::log(strike) + varianceLog) / stdDevLog;
+    double d2 = d1 - stdDevLog;
+    if (type == Option::Type::Call) {
+        return forward * normalCdf(d1) - strike * normalCdf(d2);
+    } else {
+        return strike * normalCdf(-d2) - forward * normalCdf(-d1);
+    }
+}
+
+// Moment-matching result with every price scaled by a discount factor
+MomentMatchingResult discountMomentMatching(MomentMatchingResult result, double discount) {
+    result.price *= discount;
+    result.lognormalPrice *= discount;
+    result.lowerBound *= discount;
+    result.upperBound *= discount;
+    result.errorBound *= discount;
+    return result;
+}
 
-        double price = (sumPayoffs / numSimulations) * std::exp(-riskFreeRate * asianOption->getExpiry());
-        return price;
+// Discounted moment-matching result for one contract on the distribution of its average; geometric contracts take the closed form,
+// whose bracket has no width
+MomentMatchingResult discountedMomentMatching(const AsianOption &option, const AverageDistribution &distribution, double spot, double riskFreeRate, double volatility) {
+    double discount = std::exp(-riskFreeRate * option.getExpiry());
+    MomentMatchingResult result;
+    if (option.getAveragingType() == AsianOption::AveragingType::Geometric) {
+        result.price = result.lognormalPrice = result.lowerBound = result.upperBound = discount * geometricExpectedPayoff(option, spot, riskFreeRate, volatility);
+        return result;
     }
+    return discountMomentMatching(momentMatchingPayoff(distribution, option.getStrike(), option.getType()), discount);
+}
+
+} // namespace
 
+SimulationConfig PricingEngine::randomConfig() {
+    std::random_device rd;
+    SimulationConfig config;
+    config.seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    return config;
+}
+
+double PricingEngine::calculatePriceNaive(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
+    return calculatePriceNaive(option, spot, riskFreeRate, volatility, numSimulations, randomConfig()).price;
 }
 
 double PricingEngine::calculatePriceAntithetic(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
-    const AsianOption *asianOption = dynamic_cast<const AsianOption *>(&option);
+    return calculatePriceAntithetic(option, spot, riskFreeRate, volatility, numSimulations, randomConfig()).price;
+}
+
+double PricingEngine::calculatePriceGBM(const Option& option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
+    return calculatePriceGBM(option, spot, riskFreeRate, volatility, numSimulations, randomConfig()).price;
+}
+
+PricingResult PricingEngine::calculatePriceNaive(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    return priceWithScheme<NaiveScheme>(asAsianOption(option, "calculatePriceNaive"), spot, riskFreeRate, volatility, numSimulations, config);
+}
+
+PricingResult PricingEngine::calculatePriceAntithetic(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    return priceWithScheme<AntitheticScheme>(asAsianOption(option, "calculatePriceAntithetic"), spot, riskFreeRate, volatility, numSimulations, config);
+}
+
+PricingResult PricingEngine::calculatePriceGBM(const Option& option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    return priceWithScheme<PlainScheme>(asAsianOption(option, "calculatePriceGBM"), spot, riskFreeRate, volatility, numSimulations, config);
+}
+
+PricingResult PricingEngine::calculatePriceStreaming(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceStreaming");
+    StepTable table = makeStepTable(spot, riskFreeRate, volatility, asianOption.getFixingTimes());
+    KernelParameters parameters = makeKernelParameters(asianOption, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
 
-    if (asianOption) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<double> dist(0.0, 1.0);
+    RunningStatistics payoffs = withPolicies(asianOption, [&](auto averaging, auto payoff) {
+        return sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+            return simulateChunkStreaming<decltype(averaging), decltype(payoff)>(stream, arena, numPaths, table, parameters);
+        });
+    });
 
-        double dt = asianOption->getExpiry() / asianOption->getAveragingPeriods();
-        double sumPayoffs = 0.0;
+    return makeResult(payoffs, std::exp(-riskFreeRate * asianOption.getExpiry()), start);
+}
 
-        for (unsigned int i = 0; i < numSimulations; ++i) {
-            double sumSpot = 0.0;
-            double sumSpotAntithetic = 0.0;
-            double productSpot = 1.0;
-            double productSpotAntithetic = 1.0;
-            double spotPath = spot;
-            double spotPathAntithetic = spot;
+ImportanceSamplingResult PricingEngine::calculatePriceImportanceSampling(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceImportanceSampling");
+    KernelParameters parameters = makeKernelParameters(asianOption, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
+
+    ImportanceSamplingResult result;
+    result.driftShift = optimalDriftShift(parameters, asianOption.getAveragingType(), asianOption.getType());
+    const std::vector<double> &shift = result.driftShift;
+    double halfShiftSquared = 0.0;
+    for (double theta : shift) {
+        halfShiftSquared += 0.5 * theta * theta;
+    }
 
-            for (unsigned int j = 0; j < asianOption->getAveragingPeriods(); ++j) {
-                if (j > 0) {
-                    double randNormal = dist(gen);
-                    spotPath *= std::exp((riskFreeRate - 0.5 * volatility * volatility) * dt +
-                                         volatility * std::sqrt(dt) * randNormal);
-                    spotPathAntithetic *= std::exp((riskFreeRate - 0.5 * volatility * volatility) * dt -
-                                                   volatility * std::sqrt(dt) * randNormal);
+    ImportanceSamplingStatistics statistics = withPolicies(asianOption, [&](auto averaging, auto payoff) {
+        using Averaging = decltype(averaging);
+        using Payoff = decltype(payoff);
+
+        return sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+            double *normals = arena.allocate<double>(parameters.numSteps * pathBlockWidth);
+            std::fill(normals, normals + parameters.numSteps * pathBlockWidth, 0.0);
+            double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth], logWeight[pathBlockWidth];
+            ImportanceSamplingStatistics chunkStatistics;
+
+            for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                unsigned int width = std::min(pathBlockWidth, numPaths - first);
+
+                // z drawn from N(0, 1) becomes z + theta, with likelihood ratio exp(-theta . z - |theta|^2 / 2)
+                {
+                    INSTRUMENT_PHASE(RandomNumbers);
+                    drawBlockNormals(stream, parameters.numSteps, width, normals);
+                    std::fill(logWeight, logWeight + pathBlockWidth, -halfShiftSquared);
+                    for (unsigned int j = 0; j < parameters.numSteps; ++j) {
+                        double *stepNormals = normals + j * pathBlockWidth;
+                        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+                            logWeight[k] -= shift[j] * stepNormals[k];
+                            stepNormals[k] += shift[j];
+                        }
+                    }
+                }
+                {
+                    INSTRUMENT_PHASE(PathStepping);
+                    simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
                 }
 
-                sumSpot += spotPath;
-                sumSpotAntithetic += spotPathAntithetic;
-                productSpot *= spotPath;
-                productSpotAntithetic *= spotPathAntithetic;
+                INSTRUMENT_PHASE(Payoff);
+                for (unsigned int k = 0; k < width; ++k) {
+                    double sample = Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike);
+                    double weightedSample = sample > 0.0 ? sample * std::exp(logWeight[k]) : 0.0; // a zero payoff has no weight to overflow
+                    chunkStatistics.weighted.add(weightedSample);
+                    chunkStatistics.secondMoment.add(sample * weightedSample);
+                }
             }
+            countSimulatedPaths(numPaths, parameters.numSteps);
+            return chunkStatistics;
+        });
+    });
+
+    double discount = std::exp(-riskFreeRate * asianOption.getExpiry());
+    result.price = makeResult(statistics.weighted, discount, start);
+    double mean = statistics.weighted.getMean();
+    result.naiveVariance = std::max(statistics.secondMoment.getMean() - mean * mean, 0.0) * discount * discount;
+    result.varianceReduction = result.price.variance > 0.0 ? result.naiveVariance / result.price.variance : 1.0;
+    return result;
+}
+
+MultilevelResult PricingEngine::calculatePriceMultilevel(const Option &option, double spot, double riskFreeRate, double volatility, const MultilevelCriteria &criteria, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceMultilevel");
+    if (!(criteria.targetError > 0.0) || criteria.initialSamples == 0) {
+        throw std::invalid_argument("calculatePriceMultilevel requires a positive target error and initial sample count");
+    }
+
+    KernelParameters parameters = makeKernelParameters(asianOption, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
+    bool logarithms = asianOption.getAveragingType() == AsianOption::AveragingType::Geometric;
+    double discount = std::exp(-riskFreeRate * asianOption.getExpiry());
+    unsigned int numLevels = multilevelLevels(parameters.numSteps);
+
+    std::vector<MultilevelGrid> grids;
+    std::vector<MultilevelStatistics> statistics;
+    std::vector<unsigned int> chunksUsed;
+    auto addLevel = [&]() {
+        grids.push_back(makeMultilevelGrid(parameters, static_cast<unsigned int>(grids.size())));
+        statistics.emplace_back();
+        chunksUsed.push_back(0);
+    };
+
+    // Each level continues its own family of chunk streams, so adding samples never repeats a path
+    auto simulateLevel = [&](unsigned int level, unsigned int numSamples) {
+        SimulationConfig levelConfig = config;
+        levelConfig.streamId = config.streamId + 0x9e3779b9u * (level + 1);
+        levelConfig.firstChunk = config.firstChunk + chunksUsed[level];
+        chunksUsed[level] += (numSamples + pathsPerChunk - 1) / pathsPerChunk;
+        const MultilevelGrid &grid = grids[level];
+
+        statistics[level] += withPolicies(asianOption, [&](auto averaging, auto payoff) {
+            using Averaging = decltype(averaging);
+            using Payoff = decltype(payoff);
 
-            double avgSpot, avgSpotAntithetic;
-            if (asianOption->getAveragingType() == AsianOption::AveragingType::Arithmetic) {
-                avgSpot = sumSpot / asianOption->getAveragingPeriods();
-                avgSpotAntithetic = sumSpotAntithetic / asianOption->getAveragingPeriods();
-            } else { // AsianOption::Geometric
-                avgSpot = std::pow(productSpot, 1.0 / asianOption->getAveragingPeriods());
-                avgSpotAntithetic = std::pow(productSpotAntithetic, 1.0 / asianOption->getAveragingPeriods());
+            return sumOverChunks(numSamples, levelConfig, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+                double *normals = arena.allocate<double>(grid.numSteps() * pathBlockWidth);
+                std::fill(normals, normals + grid.numSteps() * pathBlockWidth, 0.0);
+                double fine[pathBlockWidth], coarse[pathBlockWidth];
+                MultilevelStatistics chunkStatistics;
+
+                for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                    unsigned int width = std::min(pathBlockWidth, numPaths - first);
+                    {
+                        INSTRUMENT_PHASE(RandomNumbers);
+                        drawBlockNormals(stream, grid.numSteps(), width, normals);
+                    }
+                    {
+                        INSTRUMENT_PHASE(PathStepping);
+                        simulateMultilevelBlock(grid, parameters.spot, logarithms, normals, fine, coarse);
+                    }
+
+                    // fine and coarse hold sums of fixings or of their logarithms, whichever the averaging policy reads
+                    INSTRUMENT_PHASE(Payoff);
+                    for (unsigned int k = 0; k < width; ++k) {
+                        double finePayoff = Payoff::payoff(Averaging::average(parameters.initialSum + fine[k], parameters.initialLogSum + fine[k],
+                                                                              parameters.averagingPeriods), parameters.strike);
+                        double coarsePayoff = level == 0 ? 0.0 : Payoff::payoff(Averaging::average(parameters.initialSum + coarse[k], parameters.initialLogSum + coarse[k],
+                                                                                                   parameters.averagingPeriods), parameters.strike);
+                        chunkStatistics.correction.add(finePayoff - coarsePayoff);
+                        chunkStatistics.payoff.add(finePayoff);
+                    }
+                }
+                countSimulatedPaths(numPaths, grid.numSteps());
+                return chunkStatistics;
+            });
+        });
+    };
+    auto levelCost = [&](unsigned int level) { return std::max(static_cast<double>(grids[level].numSteps()), 1.0); };
+
+    // Remaining bias of stopping at the current finest level, from the decay of the mean corrections, |E[P_l - P_{l-1}]| ~ 2^(-alpha l),
+    // fitted over levels 1 and up
+    auto estimateBias = [&]() {
+        double sumL = 0.0, sumY = 0.0, sumLL = 0.0, sumLY = 0.0, fitted = 0.0;
+        for (unsigned int level = 1; level < grids.size(); ++level) {
+            double mean = std::fabs(statistics[level].correction.getMean());
+            if (mean > 0.0) {
+                double y = std::log2(mean);
+                sumL += level;
+                sumY += y;
+                sumLL += static_cast<double>(level) * level;
+                sumLY += level * y;
+                fitted += 1.0;
             }
+        }
+        double alpha = 1.0;
+        if (fitted >= 2.0) {
+            alpha = std::max(-(fitted * sumLY - sumL * sumY) / (fitted * sumLL - sumL * sumL), 0.5);
+        }
+        unsigned int finest = static_cast<unsigned int>(grids.size()) - 1;
+        double lastCorrection = std::fabs(statistics[finest].correction.getMean());
+        double previousCorrection = std::fabs(statistics[finest - 1].correction.getMean()) / std::pow(2.0, alpha);
+        return std::max(lastCorrection, previousCorrection) / (std::pow(2.0, alpha) - 1.0) * discount;
+    };
+
+    // Giles' algorithm: start with up to three levels, bring every level to its optimal sample count, then add a level while the
+    // estimated bias exceeds its share of the target. Variances are of discounted samples, so the budget is in price units.
+    double targetSquared = criteria.targetError * criteria.targetError;
+    std::vector<unsigned long long> extraSamples;
+    while (grids.size() < std::min(3u, numLevels)) {
+        addLevel();
+        extraSamples.push_back(criteria.initialSamples);
+    }
+    unsigned long long totalSamples = 0;
 
-            sumPayoffs += (option.payoff(avgSpot) + option.payoff(avgSpotAntithetic)) / 2.0;
+    while (true) {
+        for (unsigned int level = 0; level < grids.size(); ++level) {
+            unsigned long long samples = std::min({extraSamples[level], criteria.maxSimulations - totalSamples, 0xffffffffull});
+            if (samples > 0) {
+                simulateLevel(level, static_cast<unsigned int>(samples));
+                totalSamples += samples;
+            }
+            extraSamples[level] = 0;
         }
+        if (totalSamples >= criteria.maxSimulations) {
+            break;
+        }
+
+        // N_l = sqrt(V_l / C_l) * sum_k sqrt(V_k C_k) / budget minimises the cost for a statistical error within the budget.
+        // Top-ups under 1% of a level's samples are skipped, as re-estimated variances would otherwise keep asking for a few more.
+        bool includesSchedule = grids.size() == numLevels;
+        double budget = includesSchedule ? targetSquared : 0.5 * targetSquared;
+        double sumRootVarianceCost = 0.0;
+        for (unsigned int level = 0; level < grids.size(); ++level) {
+            sumRootVarianceCost += std::sqrt(statistics[level].correction.getVariance() * discount * discount * levelCost(level));
+        }
+        bool converged = true;
+        for (unsigned int level = 0; level < grids.size(); ++level) {
+            double variance = statistics[level].correction.getVariance() * discount * discount;
+            double optimal = std::ceil(std::sqrt(variance / levelCost(level)) * sumRootVarianceCost / budget);
+            double samples = static_cast<double>(statistics[level].correction.getCount());
+            if (optimal > 1.01 * samples) {
+                extraSamples[level] = static_cast<unsigned long long>(std::min(optimal - samples, static_cast<double>(criteria.maxSimulations)));
+                converged = false;
+            }
+        }
+        if (!converged) {
+            continue;
+        }
+        if (includesSchedule) {
+            break;
+        }
+
+        if (estimateBias() <= criteria.targetError / std::sqrt(2.0)) {
+            break;
+        }
+        addLevel();
+        extraSamples.push_back(criteria.initialSamples);
+    }
+
+    MultilevelResult result;
+    double price = 0.0;
+    double statisticalVariance = 0.0;
+    for (unsigned int level = 0; level < grids.size(); ++level) {
+        const RunningStatistics &correction = statistics[level].correction;
+        MultilevelLevel summary;
+        summary.steps = grids[level].numSteps();
+        summary.samples = correction.getCount();
+        summary.mean = correction.getMean() * discount;
+        summary.variance = correction.getVariance() * discount * discount;
+        result.levels.push_back(summary);
 
-        double price = (sumPayoffs / numSimulations) * std::exp(-riskFreeRate * asianOption->getExpiry());
-        return price;
+        price += summary.mean;
+        statisticalVariance += summary.samples > 0 ? summary.variance / summary.samples : 0.0;
+        result.cost += static_cast<double>(summary.samples) * summary.steps;
     }
 
+    result.price.price = price;
+    result.price.pathsUsed = totalSamples;
+    result.price.standardError = std::sqrt(statisticalVariance);
+    result.price.variance = statisticalVariance * totalSamples;
+    result.price.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // A run cut short by maxSimulations may stop on any level, so the bias is estimated from wherever it stopped
+    result.bias = grids.size() < numLevels ? estimateBias() : 0.0;
+
+    // Plain Monte Carlo needs Var(P) / SE^2 paths of the full schedule for the same standard error; the finest level's payoff stands in for P
+    double payoffVariance = statistics.back().payoff.getVariance() * discount * discount;
+    if (statisticalVariance > 0.0) {
+        result.singleLevelCost = payoffVariance / statisticalVariance * std::max(parameters.numSteps, 1u);
+    }
+    return result;
 }
 
-double PricingEngine::calculatePriceGBM(const Option& option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
-    const AsianOption* asianOption = dynamic_cast<const AsianOption*>(&option);
+FiniteDifferenceResult PricingEngine::calculatePriceFiniteDifference(const Option &option, double spot, double riskFreeRate, double volatility, const FiniteDifferenceConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceFiniteDifference");
+    if (asianOption.getAveragingType() != AsianOption::AveragingType::Arithmetic) {
+        throw std::invalid_argument("calculatePriceFiniteDifference requires arithmetic averaging; use calculatePriceGeometricClosedForm");
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // Holding on each interval between fixing dates: exp(-r (T - t_i)) / N shares for every fixing t_i still to come at its end,
+    // so that selling them at t_i leaves S(t_i) / N in cash at expiry
+    double expiry = asianOption.getExpiry();
+    double n = asianOption.getAveragingPeriods();
+    const std::vector<double> &fixingTimes = asianOption.getFixingTimes();
+    std::vector<double> intervalEnds, holdings;
+    for (double time : fixingTimes) {
+        if (time > 0.0 && (intervalEnds.empty() || time > intervalEnds.back())) {
+            intervalEnds.push_back(time);
+        }
+    }
+    if (intervalEnds.empty() || intervalEnds.back() < expiry) {
+        intervalEnds.push_back(expiry);
+    }
+    // Fixing times are sorted, so the holdings are suffix sums taken from expiry backwards
+    holdings.resize(intervalEnds.size());
+    double initialHolding = 0.0;
+    std::size_t next = fixingTimes.size();
+    for (std::size_t k = intervalEnds.size(); k-- > 0;) {
+        while (next > 0 && fixingTimes[next - 1] >= intervalEnds[k]) {
+            initialHolding += std::exp(-riskFreeRate * (expiry - fixingTimes[--next])) / n;
+        }
+        holdings[k] = initialHolding;
+    }
+    while (next > 0) {
+        initialHolding += std::exp(-riskFreeRate * (expiry - fixingTimes[--next])) / n;
+    }
+
+    // The replicating portfolio is worth X = q(0) S + c today, c being the discounted past fixings' share of the average less the strike;
+    // with z0 = X / S the price is S u(z0), so delta = u - (c / S) u_z and gamma = c^2 u_zz / S^3
+    double pastSum = asianOption.getPastFixings() * asianOption.getPastAverage();
+    double cash = std::exp(-riskFreeRate * expiry) * (pastSum / n - asianOption.getStrike());
+    double z0 = initialHolding + cash / spot;
+
+    EngineContext::Lease lease = (config.context ? *config.context : EngineContext::shared()).acquire();
+    VecerValue solution = solveVecerPde(intervalEnds, holdings, volatility, asianOption.getType(), z0, config, lease.arena());
+
+    FiniteDifferenceResult result;
+    result.price = spot * solution.value;
+    result.delta = solution.value - cash / spot * solution.slope;
+    result.gamma = cash * cash * solution.curvature / (spot * spot * spot);
+    result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+MomentMatchingResult PricingEngine::calculatePriceMomentMatching(const Option &option, double spot, double riskFreeRate, double volatility) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceMomentMatching");
+    AverageDistribution distribution;
+    if (asianOption.getAveragingType() == AsianOption::AveragingType::Arithmetic) {
+        distribution = makeAverageDistribution(asianOption, spot, riskFreeRate, volatility);
+    }
+    return discountedMomentMatching(asianOption, distribution, spot, riskFreeRate, volatility);
+}
+
+std::vector<MomentMatchingResult> PricingEngine::calculatePricesMomentMatching(const std::vector<AsianOption> &options, const std::vector<MarketData> &marketData) {
+    if (options.size() != marketData.size()) {
+        throw std::invalid_argument("calculatePricesMomentMatching requires one MarketData entry per option");
+    }
+
+    // One distribution per market, schedule and past fixings, as calculatePricesBatch groups its simulated averages; the contracts
+    // sharing it are then priced together in strike lanes
+    std::map<std::tuple<double, double, double, std::vector<double>, unsigned int, unsigned int, double>, std::vector<std::size_t>> groups;
+    std::vector<MomentMatchingResult> results(options.size());
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        const AsianOption &option = options[i];
+        const MarketData &market = marketData[i];
+        if (option.getAveragingType() == AsianOption::AveragingType::Geometric) {
+            results[i] = discountedMomentMatching(option, AverageDistribution(), market.spot, market.riskFreeRate, market.volatility);
+            continue;
+        }
+        groups[std::make_tuple(market.spot, market.riskFreeRate, market.volatility, option.getFixingTimes(), option.getAveragingPeriods(),
+                               option.getPastFixings(), option.getPastAverage())].push_back(i);
+    }
+
+    std::vector<double> strikes;
+    std::vector<Option::Type> types;
+    std::vector<MomentMatchingResult> payoffs;
+    for (const auto &group : groups) {
+        const std::vector<std::size_t> &members = group.second;
+        const MarketData &market = marketData[members.front()];
+        AverageDistribution distribution = makeAverageDistribution(options[members.front()], market.spot, market.riskFreeRate, market.volatility);
+        strikes.clear();
+        types.clear();
+        for (std::size_t i : members) {
+            strikes.push_back(options[i].getStrike());
+            types.push_back(options[i].getType());
+        }
+        payoffs.resize(members.size());
+        momentMatchingPayoffs(distribution, strikes.data(), types.data(), members.size(), payoffs.data());
+        for (std::size_t j = 0; j < members.size(); ++j) {
+            results[members[j]] = discountMomentMatching(payoffs[j], std::exp(-market.riskFreeRate * options[members[j]].getExpiry()));
+        }
+    }
+    return results;
+}
+
+TieredResult PricingEngine::calculatePriceTiered(const Option &option, double spot, double riskFreeRate, double volatility, double tolerance, unsigned int numSimulations, const SimulationConfig &config) {
+    auto start = std::chrono::steady_clock::now();
+    TieredResult result;
+    result.approximation = calculatePriceMomentMatching(option, spot, riskFreeRate, volatility);
+    if (result.approximation.errorBound <= tolerance) {
+        result.price.price = result.approximation.price;
+        result.price.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    result.price = calculatePriceControlVariate(option, spot, riskFreeRate, volatility, numSimulations, config);
+    result.price.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.usedMonteCarlo = true;
+    return result;
+}
+
+std::vector<PricingResult> PricingEngine::calculatePriceConvergence(Method method, const Option &option, double spot, double riskFreeRate, double volatility, const std::vector<unsigned int> &checkpoints, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceConvergence");
+
+    if (checkpoints.empty() || checkpoints.front() == 0 || !std::is_sorted(checkpoints.begin(), checkpoints.end())
+        || std::adjacent_find(checkpoints.begin(), checkpoints.end()) != checkpoints.end()) {
+        throw std::invalid_argument("calculatePriceConvergence requires strictly increasing, positive checkpoints");
+    }
+
+    switch (method) {
+        case Method::Naive:
+            return convergenceWithScheme<NaiveScheme>(asianOption, spot, riskFreeRate, volatility, checkpoints, config);
+        case Method::Antithetic:
+            return convergenceWithScheme<AntitheticScheme>(asianOption, spot, riskFreeRate, volatility, checkpoints, config);
+        case Method::GBM:
+            return convergenceWithScheme<PlainScheme>(asianOption, spot, riskFreeRate, volatility, checkpoints, config);
+        default:
+            throw std::invalid_argument("calculatePriceConvergence supports the Naive, Antithetic and GBM methods");
+    }
+}
+
+std::vector<PricingResult> PricingEngine::calculatePricesBatch(const std::vector<AsianOption> &options, const std::vector<MarketData> &marketData, unsigned int numSimulations, const SimulationConfig &config) {
+    if (options.size() != marketData.size()) {
+        throw std::invalid_argument("calculatePricesBatch requires one MarketData entry per option");
+    }
+
+    // Group contracts whose simulated averages are identical: same market inputs, expiry, schedule and past fixings
+    std::map<std::tuple<double, double, double, double, std::vector<double>, unsigned int, double>, std::vector<std::size_t>> groupIndex;
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        groupIndex[std::make_tuple(marketData[i].spot, marketData[i].riskFreeRate, marketData[i].volatility, options[i].getExpiry(),
+                                   options[i].getFixingTimes(), options[i].getPastFixings(), options[i].getPastAverage())].push_back(i);
+    }
+    std::vector<std::vector<std::size_t>> groups;
+    for (auto &entry : groupIndex) {
+        groups.push_back(std::move(entry.second));
+    }
 
-    if (asianOption) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<double> dist(0.0, 1.0);
+    // Payoff statistics for every (group, chunk, contract), filled by one task per (group, chunk)
+    auto start = std::chrono::steady_clock::now();
+    unsigned int numChunks = (numSimulations + pathsPerChunk - 1) / pathsPerChunk;
+    std::vector<std::vector<RunningStatistics>> chunkPayoffs(groups.size());
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        chunkPayoffs[g].assign(numChunks * groups[g].size(), RunningStatistics());
+    }
+
+    // Step coefficients are the same for every chunk of a group
+    std::vector<KernelParameters> groupParameters;
+    groupParameters.reserve(groups.size());
+    for (const std::vector<std::size_t> &members : groups) {
+        const MarketData &market = marketData[members.front()];
+        groupParameters.push_back(makeKernelParameters(options[members.front()], market.spot, market.riskFreeRate, market.volatility));
+    }
+
+    EngineContext &context = engineContext(config);
+    parallelFor(context.threadPool(), static_cast<unsigned int>(groups.size()) * numChunks, config.numThreads, [&](unsigned int task) {
+        INSTRUMENT_PHASE(Chunk);
+        INSTRUMENT_COUNT(Chunks, 1);
+        unsigned int g = task / numChunks;
+        unsigned int chunk = task % numChunks;
+        const std::vector<std::size_t> &members = groups[g];
+        const KernelParameters &parameters = groupParameters[g];
+        unsigned int numPaths = std::min(pathsPerChunk, numSimulations - chunk * pathsPerChunk);
+
+        // Simulate the chunk once, keeping both averages of every path
+        EngineContext::Lease lease = context.acquire();
+        NormalStream &stream = startChunkStream(lease, config, chunk);
+        PathArena &arena = lease.arena();
+        double *normals = arena.allocate<double>(parameters.numSteps * pathBlockWidth);
+        std::fill(normals, normals + parameters.numSteps * pathBlockWidth, 0.0);
+        double *arithmeticAverages = arena.allocate<double>(numPaths);
+        double *geometricAverages = arena.allocate<double>(numPaths);
+        double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
 
-        double dt = asianOption->getExpiry() / asianOption->getAveragingPeriods();
-        double sumPayoffs = 0.0;
+        for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+            unsigned int width = std::min(pathBlockWidth, numPaths - first);
+            {
+                INSTRUMENT_PHASE(RandomNumbers);
+                drawBlockNormals(stream, parameters.numSteps, width, normals);
+            }
+            {
+                INSTRUMENT_PHASE(PathStepping);
+                simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
+            }
+
+            INSTRUMENT_PHASE(Payoff);
+            for (unsigned int k = 0; k < width; ++k) {
+                arithmeticAverages[first + k] = ArithmeticAveraging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods);
+                geometricAverages[first + k] = GeometricAveraging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods);
+            }
+        }
 
-        for (unsigned int i = 0; i < numSimulations; ++i) {
-            double sumSpot = 0.0;
-            double productSpot = 1.0;
-            double spotPath = spot;
+        countSimulatedPaths(numPaths, parameters.numSteps);
 
-            for (unsigned int j = 0; j < asianOption->getAveragingPeriods(); ++j) {
-                if (j > 0) {
-                    double randNormal = dist(gen);
-                    double drift = (riskFreeRate - 0.5 * volatility * volatility) * dt;
-                    double diffusion = volatility * std::sqrt(dt) * randNormal;
-                    spotPath *= std::exp(drift + diffusion);
+        // Every contract in the group only pays for its payoff evaluation on the shared averages
+        INSTRUMENT_PHASE(Payoff);
+        for (std::size_t m = 0; m < members.size(); ++m) {
+            const AsianOption &contract = options[members[m]];
+            const double *averages = contract.getAveragingType() == AsianOption::AveragingType::Arithmetic ? arithmeticAverages : geometricAverages;
+            RunningStatistics &payoffs = chunkPayoffs[g][chunk * members.size() + m];
+            withPolicies(contract, [&](auto, auto payoff) {
+                for (unsigned int i = 0; i < numPaths; ++i) {
+                    payoffs.add(decltype(payoff)::payoff(averages[i], contract.getStrike()));
                 }
-                sumSpot += spotPath;
-                productSpot *= spotPath;
+            });
+        }
+    });
+
+    // Reduce in chunk order, exactly as calculatePriceGBM does; every result reports the wall time of the whole batch
+    std::vector<PricingResult> results(options.size());
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        for (std::size_t m = 0; m < groups[g].size(); ++m) {
+            std::size_t i = groups[g][m];
+            RunningStatistics payoffs;
+            for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+                payoffs += chunkPayoffs[g][chunk * groups[g].size() + m];
             }
+            results[i] = makeResult(payoffs, std::exp(-marketData[i].riskFreeRate * options[i].getExpiry()), start);
+        }
+    }
+    return results;
+}
+
+double PricingEngine::calculatePriceGeometricClosedForm(const Option &option, double spot, double riskFreeRate, double volatility) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceGeometricClosedForm");
+
+    if (asianOption.getAveragingType() != AsianOption::AveragingType::Geometric) {
+        throw std::invalid_argument("calculatePriceGeometricClosedForm requires geometric averaging");
+    }
 
-            double avgSpot;
-            if (asianOption->getAveragingType() == AsianOption::AveragingType::Arithmetic) {
-                avgSpot = sumSpot / asianOption->getAveragingPeriods();
-            } else { // AsianOption::Geometric
-                avgSpot = std::pow(productSpot, 1.0 / asianOption->getAveragingPeriods());
+    double expectedPayoff = geometricExpectedPayoff(asianOption, spot, riskFreeRate, volatility);
+    return expectedPayoff * std::exp(-riskFreeRate * asianOption.getExpiry());
+}
+
+double PricingEngine::calculatePriceControlVariate(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations) {
+    return calculatePriceControlVariate(option, spot, riskFreeRate, volatility, numSimulations, randomConfig()).price;
+}
+
+PricingResult PricingEngine::calculatePriceControlVariate(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceControlVariate");
+
+    KernelParameters parameters = makeKernelParameters(asianOption, spot, riskFreeRate, volatility);
+    auto start = std::chrono::steady_clock::now();
+
+    ControlVariateStatistics statistics = withPolicies(asianOption, [&](auto averaging, auto payoff) {
+        using Averaging = decltype(averaging);
+        using Payoff = decltype(payoff);
+
+        return sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+            double *normals = arena.allocate<double>(parameters.numSteps * pathBlockWidth);
+            std::fill(normals, normals + parameters.numSteps * pathBlockWidth, 0.0);
+            double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+            ControlVariateStatistics chunkStatistics;
+
+            for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                unsigned int width = std::min(pathBlockWidth, numPaths - first);
+                {
+                    INSTRUMENT_PHASE(RandomNumbers);
+                    drawBlockNormals(stream, parameters.numSteps, width, normals);
+                }
+                {
+                    INSTRUMENT_PHASE(PathStepping);
+                    simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
+                }
+
+                // The control is the same contract with geometric averaging
+                INSTRUMENT_PHASE(Payoff);
+                for (unsigned int k = 0; k < width; ++k) {
+                    double y = Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike);
+                    double x = Payoff::payoff(GeometricAveraging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike);
+                    chunkStatistics.add(x, y);
+                }
             }
+            countSimulatedPaths(numPaths, parameters.numSteps);
+            return chunkStatistics;
+        });
+    });
+
+    // Regression coefficient b = Cov(X, Y) / Var(X); a degenerate control (e.g. never in the money) falls back to the plain estimate.
+    // The residual Y - b X has variance Var(Y) - Cov(X, Y)^2 / Var(X).
+    double beta = statistics.m2X > 0.0 ? statistics.coMoment / statistics.m2X : 0.0;
+    double residualM2 = std::max(statistics.m2Y - beta * statistics.coMoment, 0.0);
+
+    double expectedX = geometricExpectedPayoff(asianOption, spot, riskFreeRate, volatility);
+    double discount = std::exp(-riskFreeRate * asianOption.getExpiry());
+
+    PricingResult result;
+    result.price = (statistics.meanY - beta * (statistics.meanX - expectedX)) * discount;
+    result.pathsUsed = statistics.count;
+    result.variance = statistics.count > 1 ? residualM2 / (statistics.count - 1) * discount * discount : 0.0;
+    result.standardError = statistics.count > 0 ? std::sqrt(result.variance / statistics.count) : 0.0;
+    result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+PricingResult PricingEngine::calculatePrice(Method method, const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config) {
+    switch (method) {
+        case Method::Naive:
+            return calculatePriceNaive(option, spot, riskFreeRate, volatility, numSimulations, config);
+        case Method::Antithetic:
+            return calculatePriceAntithetic(option, spot, riskFreeRate, volatility, numSimulations, config);
+        case Method::GBM:
+            return calculatePriceGBM(option, spot, riskFreeRate, volatility, numSimulations, config);
+        case Method::ControlVariate:
+            return calculatePriceControlVariate(option, spot, riskFreeRate, volatility, numSimulations, config);
+        case Method::ImportanceSampling:
+            return calculatePriceImportanceSampling(option, spot, riskFreeRate, volatility, numSimulations, config).price;
+    }
+    throw std::invalid_argument("Unknown pricing method");
+}
+
+PricingResult PricingEngine::calculatePriceAdaptive(Method method, const Option &option, double spot, double riskFreeRate, double volatility, const StoppingCriteria &criteria, const SimulationConfig &config) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+    // Batches are whole chunks taken from one continuous sequence of streams, so the paths simulated are the same for any batch sizes
+    SimulationConfig batchConfig = config;
+    unsigned int maxChunks = (criteria.maxSimulations + pathsPerChunk - 1) / pathsPerChunk;
+    unsigned int chunksDone = 0;
+    unsigned int batchChunks = std::max(config.numThreads, 1u);
+    bool hasErrorTarget = criteria.absoluteError > 0.0 || criteria.relativeError > 0.0;
+    PricingResult result;
 
-            sumPayoffs += option.payoff(avgSpot);
+    while (chunksDone < maxChunks) {
+        batchChunks = std::min(batchChunks, maxChunks - chunksDone);
+        unsigned int batchSimulations = std::min(batchChunks * pathsPerChunk, criteria.maxSimulations - chunksDone * pathsPerChunk);
+        batchConfig.firstChunk = config.firstChunk + chunksDone;
+        result += calculatePrice(method, option, spot, riskFreeRate, volatility, batchSimulations, batchConfig);
+        chunksDone += batchChunks;
+
+        // Meeting either error target is enough, so the effective target is the looser of the enabled ones
+        double target = 0.0;
+        if (criteria.absoluteError > 0.0) {
+            target = criteria.absoluteError;
+        }
+        if (criteria.relativeError > 0.0) {
+            target = std::max(target, criteria.relativeError * std::fabs(result.price));
+        }
+        if (hasErrorTarget && result.standardError <= target) {
+            break;
+        }
+
+        // Size the next batch to reach the error target (standard error falls as 1/sqrt(n)), at least doubling the sample otherwise
+        unsigned int nextChunks = chunksDone;
+        if (hasErrorTarget && target > 0.0) {
+            double ratio = result.standardError / target;
+            double neededChunks = chunksDone * ratio * ratio * 1.1 - chunksDone;
+            nextChunks = static_cast<unsigned int>(std::min(std::max(neededChunks, 1.0), static_cast<double>(chunksDone)));
         }
 
-        double price = (sumPayoffs / numSimulations) * std::exp(-riskFreeRate * asianOption->getExpiry());
-        return price;
+        // Never start a batch that the time budget, extrapolated from the time per chunk so far, cannot accommodate
+        if (criteria.timeBudget > 0.0) {
+            double timePerChunk = elapsed() / chunksDone;
+            double remaining = criteria.timeBudget - elapsed();
+            double affordableChunks = std::floor(remaining / timePerChunk);
+            if (affordableChunks < 1.0) {
+                break;
+            }
+            nextChunks = static_cast<unsigned int>(std::min(static_cast<double>(nextChunks), affordableChunks));
+        }
+        batchChunks = std::max(nextChunks, 1u);
     }
+
+    result.wallTime = elapsed();
+    return result;
 }
 
+PricingResult PricingEngine::calculatePriceQuasiMonteCarlo(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, unsigned int numReplicas, const SimulationConfig &config) {
+    const AsianOption &asianOption = asAsianOption(option, "calculatePriceQuasiMonteCarlo");
+
+    if (numReplicas == 0) {
+        throw std::invalid_argument("calculatePriceQuasiMonteCarlo requires at least one replica");
+    }
+
+    KernelParameters parameters = makeKernelParameters(asianOption, spot, riskFreeRate, volatility);
+    unsigned int numSteps = parameters.numSteps;
 
+    auto start = std::chrono::steady_clock::now();
+
+    // One Sobol dimension per simulated step, filled in Brownian-bridge order over the remaining fixing dates
+    const std::vector<double> &fixingTimes = asianOption.getFixingTimes();
+    std::vector<double> times(fixingTimes.end() - numSteps, fixingTimes.end());
+    std::vector<double> sqrtSteps(numSteps);
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        sqrtSteps[j] = std::sqrt(times[j] - (j == 0 ? 0.0 : times[j - 1]));
+    }
+    BrownianBridge bridge(times);
+
+    std::vector<SobolSequence> replicas;
+    replicas.reserve(numReplicas);
+    for (unsigned int r = 0; r < numReplicas; ++r) {
+        replicas.emplace_back(std::max(numSteps, 1u), config.seed ^ (0x9e3779b97f4a7c15ULL * (r + 1)) ^ (0xbf58476d1ce4e5b9ULL * config.streamId));
+    }
+
+    unsigned int numChunks = (numSimulations + pathsPerChunk - 1) / pathsPerChunk;
+    std::vector<RunningStatistics> chunkPayoffs(numReplicas * numChunks);
+
+    EngineContext &context = engineContext(config);
+    withPolicies(asianOption, [&](auto averaging, auto payoff) {
+        using Averaging = decltype(averaging);
+        using Payoff = decltype(payoff);
+
+        parallelFor(context.threadPool(), numReplicas * numChunks, config.numThreads, [&](unsigned int task) {
+            INSTRUMENT_PHASE(Chunk);
+            INSTRUMENT_COUNT(Chunks, 1);
+            unsigned int r = task / numChunks;
+            unsigned int chunk = task % numChunks;
+            unsigned int numPaths = std::min(pathsPerChunk, numSimulations - chunk * pathsPerChunk);
+
+            SobolSequence sequence = replicas[r];
+            sequence.skipTo(static_cast<std::uint64_t>(config.firstChunk + chunk) * pathsPerChunk);
+
+            EngineContext::Lease lease = context.acquire();
+            PathArena &arena = lease.arena();
+            const unsigned int dimension = sequence.getDimension();
+            double *uniforms = arena.allocate<double>(dimension * pathBlockWidth);
+            double *gaussians = arena.allocate<double>(dimension * pathBlockWidth);
+            double *path = arena.allocate<double>(numSteps);
+            double *normals = arena.allocate<double>(numSteps * pathBlockWidth);
+            std::fill(normals, normals + numSteps * pathBlockWidth, 0.0);
+            double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+            RunningStatistics &payoffs = chunkPayoffs[task];
+
+            for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                unsigned int width = std::min(pathBlockWidth, numPaths - first);
+
+                // Quasi-random points -> normals, in one buffered transform per block -> bridged Brownian paths -> standardised
+                // increments for the block kernel
+                {
+                    INSTRUMENT_PHASE(RandomNumbers);
+                    for (unsigned int k = 0; k < width; ++k) {
+                        sequence.next(uniforms + k * dimension);
+                    }
+                    inverseNormalCdfBuffer(uniforms, gaussians, static_cast<std::size_t>(width) * dimension);
+                    for (unsigned int k = 0; k < width; ++k) {
+                        bridge.buildPath(gaussians + k * dimension, path);
+                        for (unsigned int j = 0; j < numSteps; ++j) {
+                            normals[j * pathBlockWidth + k] = (path[j] - (j == 0 ? 0.0 : path[j - 1])) / sqrtSteps[j];
+                        }
+                    }
+                }
+                {
+                    INSTRUMENT_PHASE(PathStepping);
+                    simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
+                }
+
+                INSTRUMENT_PHASE(Payoff);
+                for (unsigned int k = 0; k < width; ++k) {
+                    payoffs.add(Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike));
+                }
+            }
+            countSimulatedPaths(numPaths, numSteps);
+        });
+    });
+
+    // Each replica is an independent unbiased estimate; their spread gives the error
+    RunningStatistics replicaPrices;
+    double discount = std::exp(-riskFreeRate * asianOption.getExpiry());
+    for (unsigned int r = 0; r < numReplicas; ++r) {
+        RunningStatistics payoffs;
+        for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+            payoffs += chunkPayoffs[r * numChunks + chunk];
+        }
+        replicaPrices.add(payoffs.getMean() * discount);
+    }
+
+    PricingResult result;
+    result.price = replicaPrices.getMean();
+    result.pathsUsed = static_cast<unsigned long long>(numSimulations) * numReplicas;
+    result.standardError = std::sqrt(replicaPrices.getVariance() / numReplicas);
+    result.variance = result.standardError * result.standardError * result.pathsUsed;
+    result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+Greeks PricingEngine::calculateGreeks(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config, GreeksMethod method) {
+    const AsianOption &asianOption = asAsianOption(option, "calculateGreeks");
+    if (!asianOption.hasUniformSchedule()) {
+        throw std::invalid_argument("calculateGreeks requires an unseasoned option on the equally spaced schedule");
+    }
+
+    double expiry = asianOption.getExpiry();
+    double n = asianOption.getAveragingPeriods();
+    double dt = expiry / n;
+    double sqrtDt = std::sqrt(dt);
+    unsigned int numSteps = asianOption.getAveragingPeriods() - 1;
+    bool arithmetic = asianOption.getAveragingType() == AsianOption::AveragingType::Arithmetic;
+    bool call = asianOption.getType() == Option::Type::Call;
+    double strike = asianOption.getStrike();
+
+    auto start = std::chrono::steady_clock::now();
+
+    GreekStatistics statistics = sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &arena, unsigned int numPaths) {
+        double *normals = arena.allocate<double>(numSteps * pathBlockWidth);
+        std::fill(normals, normals + numSteps * pathBlockWidth, 0.0);
+        GreekStatistics chunkStatistics;
+
+        if (method == GreeksMethod::PathwiseLikelihoodRatio) {
+            double drift = (riskFreeRate - 0.5 * volatility * volatility) * dt;
+            double diffusion = volatility * sqrtDt;
+            double discount = std::exp(-riskFreeRate * expiry);
+            double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth], sumSpotStep[pathBlockWidth], sumSpotNormal[pathBlockWidth], sumNormal[pathBlockWidth];
+
+            for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                unsigned int width = std::min(pathBlockWidth, numPaths - first);
+                {
+                    INSTRUMENT_PHASE(RandomNumbers);
+                    drawBlockNormals(stream, numSteps, width, normals);
+                }
+                {
+                    INSTRUMENT_PHASE(PathStepping);
+                    simulateSensitivityBlock(spot, drift, diffusion, normals, numSteps, sumSpot, sumLogSpot, sumSpotStep, sumSpotNormal, sumNormal);
+                }
+
+                INSTRUMENT_PHASE(Payoff);
+                for (unsigned int k = 0; k < width; ++k) {
+                    // Derivatives of the path average with respect to volatility and rate, using S_i = spot * exp((r - sigma^2/2) t_i + sigma W(t_i))
+                    double average, averageVega, averageRho, score;
+                    if (arithmetic) {
+                        average = sumSpot[k] / n;
+                        averageVega = (sqrtDt * sumSpotNormal[k] - volatility * dt * sumSpotStep[k]) / n;
+                        averageRho = dt * sumSpotStep[k] / n;
+                    } else {
+                        average = std::exp(sumLogSpot[k] / n);
+                        averageVega = average * (sqrtDt * sumNormal[k] - volatility * dt * n * (n - 1.0) / 2.0) / n;
+                        averageRho = average * dt * (n - 1.0) / 2.0;
+                    }
+
+                    // d/dspot of the log-density of the average, holding the path shape after the first step fixed. The spot is itself
+                    // a fixing, so moving it shifts the average directly as well as through the first step's distribution.
+                    if (numSteps == 0) {
+                        score = 0.0;
+                    } else if (arithmetic) {
+                        double laterFixings = sumSpot[k] - spot;
+                        score = normals[k] / diffusion * (1.0 / laterFixings + 1.0 / spot) + 1.0 / laterFixings;
+                    } else {
+                        score = normals[k] / diffusion * n / ((n - 1.0) * spot);
+                    }
+
+                    double payoff = option.payoff(average);
+                    double slope = call ? (average > strike ? 1.0 : 0.0) : (average < strike ? -1.0 : 0.0);
+                    double pathDelta = discount * slope * average / spot;
+
+                    chunkStatistics.price.add(discount * payoff);
+                    chunkStatistics.delta.add(pathDelta);
+                    chunkStatistics.gamma.add(pathDelta * (score - 1.0 / spot));
+                    chunkStatistics.vega.add(discount * slope * averageVega);
+                    chunkStatistics.rho.add(discount * (slope * averageRho - expiry * payoff));
+                }
+            }
+        } else { // GreeksMethod::BumpAndReprice
+            const double spotBump = 0.01 * spot;
+            const double volatilityBump = 0.001;
+            const double rateBump = 0.0001;
+
+            // Base, spot up/down, volatility up/down and rate up/down scenarios, all driven by the same normals
+            const double spots[7] = {spot, spot + spotBump, spot - spotBump, spot, spot, spot, spot};
+            const double volatilities[7] = {volatility, volatility, volatility, volatility + volatilityBump, volatility - volatilityBump, volatility, volatility};
+            const double rates[7] = {riskFreeRate, riskFreeRate, riskFreeRate, riskFreeRate, riskFreeRate, riskFreeRate + rateBump, riskFreeRate - rateBump};
+            double sumSpot[7][pathBlockWidth], sumLogSpot[7][pathBlockWidth];
+
+            for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+                unsigned int width = std::min(pathBlockWidth, numPaths - first);
+                {
+                    INSTRUMENT_PHASE(RandomNumbers);
+                    drawBlockNormals(stream, numSteps, width, normals);
+                }
+                {
+                    INSTRUMENT_PHASE(PathStepping);
+                    for (unsigned int s = 0; s < 7; ++s) {
+                        simulatePathBlock(spots[s], (rates[s] - 0.5 * volatilities[s] * volatilities[s]) * dt, volatilities[s] * sqrtDt,
+                                          normals, numSteps, sumSpot[s], sumLogSpot[s]);
+                    }
+                }
+
+                INSTRUMENT_PHASE(Payoff);
+                for (unsigned int k = 0; k < width; ++k) {
+                    double values[7];
+                    for (unsigned int s = 0; s < 7; ++s) {
+                        values[s] = std::exp(-rates[s] * expiry) * option.payoff(blockAverage(asianOption, sumSpot[s][k], sumLogSpot[s][k]));
+                    }
+                    chunkStatistics.price.add(values[0]);
+                    chunkStatistics.delta.add((values[1] - values[2]) / (2.0 * spotBump));
+                    chunkStatistics.gamma.add((values[1] - 2.0 * values[0] + values[2]) / (spotBump * spotBump));
+                    chunkStatistics.vega.add((values[3] - values[4]) / (2.0 * volatilityBump));
+                    chunkStatistics.rho.add((values[5] - values[6]) / (2.0 * rateBump));
+                }
+            }
+        }
+        countSimulatedPaths(numPaths, numSteps);
+        return chunkStatistics;
+    });
+
+    // Samples are already discounted
+    Greeks greeks;
+    greeks.price = makeResult(statistics.price, 1.0, start);
+    greeks.delta = makeResult(statistics.delta, 1.0, start);
+    greeks.gamma = makeResult(statistics.gamma, 1.0, start);
+    greeks.vega = makeResult(statistics.vega, 1.0, start);
+    greeks.rho = makeResult(statistics.rho, 1.0, start);
+    return greeks;
+}
+
+AdjointGreeks PricingEngine::calculateGreeksAdjoint(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config, unsigned int checkpointSteps) {
+    const AsianOption &asianOption = asAsianOption(option, "calculateGreeksAdjoint");
+    if (!asianOption.hasUniformSchedule()) {
+        throw std::invalid_argument("calculateGreeksAdjoint requires an unseasoned option on the equally spaced schedule");
+    }
+
+    if (checkpointSteps == 0) {
+        throw std::invalid_argument("calculateGreeksAdjoint requires a positive checkpoint interval");
+    }
+
+    double expiry = asianOption.getExpiry();
+    double n = asianOption.getAveragingPeriods();
+    unsigned int numSteps = asianOption.getAveragingPeriods() - 1;
+    unsigned int numSegments = std::max(1u, (numSteps + checkpointSteps - 1) / checkpointSteps);
+    bool arithmetic = asianOption.getAveragingType() == AsianOption::AveragingType::Arithmetic;
+    bool call = asianOption.getType() == Option::Type::Call;
+    double strike = asianOption.getStrike();
+    double discount = std::exp(-riskFreeRate * expiry);
+    double drift = riskFreeRate - 0.5 * volatility * volatility;
+
+    std::vector<double> times(numSteps + 1);
+    for (unsigned int i = 0; i <= numSteps; ++i) {
+        times[i] = i * (expiry / n);
+    }
+
+    // Step lengths and their square roots are the same on every path
+    std::vector<double> steps(numSteps), rootSteps(numSteps);
+    for (unsigned int i = 0; i < numSteps; ++i) {
+        steps[i] = times[i + 1] - times[i];
+        rootSteps[i] = std::sqrt(steps[i]);
+    }
+
+    // Estimators: price, delta, vega, rho, expiry, then one per fixing date t_1, ..., t_{n-1}
+    const unsigned int numOutputs = 5 + numSteps;
+    auto start = std::chrono::steady_clock::now();
+
+    StatisticsVector statistics = sumOverChunks(numSimulations, config, [&](NormalStream &stream, PathArena &, unsigned int numPaths) {
+        Tape &tape = Tape::current();
+        std::size_t origin = tape.mark();
+
+        std::vector<double> normals(numSteps), checkpointLogSpot(numSegments), fixings(std::min(checkpointSteps, numSteps)), timeAdjoints(numSteps + 1), sensitivities(numOutputs);
+        StatisticsVector chunkStatistics;
+        chunkStatistics.values.resize(numOutputs);
+
+        for (unsigned int path = 0; path < numPaths; ++path) {
+            // Same normals, in the same order, as the GBM engine
+            stream.fill(normals.data(), numSteps);
+
+            // Forward pass, keeping the log-spot at the start of every segment
+            double logSpot = std::log(spot);
+            double sum = arithmetic ? spot : logSpot;
+            for (unsigned int segment = 0; segment < numSegments; ++segment) {
+                unsigned int first = segment * checkpointSteps;
+                checkpointLogSpot[segment] = logSpot;
+                advancePath(logSpot, sum, drift, volatility, steps, rootSteps, normals, first, std::min(first + checkpointSteps, numSteps), arithmetic);
+            }
+
+            std::fill(sensitivities.begin(), sensitivities.end(), 0.0);
+            double average = arithmetic ? sum / n : std::exp(sum / n);
+            sensitivities[0] = discount * option.payoff(average);
+
+            // Every derivative of an out-of-the-money path is zero, so only paths with a payoff are swept
+            if (sensitivities[0] > 0.0) {
+                // Payoff and discounting are recorded on the tape: gives the adjoint of the final running sum
+                tape.rewind(origin);
+                Active sumIn = Active::variable(sum);
+                Active rate = Active::variable(riskFreeRate);
+                Active maturity = Active::variable(expiry);
+                Active activeAverage = arithmetic ? sumIn / n : exp(sumIn / n);
+                Active value = exp(-rate * maturity) * (call ? max(activeAverage - strike, 0.0) : max(strike - activeAverage, 0.0));
+                tape.clearAdjoints();
+                tape.adjoint(value.getIndex()) = 1.0;
+                tape.propagate(origin);
+
+                double sumAdjoint = tape.adjoint(sumIn.getIndex());
+                sensitivities[3] += tape.adjoint(rate.getIndex());
+                sensitivities[4] += tape.adjoint(maturity.getIndex());
+
+                // The path recursion has a hand-written adjoint: segments are swept last to first, the arithmetic fixings of each
+                // recomputed from its checkpoint, carrying the log-spot adjoint backwards
+                double logSpotAdjoint = 0.0, driftAdjoint = 0.0, volatilityAdjoint = 0.0;
+                std::fill(timeAdjoints.begin(), timeAdjoints.end(), 0.0);
+                for (unsigned int segment = numSegments; segment-- > 0;) {
+                    unsigned int first = segment * checkpointSteps;
+                    unsigned int last = std::min(first + checkpointSteps, numSteps);
+                    if (arithmetic) {
+                        double segmentLogSpot = checkpointLogSpot[segment];
+                        for (unsigned int i = first; i < last; ++i) {
+                            segmentLogSpot = segmentLogSpot + drift * steps[i] + volatility * rootSteps[i] * normals[i];
+                            fixings[i - first] = std::exp(segmentLogSpot);
+                        }
+                    }
+                    advancePathAdjoint(logSpotAdjoint, sumAdjoint, driftAdjoint, volatilityAdjoint, timeAdjoints, drift, volatility, steps, rootSteps,
+                                       normals, fixings, first, last, arithmetic);
+                }
+
+                // The path starts from log-spot log(S) and running sum S (arithmetic) or log(S) (geometric); drift = r - sigma^2 / 2
+                sensitivities[1] += (logSpotAdjoint + (arithmetic ? sumAdjoint * spot : sumAdjoint)) / spot;
+                sensitivities[2] += volatilityAdjoint - volatility * driftAdjoint;
+                sensitivities[3] += driftAdjoint;
+                for (unsigned int i = 1; i <= numSteps; ++i) {
+                    sensitivities[4 + i] += timeAdjoints[i];
+                }
+            }
+
+            for (unsigned int i = 0; i < numOutputs; ++i) {
+                chunkStatistics.values[i].add(sensitivities[i]);
+            }
+        }
+        tape.rewind(origin);
+        countSimulatedPaths(numPaths, numSteps);
+        return chunkStatistics;
+    });
+
+    // Samples are already discounted
+    AdjointGreeks greeks;
+    greeks.price = makeResult(statistics.values[0], 1.0, start);
+    greeks.delta = makeResult(statistics.values[1], 1.0, start);
+    greeks.vega = makeResult(statistics.values[2], 1.0, start);
+    greeks.rho = makeResult(statistics.values[3], 1.0, start);
+    greeks.expiry = makeResult(statistics.values[4], 1.0, start);
+    for (unsigned int i = 1; i <= numSteps; ++i) {
+        greeks.fixingTimes.push_back(makeResult(statistics.values[4 + i], 1.0, start));
+    }
+    return greeks;
+}
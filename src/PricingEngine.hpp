@@ -1,11 +1,162 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include "Option.hpp"
+#include "AsianOption.hpp"
+#include "PricingResult.hpp"
+#include "RandomStream.hpp"
 
+class EngineContext;
+
+// Controls how a Monte Carlo run is executed. Paths are split into fixed-size chunks and every chunk draws from its own
+// random stream derived from (seed, stream id, chunk index), so a given seed produces bit-identical prices for any number of threads.
+struct SimulationConfig {
+    unsigned int numThreads = 1; // threads simulating chunks of paths: the caller and up to numThreads - 1 workers of the context's pool
+    std::uint64_t seed = 0;      // base seed for the per-chunk random streams
+    std::uint32_t streamId = 0;  // selects an independent family of chunk streams for the same seed, e.g. one per scenario
+    unsigned int firstChunk = 0; // index of the first chunk's stream; lets a run continue the paths of an earlier one
+    RandomGenerator generator = RandomGenerator::Philox; // MersenneTwister reproduces the streams of earlier versions
+    EngineContext *context = nullptr; // scratch memory and streams reused across calls; nullptr uses EngineContext::shared()
+};
+
+// When an adaptive run stops: after the first batch that meets either error target, once the time budget cannot fit another batch,
+// or at maxSimulations samples. Zero disables a criterion. Errors are compared with the standard error (one standard deviation).
+struct StoppingCriteria {
+    double absoluteError = 0.0;              // target standard error in price units
+    double relativeError = 0.0;              // target standard error as a fraction of the price
+    double timeBudget = 0.0;                 // wall-clock deadline in seconds
+    unsigned int maxSimulations = 10000000;  // cap on the number of samples
+};
+
+// Target of a multilevel run: a root-mean-square error, split between bias and statistical error unless the finest level is the
+// contract's own schedule, which has no bias
+struct MultilevelCriteria {
+    double targetError = 0.01;                     // root-mean-square error target in price units
+    unsigned int initialSamples = 4096;            // samples of each level when it is added, before its variance is used
+    unsigned long long maxSimulations = 100000000; // cap on the samples over all levels
+};
+
+// Grid of the finite-difference engine
+struct FiniteDifferenceConfig {
+    unsigned int spaceSteps = 200;    // intervals of the z grid
+    unsigned int timeSteps = 100;     // steps to expiry, shared among the intervals between fixing dates; denser schedules are averaged
+    unsigned int rannacherSteps = 2;  // steps next to expiry taken as implicit half steps, to damp the payoff kink
+    EngineContext *context = nullptr; // grid memory reused across calls; nullptr uses EngineContext::shared()
+};
+
+// Market inputs needed to price one contract
+struct MarketData {
+    double spot;
+    double riskFreeRate;
+    double volatility;
+};
+
+// The engines follow each AsianOption's fixing schedule: paths step directly between the remaining fixing dates, and the past fixings
+// of a seasoned contract enter the average as known values, so only the remaining dates are simulated.
 class PricingEngine {
 public:
+    enum class Method { Naive, Antithetic, GBM, ControlVariate, ImportanceSampling };
+    enum class GreeksMethod { PathwiseLikelihoodRatio, BumpAndReprice };
+
     static double calculatePriceNaive(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations);
     static double calculatePriceAntithetic(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations);
     static double calculatePriceGBM(const Option& option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations);
-};
 
+    // Overloads taking an explicit simulation configuration (thread count and seed). They return the price together with its
+    // standard error, the number of samples and the wall time, all accumulated in the same pass as the price.
+    static PricingResult calculatePriceNaive(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+    static PricingResult calculatePriceAntithetic(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+    static PricingResult calculatePriceGBM(const Option& option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Closed-form price of a geometric-average Asian option under GBM over its discrete schedule, past fixings included.
+    // Throws std::invalid_argument unless the option is an AsianOption with geometric averaging.
+    static double calculatePriceGeometricClosedForm(const Option &option, double spot, double riskFreeRate, double volatility);
+
+    // Monte Carlo price using the geometric-average payoff on the same paths as a control variate, with its exact mean from the closed form.
+    // Intended for arithmetic options, where the two averages are highly correlated; the regression coefficient is estimated from the paths.
+    static double calculatePriceControlVariate(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations);
+    static PricingResult calculatePriceControlVariate(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Randomised quasi-Monte Carlo: numReplicas independently scrambled Sobol sequences of numSimulations points each, with dimension
+    // equal to the number of simulated steps, mapped to paths through a Brownian bridge. The price is the mean of the replica estimates
+    // and the standard error comes from their spread; variance is reported as the per-sample variance that standard error implies.
+    // Schedules with more than SobolSequence::maxDimension simulated steps throw std::invalid_argument.
+    static PricingResult calculatePriceQuasiMonteCarlo(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, unsigned int numReplicas, const SimulationConfig &config);
+
+    // Price, delta, gamma, vega and rho from a single pass over GBM paths (the same paths as calculatePriceGBM with this configuration).
+    // PathwiseLikelihoodRatio differentiates each path's payoff for delta, vega and rho, and gets gamma by applying the likelihood ratio of
+    // the first simulated step to the pathwise delta, so the payoff kink never has to be differentiated twice.
+    // BumpAndReprice revalues every path at spot +/- 1%, volatility +/- 0.001 and rate +/- 0.0001 with the same normals (common random
+    // numbers) and takes central differences; it is the fallback for payoffs the pathwise estimators do not cover.
+    // Requires the equally spaced, unseasoned schedule; throws std::invalid_argument otherwise.
+    static Greeks calculateGreeks(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config,
+                                  GreeksMethod method = GreeksMethod::PathwiseLikelihoodRatio);
+
+    // All first-order sensitivities by reverse-mode differentiation of each path, on the same paths as calculatePriceGBM.
+    // The fixing dates are inputs too, so one backward sweep per path gives n + 3 sensitivities. The payoff is recorded on the tape
+    // (Adjoint.hpp) and the path recursion has a hand-written reverse sweep. The forward pass keeps the state every checkpointSteps steps,
+    // and the sweep recomputes one segment at a time from these, so its memory is bounded by one segment. Requires the equally spaced, unseasoned schedule.
+    static AdjointGreeks calculateGreeksAdjoint(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config,
+                                                unsigned int checkpointSteps = 64);
+
+    // GBM price with paths streamed through a precomputed step table (PathStream.hpp), so memory does not grow with the number of
+    // fixings; for long schedules such as daily averaging. On the uniform schedule it uses the same normals as calculatePriceGBM.
+    static PricingResult calculatePriceStreaming(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+
+    // GBM price with importance sampling for out-of-the-money contracts (ImportanceSampling.hpp): the normals are shifted by the optimal
+    // drift, solved for before simulating, and each payoff is weighted by its likelihood ratio. The variance of plain Monte Carlo is
+    // estimated from the same weighted paths, so the result reports the variance-reduction factor without a second run.
+    static ImportanceSamplingResult calculatePriceImportanceSampling(const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Multilevel Monte Carlo (Multilevel.hpp) for finely monitored contracts: level l simulates paths on every 2^(L - l)-th fixing date and
+    // corrects level l - 1 with the same Brownian path on the coarser grid, so most samples are cheap coarse paths and few need the full
+    // schedule. Samples per level follow Giles' allocation N_l ~ sqrt(V_l / C_l) from running variance estimates; levels are added until
+    // the estimated bias fits the target. Each level draws from its own family of chunk streams, so results do not depend on the thread count.
+    static MultilevelResult calculatePriceMultilevel(const Option &option, double spot, double riskFreeRate, double volatility, const MultilevelCriteria &criteria, const SimulationConfig &config);
+
+    // Deterministic price, delta and gamma of an arithmetic-average contract from Vecer's one-dimensional reduced PDE (FiniteDifference.hpp),
+    // solved with Crank-Nicolson and Rannacher start-up steps. Follows the contract's fixing schedule, past fixings included.
+    // Delta and gamma come from the grid's derivatives at the contract's z0. Throws std::invalid_argument for geometric averaging, which has a closed form.
+    static FiniteDifferenceResult calculatePriceFiniteDifference(const Option &option, double spot, double riskFreeRate, double volatility,
+                                                                 const FiniteDifferenceConfig &config = FiniteDifferenceConfig());
+
+    // Lognormal moment-matching (Levy, Turnbull-Wakeman) price of an arithmetic-average contract on its discrete schedule, in
+    // microseconds, with a bracket that holds the exact price (MomentMatching.hpp). Geometric averaging returns the closed form, exact.
+    static MomentMatchingResult calculatePriceMomentMatching(const Option &option, double spot, double riskFreeRate, double volatility);
+
+    // Moment-matching prices of a portfolio; marketData[i] holds the market inputs for options[i]. Contracts sharing the market,
+    // schedule and past fixings share the distribution of their average, and their strikes and put/call flags are then priced in
+    // lanes of momentMatchingLanes (momentMatchingPayoffs). Each result is identical to calculatePriceMomentMatching.
+    static std::vector<MomentMatchingResult> calculatePricesMomentMatching(const std::vector<AsianOption> &options, const std::vector<MarketData> &marketData);
+
+    // Quotes from the moment-matching tier when its error bound is within tolerance, and otherwise with control-variate Monte Carlo
+    // on numSimulations paths
+    static TieredResult calculatePriceTiered(const Option &option, double spot, double riskFreeRate, double volatility, double tolerance, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Runs one of the Monte Carlo methods selected at run time
+    static PricingResult calculatePrice(Method method, const Option &option, double spot, double riskFreeRate, double volatility, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Simulates in batches of whole chunks until the stopping criteria are met and returns the estimate so far.
+    // Batch sizes are chosen from the running standard error and the measured time per chunk, so easy contracts stop early
+    // and a time budget is honoured without overshooting by more than one batch's estimated duration.
+    static PricingResult calculatePriceAdaptive(Method method, const Option &option, double spot, double riskFreeRate, double volatility, const StoppingCriteria &criteria, const SimulationConfig &config);
+
+    // Estimates after each of an increasing list of path counts, all from one growing set of paths: checkpoints[i] paths give results[i],
+    // identical to calculatePrice with that many paths and the same configuration, but every path is simulated once. Supports the
+    // Naive, Antithetic and GBM methods; every result reports the wall time of the whole run.
+    static std::vector<PricingResult> calculatePriceConvergence(Method method, const Option &option, double spot, double riskFreeRate, double volatility, const std::vector<unsigned int> &checkpoints, const SimulationConfig &config);
+
+    // Prices a portfolio of Asian options with the GBM method; marketData[i] holds the market inputs for options[i].
+    // Contracts sharing spot, rate, volatility, expiry, fixing schedule and past fixings reuse one set of simulated averages, so extra strikes,
+    // put/call flags or averaging types on the same paths only cost their payoff evaluation. Each result is identical to
+    // calculatePriceGBM with the same configuration.
+    static std::vector<PricingResult> calculatePricesBatch(const std::vector<AsianOption> &options, const std::vector<MarketData> &marketData, unsigned int numSimulations, const SimulationConfig &config);
+
+    // Number of paths simulated by each chunk; also the granularity at which work is shared between threads
+    static const unsigned int pathsPerChunk = 4096;
+
+    // Single-threaded configuration seeded from std::random_device, used by the overloads without a configuration;
+    // pass a SimulationConfig with an explicit seed for reproducible runs
+    static SimulationConfig randomConfig();
+};
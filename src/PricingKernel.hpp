@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "AsianOption.hpp"
+#include "EngineContext.hpp"
+#include "Instrumentation.hpp"
+#include "PathKernel.hpp"
+#include "PathStream.hpp"
+#include "PricingResult.hpp"
+#include "RandomStream.hpp"
+
+// Compile-time pricing kernels. Policy classes fix the averaging, the payoff and the path scheme as template parameters, so each
+// combination compiles to its own loop with no virtual calls and no branches on the contract inside it. withPolicies() is the one
+// run-time switch, taken once per pricing call.
+
+// Inputs shared by every block of paths in a run. Paths step directly between the remaining fixing dates; fixings already known
+// when the run starts only enter through the initial sums.
+struct KernelParameters {
+    double spot;
+    std::vector<double> drift;     // per step: (r - sigma^2 / 2)(t_{j+1} - t_j)
+    std::vector<double> diffusion; // per step: sigma sqrt(t_{j+1} - t_j)
+    double pastSum;                // sum of the past fixings of a seasoned contract, and of their logarithms
+    double pastLogSum;
+    double initialSum;             // the past sums plus the spot (or its log) when today is a fixing
+    double initialLogSum;
+    double strike;
+    unsigned int averagingPeriods; // every fixing, past and remaining
+    unsigned int numSteps;         // remaining fixings after today
+};
+
+// Kernel inputs for a contract's schedule. The equally spaced schedule fills the tables with the single dt coefficients the engines
+// have always used, so its paths do not change.
+inline KernelParameters makeKernelParameters(const AsianOption &option, double spot, double riskFreeRate, double volatility) {
+    KernelParameters parameters;
+    parameters.spot = spot;
+    parameters.strike = option.getStrike();
+    parameters.averagingPeriods = option.getAveragingPeriods();
+
+    const std::vector<double> &fixingTimes = option.getFixingTimes();
+    bool spotIsFixing = !fixingTimes.empty() && fixingTimes.front() == 0.0;
+    if (option.hasUniformSchedule()) {
+        double dt = option.getExpiry() / option.getAveragingPeriods();
+        parameters.numSteps = option.getAveragingPeriods() - 1;
+        parameters.drift.assign(parameters.numSteps, (riskFreeRate - 0.5 * volatility * volatility) * dt);
+        parameters.diffusion.assign(parameters.numSteps, volatility * std::sqrt(dt));
+    } else {
+        StepTable table = makeStepTable(spot, riskFreeRate, volatility, fixingTimes);
+        parameters.numSteps = table.numSteps();
+        parameters.drift = std::move(table.drift);
+        parameters.diffusion = std::move(table.diffusion);
+    }
+
+    unsigned int pastFixings = option.getPastFixings();
+    parameters.pastSum = pastFixings > 0 ? pastFixings * option.getPastAverage() : 0.0;
+    parameters.pastLogSum = pastFixings > 0 ? pastFixings * std::log(option.getPastAverage()) : 0.0;
+    parameters.initialSum = parameters.pastSum + (spotIsFixing ? spot : 0.0);
+    parameters.initialLogSum = parameters.pastLogSum + (spotIsFixing ? std::log(spot) : 0.0);
+    return parameters;
+}
+
+// Averaging policies: the average of one path from the sum of its fixings and the sum of their logarithms
+struct ArithmeticAveraging {
+    static double average(double sumSpot, double, unsigned int averagingPeriods) { return sumSpot / averagingPeriods; }
+};
+
+struct GeometricAveraging {
+    static double average(double, double sumLogSpot, unsigned int averagingPeriods) { return std::exp(sumLogSpot / averagingPeriods); }
+};
+
+// Payoff policies; std::max compiles to a branch-free maximum
+struct CallPayoff {
+    static double payoff(double average, double strike) { return std::max(average - strike, 0.0); }
+};
+
+struct PutPayoff {
+    static double payoff(double average, double strike) { return std::max(strike - average, 0.0); }
+};
+
+// The vectorised block kernel on a run's schedule, with the diffusion negated for diffusionSign = -1
+inline void simulateBlock(const KernelParameters &parameters, double diffusionSign, const double *normals, double *sumSpot, double *sumLogSpot) {
+    simulateScheduleBlock(parameters.spot, parameters.drift.data(), parameters.diffusion.data(), diffusionSign, normals, parameters.numSteps,
+                          parameters.initialSum, parameters.initialLogSum, sumSpot, sumLogSpot);
+}
+
+// Path schemes: turn one block of step-major normals into pathBlockWidth undiscounted payoff samples
+
+// Scalar reference: each path is stepped with std::exp as in the original naive engine. The geometric average sums the log
+// increments rather than multiplying the fixings, whose product overflows or underflows for long schedules.
+struct NaiveScheme {
+    template <typename Averaging, typename Payoff>
+    static void blockSamples(const KernelParameters &parameters, const double *normals, double *samples) {
+        INSTRUMENT_PHASE(PathStepping); // stepping and payoff are interleaved path by path
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double logSpot = std::log(parameters.spot);
+            double sumSpot = parameters.initialSum;
+            double sumLogSpot = parameters.initialLogSum;
+            double spotPath = parameters.spot;
+            for (unsigned int j = 0; j < parameters.numSteps; ++j) {
+                double increment = parameters.drift[j] + parameters.diffusion[j] * normals[j * pathBlockWidth + k];
+                spotPath *= std::exp(increment);
+                logSpot += increment;
+                sumSpot += spotPath;
+                sumLogSpot += logSpot;
+            }
+            samples[k] = Payoff::payoff(Averaging::average(sumSpot, sumLogSpot, parameters.averagingPeriods), parameters.strike);
+        }
+    }
+};
+
+// The vectorised block kernel, one sample per path
+struct PlainScheme {
+    template <typename Averaging, typename Payoff>
+    static void blockSamples(const KernelParameters &parameters, const double *normals, double *samples) {
+        double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+        {
+            INSTRUMENT_PHASE(PathStepping);
+            simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
+        }
+        INSTRUMENT_PHASE(Payoff);
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            samples[k] = Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike);
+        }
+    }
+};
+
+// Each path averaged with its mirror image (the same normals with the diffusion negated); the pair counts as one sample
+struct AntitheticScheme {
+    template <typename Averaging, typename Payoff>
+    static void blockSamples(const KernelParameters &parameters, const double *normals, double *samples) {
+        double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+        double sumSpotAntithetic[pathBlockWidth], sumLogSpotAntithetic[pathBlockWidth];
+        {
+            INSTRUMENT_PHASE(PathStepping);
+            simulateBlock(parameters, 1.0, normals, sumSpot, sumLogSpot);
+            simulateBlock(parameters, -1.0, normals, sumSpotAntithetic, sumLogSpotAntithetic);
+        }
+        INSTRUMENT_PHASE(Payoff);
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            double payoff = Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike);
+            double payoffAntithetic = Payoff::payoff(Averaging::average(sumSpotAntithetic[k], sumLogSpotAntithetic[k], parameters.averagingPeriods), parameters.strike);
+            samples[k] = (payoff + payoffAntithetic) / 2.0;
+        }
+    }
+};
+
+// Fills the step-major normals buffer of a path block. Normals are drawn path by path, so every scheme sees the same normals
+// for a given path, and a short final block only draws for the paths it uses.
+inline void drawBlockNormals(NormalStream &stream, unsigned int numSteps, unsigned int width, double *normals) {
+    const double *drawn = stream.draw(static_cast<std::size_t>(width) * numSteps);
+    for (unsigned int k = 0; k < width; ++k) {
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            normals[j * pathBlockWidth + k] = drawn[k * numSteps + j];
+        }
+    }
+}
+
+// Instrumentation counts for numPaths paths of numSteps steps simulated in blocks, one normal drawn per step
+inline void countSimulatedPaths(unsigned int numPaths, unsigned int numSteps) {
+    INSTRUMENT_COUNT(Paths, numPaths);
+    INSTRUMENT_COUNT(Steps, static_cast<std::uint64_t>(numPaths) * numSteps);
+    INSTRUMENT_COUNT(Normals, static_cast<std::uint64_t>(numPaths) * numSteps);
+    INSTRUMENT_COUNT(Blocks, (numPaths + pathBlockWidth - 1) / pathBlockWidth);
+}
+
+// Calls addSample(payoff) with the undiscounted payoff of each of numPaths paths drawn from stream, in path order.
+// The block's normals live in the arena, which is left as it was found.
+template <typename Averaging, typename Payoff, typename Scheme, typename SampleFunction>
+void forEachSample(NormalStream &stream, PathArena &arena, unsigned int numPaths, const KernelParameters &parameters, SampleFunction addSample) {
+    ArenaScope scope(arena);
+    double *normals = arena.allocate<double>(parameters.numSteps * pathBlockWidth);
+    std::fill(normals, normals + parameters.numSteps * pathBlockWidth, 0.0); // lanes past a short block's width stay finite
+    double samples[pathBlockWidth];
+
+    for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+        unsigned int width = std::min(pathBlockWidth, numPaths - first);
+        {
+            INSTRUMENT_PHASE(RandomNumbers);
+            drawBlockNormals(stream, parameters.numSteps, width, normals);
+        }
+        Scheme::template blockSamples<Averaging, Payoff>(parameters, normals, samples);
+        INSTRUMENT_PHASE(Statistics);
+        for (unsigned int k = 0; k < width; ++k) {
+            addSample(samples[k]);
+        }
+    }
+    countSimulatedPaths(numPaths, parameters.numSteps);
+}
+
+// Statistics of the undiscounted payoffs of numPaths paths drawn from stream
+template <typename Averaging, typename Payoff, typename Scheme>
+RunningStatistics simulateChunk(NormalStream &stream, PathArena &arena, unsigned int numPaths, const KernelParameters &parameters) {
+    RunningStatistics payoffs;
+    forEachSample<Averaging, Payoff, Scheme>(stream, arena, numPaths, parameters, [&](double sample) { payoffs.add(sample); });
+    return payoffs;
+}
+
+// Statistics of the first prefixes[i] paths for every i, from one pass over max(prefixes) paths; prefixes must be increasing.
+// Each entry equals simulateChunk with that many paths, since a shorter run draws exactly the leading paths of a longer one.
+template <typename Averaging, typename Payoff, typename Scheme>
+std::vector<RunningStatistics> simulateChunkPrefixes(NormalStream &stream, PathArena &arena, const std::vector<unsigned int> &prefixes, const KernelParameters &parameters) {
+    std::vector<RunningStatistics> snapshots;
+    RunningStatistics payoffs;
+    std::size_t next = 0;
+    forEachSample<Averaging, Payoff, Scheme>(stream, arena, prefixes.empty() ? 0 : prefixes.back(), parameters, [&](double sample) {
+        payoffs.add(sample);
+        while (next < prefixes.size() && payoffs.getCount() == prefixes[next]) {
+            snapshots.push_back(payoffs);
+            ++next;
+        }
+    });
+    return snapshots;
+}
+
+// Statistics of the undiscounted payoffs of numPaths streamed paths of a step table; the averages are accumulated as fixings arrive,
+// on top of the past sums of the parameters
+template <typename Averaging, typename Payoff>
+RunningStatistics simulateChunkStreaming(NormalStream &stream, PathArena &arena, unsigned int numPaths, const StepTable &table, const KernelParameters &parameters) {
+    ArenaScope scope(arena);
+    PathStreamer streamer(table, arena);
+    RunningStatistics payoffs;
+    for (unsigned int first = 0; first < numPaths; first += pathBlockWidth) {
+        unsigned int width = std::min(pathBlockWidth, numPaths - first);
+        double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+        std::fill(sumSpot, sumSpot + pathBlockWidth, parameters.pastSum);
+        std::fill(sumLogSpot, sumLogSpot + pathBlockWidth, parameters.pastLogSum);
+        {
+            INSTRUMENT_PHASE(PathStepping); // the streamer draws each tile's normals as it goes, so they are timed here too
+            streamer.simulateBlock(stream, width, [&](unsigned int, const double *spots, const double *logSpots) {
+                for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+                    sumSpot[k] += spots[k];
+                    sumLogSpot[k] += logSpots[k];
+                }
+            });
+        }
+        INSTRUMENT_PHASE(Payoff);
+        for (unsigned int k = 0; k < width; ++k) {
+            payoffs.add(Payoff::payoff(Averaging::average(sumSpot[k], sumLogSpot[k], parameters.averagingPeriods), parameters.strike));
+        }
+    }
+    countSimulatedPaths(numPaths, table.numSteps());
+    return payoffs;
+}
+
+// Calls function(averaging, payoff) with default-constructed policies matching the contract and returns its result
+template <typename Function>
+auto withPolicies(const AsianOption &option, Function function) {
+    bool call = option.getType() == Option::Type::Call;
+    if (option.getAveragingType() == AsianOption::AveragingType::Arithmetic) {
+        return call ? function(ArithmeticAveraging(), CallPayoff()) : function(ArithmeticAveraging(), PutPayoff());
+    }
+    return call ? function(GeometricAveraging(), CallPayoff()) : function(GeometricAveraging(), PutPayoff());
+}
@@ -0,0 +1,53 @@
+#include <cmath>
+#include "PricingResult.hpp"
+
+RunningStatistics &RunningStatistics::operator+=(const RunningStatistics &other) {
+    if (other.count == 0) {
+        return *this;
+    }
+    if (count == 0) {
+        *this = other;
+        return *this;
+    }
+
+    unsigned long long total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+    count = total;
+    return *this;
+}
+
+unsigned long long RunningStatistics::getCount() const { return count; }
+
+double RunningStatistics::getMean() const { return mean; }
+
+double RunningStatistics::getVariance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+
+std::pair<double, double> PricingResult::confidenceInterval(double z) const {
+    return std::make_pair(price - z * standardError, price + z * standardError);
+}
+
+PricingResult &PricingResult::operator+=(const PricingResult &other) {
+    if (other.pathsUsed == 0) {
+        return *this;
+    }
+    if (pathsUsed == 0) {
+        *this = other;
+        return *this;
+    }
+
+    // Pool the two samples exactly as RunningStatistics merges them, working from each side's sum of squared deviations
+    double count = static_cast<double>(pathsUsed);
+    double otherCount = static_cast<double>(other.pathsUsed);
+    double total = count + otherCount;
+    double delta = other.price - price;
+    double m2 = variance * (count - 1.0) + other.variance * (otherCount - 1.0) + delta * delta * count * otherCount / total;
+
+    price += delta * otherCount / total;
+    pathsUsed += other.pathsUsed;
+    variance = pathsUsed > 1 ? m2 / (total - 1.0) : 0.0;
+    standardError = std::sqrt(variance / total);
+    wallTime += other.wallTime;
+    return *this;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// Single-pass mean and variance accumulator (Welford's algorithm). Two accumulators can be merged with Chan et al.'s
+// pairwise update, which lets each chunk of paths keep its own statistics and still combine them stably.
+class RunningStatistics {
+public:
+    // Adds one observation; defined inline because it runs once per simulated path
+    void add(double value) {
+        ++count;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    RunningStatistics &operator+=(const RunningStatistics &other); // merges another accumulator into this one
+
+    // Accessor functions for the accumulated statistics
+    unsigned long long getCount() const;
+    double getMean() const;
+    double getVariance() const; // unbiased sample variance, zero with fewer than two observations
+
+private:
+    unsigned long long count = 0;
+    double mean = 0.0;
+    double m2 = 0.0; // sum of squared deviations from the mean
+};
+
+// Outcome of a Monte Carlo pricing run
+struct PricingResult {
+    double price = 0.0;              // discounted Monte Carlo estimate
+    double variance = 0.0;           // sample variance of one discounted sample
+    double standardError = 0.0;      // sqrt(variance / pathsUsed)
+    unsigned long long pathsUsed = 0; // number of samples averaged (antithetic pairs count once)
+    double wallTime = 0.0;           // elapsed wall-clock time in seconds
+
+    // Pools another independent estimate of the same price into this one, weighting by the number of samples
+    PricingResult &operator+=(const PricingResult &other);
+
+    // Confidence interval price +/- z * standardError (1.96 gives 95%)
+    std::pair<double, double> confidenceInterval(double z = 1.96) const;
+};
+
+// Price and first/second-order sensitivities estimated from one set of paths, each with its own standard error
+struct Greeks {
+    PricingResult price;
+    PricingResult delta; // dV/dspot
+    PricingResult gamma; // d2V/dspot2
+    PricingResult vega;  // dV/dvolatility
+    PricingResult rho;   // dV/driskFreeRate
+};
+
+// First-order sensitivities from adjoint differentiation, including one per simulated fixing date
+struct AdjointGreeks {
+    PricingResult price;
+    PricingResult delta;                     // dV/dspot
+    PricingResult vega;                      // dV/dvolatility
+    PricingResult rho;                       // dV/driskFreeRate
+    PricingResult expiry;                    // dV/dexpiry through discounting, fixing dates held fixed
+    std::vector<PricingResult> fixingTimes;  // dV/dt_i for the fixing dates t_1, ..., t_{n-1} after the spot fixing
+};
+
+// Importance-sampling price, with the drift used and what plain Monte Carlo would have achieved on the same contract
+struct ImportanceSamplingResult {
+    PricingResult price;
+    std::vector<double> driftShift; // mean of the normal driving each simulated step
+    double naiveVariance = 0.0;     // per-sample variance of the plain GBM estimator, estimated from the same weighted paths
+    double varianceReduction = 0.0; // naiveVariance / price.variance: how many plain paths each importance-sampled path is worth
+};
+
+// One level of a multilevel Monte Carlo run: the correction it adds to the coarser levels' estimate
+struct MultilevelLevel {
+    unsigned int steps = 0;          // simulated steps per path, the cost model
+    unsigned long long samples = 0;
+    double mean = 0.0;               // discounted mean correction (the level's own estimate on level 0)
+    double variance = 0.0;           // per-sample variance of the discounted correction
+};
+
+// Multilevel Monte Carlo price and how it was reached
+struct MultilevelResult {
+    PricingResult price;                // standardError is the statistical error over all levels
+    std::vector<MultilevelLevel> levels;
+    double bias = 0.0;                  // estimated bias from stopping short of the contract's own schedule, on convergence or at
+                                        // maxSimulations; zero only when its level is included
+    double cost = 0.0;                  // simulated steps over all levels
+    double singleLevelCost = 0.0;       // steps plain Monte Carlo on the contract's schedule needs for the same standard error
+};
+
+// Finite-difference price and its spot sensitivities, read off the grid
+struct FiniteDifferenceResult {
+    double price = 0.0;
+    double delta = 0.0;    // dV/dspot
+    double gamma = 0.0;    // d2V/dspot2
+    double wallTime = 0.0; // elapsed wall-clock time in seconds
+};
+
+// Analytic moment-matching price with a bracket that holds the exact price
+struct MomentMatchingResult {
+    double price = 0.0;          // lognormalPrice moved into the bracket
+    double lognormalPrice = 0.0; // Levy / Turnbull-Wakeman value as it comes
+    double lowerBound = 0.0;
+    double upperBound = 0.0;
+    double errorBound = 0.0;     // largest distance from price to a point of [lowerBound, upperBound]
+};
+
+// Quote from the analytic tier, or from Monte Carlo when the analytic error bound was over the tolerance
+struct TieredResult {
+    PricingResult price;                   // the approximation has no paths and no standard error
+    MomentMatchingResult approximation;
+    bool usedMonteCarlo = false;
+};
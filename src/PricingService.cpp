@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include "PricingService.hpp"
+
+PricingService::PricingService(const PricingServiceConfig &config) : config(config) {
+    if (config.workers == 0 || config.queueCapacity == 0 || config.maxBatch == 0) {
+        throw std::invalid_argument("PricingService needs at least one worker and a non-empty queue and batch");
+    }
+    latencies.reserve(config.latencySamples);
+    for (unsigned int i = 0; i < config.workers; ++i) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+PricingService::~PricingService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<PricingResult> PricingService::submit(const AsianOption &option, const MarketData &market, unsigned int numSimulations) {
+    std::future<PricingResult> result;
+    enqueue(option, market, numSimulations, true, result);
+    return result;
+}
+
+bool PricingService::trySubmit(const AsianOption &option, const MarketData &market, unsigned int numSimulations, std::future<PricingResult> &result) {
+    return enqueue(option, market, numSimulations, false, result);
+}
+
+void PricingService::pause() {
+    std::lock_guard<std::mutex> lock(mutex);
+    paused = true;
+}
+
+void PricingService::resume() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        paused = false;
+    }
+    notEmpty.notify_all();
+}
+
+PricingServiceStatistics PricingService::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    PricingServiceStatistics snapshot = statistics;
+    snapshot.queueDepth = queue.size();
+    snapshot.inFlight = requests.size();
+
+    // Nearest-rank percentiles of the retained latencies
+    std::vector<double> sorted = latencies;
+    if (!sorted.empty()) {
+        auto percentile = [&sorted](double fraction) {
+            std::size_t rank = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+            std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+            return sorted[rank];
+        };
+        snapshot.p50Latency = percentile(0.5);
+        snapshot.p99Latency = percentile(0.99);
+    }
+    return snapshot;
+}
+
+PricingService::Key PricingService::makeKey(const AsianOption &option, const MarketData &market, unsigned int numSimulations) {
+    return std::make_tuple(option.getStrike(), option.getExpiry(), option.getType(), option.getAveragingType(), option.getFixingTimes(),
+                           option.getPastFixings(), option.getPastAverage(), market.spot, market.riskFreeRate, market.volatility, numSimulations);
+}
+
+bool PricingService::enqueue(const AsianOption &option, const MarketData &market, unsigned int numSimulations, bool wait, std::future<PricingResult> &result) {
+    Key key = makeKey(option, market, numSimulations);
+    Clock::time_point submitted = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // A twin that is queued or being priced takes the request along; otherwise it needs a place in the queue
+    auto found = requests.find(key);
+    if (found == requests.end()) {
+        if (queue.size() >= config.queueCapacity) {
+            if (!wait) {
+                ++statistics.rejected;
+                return false;
+            }
+            notFull.wait(lock, [this]() { return queue.size() < config.queueCapacity; });
+            found = requests.find(key); // a twin may have been queued while this one waited
+        }
+    }
+    if (found == requests.end()) {
+        found = requests.emplace(std::move(key), Request{option, market, numSimulations, {}}).first;
+        queue.push_back(&*found);
+        notEmpty.notify_one();
+    } else {
+        ++statistics.coalesced;
+    }
+
+    std::promise<PricingResult> promise;
+    result = promise.get_future();
+    found->second.waiters.emplace_back(std::move(promise), submitted);
+    ++statistics.submitted;
+    return true;
+}
+
+void PricingService::workerLoop() {
+    for (;;) {
+        std::vector<Entry *> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this]() { return stopping || (!paused && !queue.empty()); });
+            if (queue.empty()) {
+                return;
+            }
+            std::size_t count = std::min(queue.size(), config.maxBatch);
+            batch.assign(queue.begin(), queue.begin() + count);
+            queue.erase(queue.begin(), queue.begin() + count);
+        }
+        notFull.notify_all();
+        priceBatch(batch);
+    }
+}
+
+void PricingService::priceBatch(const std::vector<Entry *> &batch) {
+    // The engine prices one path count per call. A request's contract and market are not modified once it is queued, so they are
+    // read here without the lock; only its list of waiters grows, under the lock.
+    std::map<unsigned int, std::vector<Entry *>> byPathCount;
+    for (Entry *entry : batch) {
+        byPathCount[entry->second.numSimulations].push_back(entry);
+    }
+
+    for (const auto &group : byPathCount) {
+        std::vector<AsianOption> options;
+        std::vector<MarketData> markets;
+        options.reserve(group.second.size());
+        markets.reserve(group.second.size());
+        for (const Entry *entry : group.second) {
+            options.push_back(entry->second.option);
+            markets.push_back(entry->second.market);
+        }
+
+        // If the batch throws, each request is priced on its own so that only the offending ones fail
+        std::vector<PricingResult> results(options.size());
+        std::vector<std::exception_ptr> failures(options.size());
+        try {
+            results = PricingEngine::calculatePricesBatch(options, markets, group.first, config.simulation);
+        } catch (...) {
+            for (std::size_t r = 0; r < options.size(); ++r) {
+                try {
+                    results[r] = PricingEngine::calculatePricesBatch({options[r]}, {markets[r]}, group.first, config.simulation).front();
+                } catch (...) {
+                    failures[r] = std::current_exception();
+                }
+            }
+        }
+
+        // Take the waiters and retire the requests under the lock, so a twin submitted from now on starts afresh; fulfil them outside it
+        std::vector<std::pair<std::promise<PricingResult>, Clock::time_point>> waiters;
+        std::vector<std::size_t> firstWaiter;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Clock::time_point now = Clock::now();
+            for (Entry *entry : group.second) {
+                firstWaiter.push_back(waiters.size());
+                for (auto &waiter : entry->second.waiters) {
+                    double latency = std::chrono::duration<double>(now - waiter.second).count();
+                    if (latencies.size() < config.latencySamples) {
+                        latencies.push_back(latency);
+                    } else if (!latencies.empty()) {
+                        latencies[nextLatency] = latency;
+                        nextLatency = (nextLatency + 1) % latencies.size();
+                    }
+                    waiters.push_back(std::move(waiter));
+                }
+                statistics.completed += entry->second.waiters.size();
+                requests.erase(requests.find(entry->first));
+            }
+            ++statistics.batches;
+        }
+        firstWaiter.push_back(waiters.size());
+        for (std::size_t r = 0; r < group.second.size(); ++r) {
+            for (std::size_t w = firstWaiter[r]; w < firstWaiter[r + 1]; ++w) {
+                if (failures[r]) {
+                    waiters[w].first.set_exception(failures[r]);
+                } else {
+                    waiters[w].first.set_value(results[r]);
+                }
+            }
+        }
+    }
+}
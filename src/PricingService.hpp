@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingEngine.hpp"
+
+// Asynchronous front end to the GBM engine for callers on many threads. Requests wait in a bounded queue for a fixed set of workers;
+// a worker takes every queued request at once (up to maxBatch) and prices them with calculatePricesBatch, so contracts on the same
+// market, schedule and path count share one set of simulated averages. A request identical to one already queued or being priced is
+// not queued again but attached to it, and every attached future receives the same result. Because each batch result equals
+// calculatePriceGBM with the same configuration, a request's price does not depend on what it was coalesced with.
+
+struct PricingServiceConfig {
+    unsigned int workers = 2;          // threads taking batches off the queue
+    std::size_t queueCapacity = 1024;  // distinct requests waiting for a worker; submit blocks and trySubmit fails while it is full
+    std::size_t maxBatch = 256;        // requests a worker takes at once
+    SimulationConfig simulation;       // seed, generator and threads of every simulation
+    std::size_t latencySamples = 8192; // most recent request latencies kept for the percentiles
+};
+
+// Counters since construction, and the queue as it stands
+struct PricingServiceStatistics {
+    std::size_t queueDepth = 0;       // distinct requests waiting for a worker
+    std::size_t inFlight = 0;         // distinct requests queued or being priced
+    unsigned long long submitted = 0; // accepted requests, coalesced ones included
+    unsigned long long completed = 0;
+    unsigned long long coalesced = 0; // requests attached to an identical one instead of being queued
+    unsigned long long rejected = 0;  // trySubmit calls refused by a full queue
+    unsigned long long batches = 0;   // calculatePricesBatch calls
+    double p50Latency = 0.0;          // seconds from submission to result, over the most recent completed requests
+    double p99Latency = 0.0;
+};
+
+class PricingService {
+public:
+    // Starts the workers; throws std::invalid_argument if there are none or the queue or batch size is zero
+    explicit PricingService(const PricingServiceConfig &config = PricingServiceConfig());
+    PricingService(const PricingService &) = delete;
+    PricingService &operator=(const PricingService &) = delete;
+
+    // Prices every accepted request, then joins the workers
+    ~PricingService();
+
+    // Queues a request, waiting while the queue is full, and returns a future for its price. An exception from the engine is
+    // delivered through the future.
+    std::future<PricingResult> submit(const AsianOption &option, const MarketData &market, unsigned int numSimulations);
+
+    // As submit, but refuses at once when the queue is full: returns false and leaves result untouched
+    bool trySubmit(const AsianOption &option, const MarketData &market, unsigned int numSimulations, std::future<PricingResult> &result);
+
+    // Holds the workers once they finish their current batch: requests keep queueing and coalescing, up to the queue capacity, until
+    // resume. Destruction still prices every accepted request.
+    void pause();
+    void resume();
+
+    PricingServiceStatistics getStatistics() const;
+
+private:
+    using Key = std::tuple<double, double, Option::Type, AsianOption::AveragingType, std::vector<double>, unsigned int, double, double, double, double,
+                           unsigned int>;
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        AsianOption option;
+        MarketData market;
+        unsigned int numSimulations;
+        std::vector<std::pair<std::promise<PricingResult>, Clock::time_point>> waiters;
+    };
+
+    using Entry = std::map<Key, Request>::value_type;
+
+    static Key makeKey(const AsianOption &option, const MarketData &market, unsigned int numSimulations);
+    bool enqueue(const AsianOption &option, const MarketData &market, unsigned int numSimulations, bool wait, std::future<PricingResult> &result);
+    void workerLoop();
+    void priceBatch(const std::vector<Entry *> &batch);
+
+    PricingServiceConfig config;
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::map<Key, Request> requests;  // in flight; map nodes stay put, so the queue and workers hold pointers to the entries
+    std::deque<Entry *> queue;
+    std::vector<double> latencies;    // ring buffer of the latest latencies
+    std::size_t nextLatency = 0;
+    PricingServiceStatistics statistics;
+    bool paused = false;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "RandomStream.hpp"
+
+// Build one clone per instruction set where the toolchain supports it, as for the path kernel
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define RANDOM_STREAM_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef RANDOM_STREAM_TARGETS
+#define RANDOM_STREAM_TARGETS
+#endif
+
+namespace {
+
+const std::uint32_t philoxMultiplier0 = 0xD2511F53;
+const std::uint32_t philoxMultiplier1 = 0xCD9E8D57;
+const std::uint32_t philoxWeyl0 = 0x9E3779B9;
+const std::uint32_t philoxWeyl1 = 0xBB67AE85;
+
+inline void philoxRounds(std::uint32_t counter[4], std::uint32_t key0, std::uint32_t key1) {
+    for (int round = 0; round < 10; ++round) {
+        std::uint64_t product0 = static_cast<std::uint64_t>(philoxMultiplier0) * counter[0];
+        std::uint64_t product1 = static_cast<std::uint64_t>(philoxMultiplier1) * counter[2];
+        std::uint32_t next0 = static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key0;
+        std::uint32_t next2 = static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key1;
+        counter[1] = static_cast<std::uint32_t>(product1);
+        counter[3] = static_cast<std::uint32_t>(product0);
+        counter[0] = next0;
+        counter[2] = next2;
+        key0 += philoxWeyl0;
+        key1 += philoxWeyl1;
+    }
+}
+
+// The top 52 bits of two words as the mantissa of a double in [1, 2), shifted down to (m + 1/2) 2^-52 in (0, 1): never 0 or 1, symmetric
+// about 1/2, and exact. Building the double from its bits avoids the 64-bit integer conversion that AVX2 and AVX-512F lack.
+inline double toUniform(std::uint32_t high, std::uint32_t low) {
+    std::uint64_t bits = 0x3FF0000000000000ULL | ((static_cast<std::uint64_t>(high) << 32 | low) >> 12);
+    double oneToTwo;
+    std::memcpy(&oneToTwo, &bits, sizeof(bits));
+    return oneToTwo - (1.0 - 0x1.0p-53);
+}
+
+// AS241 central region, |p - 1/2| <= 0.425
+inline double centralInverse(double q) {
+    double r = 0.180625 - q * q;
+    return q * (((((((2509.0809287301226727 * r + 33430.575583588128105) * r + 67265.770927008700853) * r + 45921.953931549871457) * r
+                  + 13731.693765509461125) * r + 1971.5909503065514427) * r + 133.14166789178437745) * r + 3.387132872796366608)
+           / (((((((5226.495278852545925 * r + 28729.085735721942674) * r + 39307.89580009271061) * r + 21213.794301586595867) * r
+                 + 5394.1960214247511077) * r + 687.1870074920579083) * r + 42.313330701600911252) * r + 1.0);
+}
+
+// AS241 tails, |p - 1/2| > 0.425
+double tailInverse(double p) {
+    double q = p - 0.5;
+    double r = std::sqrt(-std::log(q < 0.0 ? p : 1.0 - p));
+    double value;
+    if (r <= 5.0) {
+        r -= 1.6;
+        value = (((((((7.7454501427834140764e-4 * r + 0.0227238449892691845833) * r + 0.24178072517745061177) * r + 1.27045825245236838258) * r
+                    + 3.64784832476320460504) * r + 5.7694972214606914055) * r + 4.6303378461565452959) * r + 1.42343711074968357734)
+                / (((((((1.05075007164441684324e-9 * r + 5.475938084995344946e-4) * r + 0.0151986665636164571966) * r + 0.14810397642748007459) * r
+                      + 0.68976733498510000455) * r + 1.6763848301838038494) * r + 2.05319162663775882187) * r + 1.0);
+    } else {
+        r -= 5.0;
+        value = (((((((2.01033439929228813265e-7 * r + 2.71155556874348757815e-5) * r + 0.0012426609473880784386) * r + 0.026532189526576123093) * r
+                    + 0.29656057182850489123) * r + 1.7848265399172913358) * r + 5.4637849111641143699) * r + 6.6579046435011037772)
+                / (((((((2.04426310338993978564e-15 * r + 1.4215117583164458887e-7) * r + 1.8463183175100546818e-5) * r + 7.868691311456132591e-4) * r
+                      + 0.0148753612908506148525) * r + 0.13692988092273580531) * r + 0.59983220655588793769) * r + 1.0);
+    }
+    return q < 0.0 ? -value : value;
+}
+
+// std::seed_seq over at most four words, without its heap-allocated copy of them: generate() is the algorithm the standard
+// specifies for std::seed_seq, so mt19937 seeded from it is in exactly the same state
+class SeedSequence {
+public:
+    using result_type = std::uint32_t;
+
+    SeedSequence(const std::uint32_t *words, std::size_t size) : size(size) {
+        std::copy(words, words + size, this->words);
+    }
+
+    template <typename Iterator>
+    void generate(Iterator begin, Iterator end) const {
+        const std::size_t n = static_cast<std::size_t>(end - begin);
+        if (n == 0) {
+            return;
+        }
+        std::fill(begin, end, 0x8b8b8b8bu);
+        auto mix = [](std::uint32_t x) { return x ^ (x >> 27); };
+        auto at = [&](std::size_t k) -> std::uint32_t { return static_cast<std::uint32_t>(begin[k % n]); };
+        auto set = [&](std::size_t k, std::uint32_t x) { begin[k % n] = x; };
+
+        const std::size_t t = n >= 623 ? 11 : n >= 68 ? 7 : n >= 39 ? 5 : n >= 7 ? 3 : (n - 1) / 2;
+        const std::size_t p = (n - t) / 2;
+        const std::size_t q = p + t;
+        const std::size_t m = std::max(size + 1, n);
+
+        for (std::size_t k = 0; k < m; ++k) {
+            std::uint32_t r1 = 1664525u * mix(at(k) ^ at(k + p) ^ at(k + n - 1));
+            std::uint32_t r2 = r1 + static_cast<std::uint32_t>(k == 0 ? size : k <= size ? k % n + words[k - 1] : k % n);
+            set(k + p, at(k + p) + r1);
+            set(k + q, at(k + q) + r2);
+            set(k, r2);
+        }
+        for (std::size_t k = m; k < m + n; ++k) {
+            std::uint32_t r3 = 1566083941u * mix(at(k) + at(k + p) + at(k + n - 1));
+            std::uint32_t r4 = r3 - static_cast<std::uint32_t>(k % n);
+            set(k + p, at(k + p) ^ r3);
+            set(k + q, at(k + q) ^ r4);
+            set(k, r4);
+        }
+    }
+
+private:
+    std::uint32_t words[4];
+    std::size_t size;
+};
+
+} // namespace
+
+Philox4x32::Philox4x32(std::uint64_t seed, std::uint64_t stream)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          streamWords{static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)} {}
+
+void Philox4x32::block(std::uint64_t index, std::uint32_t output[4]) const {
+    output[0] = static_cast<std::uint32_t>(index);
+    output[1] = static_cast<std::uint32_t>(index >> 32);
+    output[2] = streamWords[0];
+    output[3] = streamWords[1];
+    philoxRounds(output, key[0], key[1]);
+}
+
+RANDOM_STREAM_TARGETS
+void Philox4x32::uniforms(std::uint64_t firstBlock, std::size_t numBlocks, double *output) const {
+    const std::uint32_t key0 = key[0], key1 = key[1], stream0 = streamWords[0], stream1 = streamWords[1];
+    for (std::size_t i = 0; i < numBlocks; ++i) {
+        std::uint64_t index = firstBlock + i;
+        std::uint32_t counter[4] = {static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32), stream0, stream1};
+        philoxRounds(counter, key0, key1);
+        output[2 * i] = toUniform(counter[0], counter[1]);
+        output[2 * i + 1] = toUniform(counter[2], counter[3]);
+    }
+}
+
+RANDOM_STREAM_TARGETS
+void inverseNormalCdfBuffer(const double *uniforms, double *normals, std::size_t count) {
+    // Every value goes through the central rational; the result is then overwritten for the tail inputs
+    std::size_t numTails = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        double q = uniforms[i] - 0.5;
+        numTails += std::fabs(q) > 0.425;
+        normals[i] = centralInverse(q);
+    }
+    if (numTails == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::fabs(uniforms[i] - 0.5) > 0.425) {
+            normals[i] = tailInverse(uniforms[i]);
+        }
+    }
+}
+
+NormalStream::NormalStream(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream)
+        : generator(generator), philox(seed, stream), normal(0.0, 1.0) {
+    restart(generator, seed, stream);
+}
+
+void NormalStream::restart(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream) {
+    this->generator = generator;
+    philox = Philox4x32(seed, stream);
+    position = 0;
+    normal.reset();
+    if (generator == RandomGenerator::MersenneTwister) {
+        // Streams below 2^32 are seeded exactly as the engines seeded mt19937 before the stream layer existed
+        std::uint32_t words[4] = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), static_cast<std::uint32_t>(stream),
+                                  static_cast<std::uint32_t>(stream >> 32)};
+        SeedSequence sequence(words, stream >> 32 ? 4 : 3);
+        mersenne.seed(sequence);
+    }
+}
+
+void NormalStream::fill(double *output, std::size_t count) {
+    if (generator == RandomGenerator::MersenneTwister) {
+        for (std::size_t i = 0; i < count; ++i) {
+            output[i] = normal(mersenne);
+        }
+        position += count;
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // Uniforms for positions [position, position + count), generated in whole blocks; a block split between two calls is computed by both
+    std::uint64_t firstBlock = position / 2;
+    std::size_t offset = static_cast<std::size_t>(position % 2);
+    std::size_t numBlocks = (offset + count + 1) / 2;
+    uniformBuffer.resize(2 * numBlocks);
+    philox.uniforms(firstBlock, numBlocks, uniformBuffer.data());
+    inverseNormalCdfBuffer(uniformBuffer.data() + offset, output, count);
+    position += count;
+}
+
+const double *NormalStream::draw(std::size_t count) {
+    buffer.resize(count);
+    fill(buffer.data(), count);
+    return buffer.data();
+}
+
+bool NormalStream::seekable() const {
+    return generator == RandomGenerator::Philox;
+}
+
+std::uint64_t NormalStream::tell() const {
+    return position;
+}
+
+void NormalStream::seek(std::uint64_t newPosition) {
+    if (!seekable()) {
+        throw std::logic_error("only Philox normal streams can seek");
+    }
+    position = newPosition;
+}
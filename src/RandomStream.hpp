@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Source of the uniform bits behind a stream of normals
+enum class RandomGenerator {
+    Philox,          // counter-based Philox4x32-10 with a vectorised inverse-CDF transform (the default)
+    MersenneTwister  // std::mt19937 with std::normal_distribution, as the engines used originally
+};
+
+// Philox4x32-10 (Salmon, Moraes, Dror and Shaw, 2011): ten rounds of a keyed bijection on a 128-bit counter. Block i of a stream is a
+// pure function of (key, counter), so any position can be generated directly, streams need no state beyond a position, and a loop
+// over consecutive blocks has no dependency between iterations and vectorises.
+class Philox4x32 {
+public:
+    Philox4x32(std::uint64_t seed, std::uint64_t stream);
+
+    // The four 32-bit outputs of block number index of this stream
+    void block(std::uint64_t index, std::uint32_t output[4]) const;
+
+    // Writes 2 * numBlocks uniforms in (0, 1) with 52 random bits each, from blocks firstBlock, firstBlock + 1, ...;
+    // block i gives output[2i] from its first two words and output[2i + 1] from its last two
+    void uniforms(std::uint64_t firstBlock, std::size_t numBlocks, double *output) const;
+
+private:
+    std::uint32_t key[2];
+    std::uint32_t streamWords[2]; // high half of the counter; the low half is the block index
+};
+
+// normals[i] = inverse standard normal CDF of uniforms[i] in (0, 1), for count values: Wichura's AS241 (PPND16), accurate to about 1e-16.
+// The central rational, which covers 85% of inputs, runs as one branch-free vectorised pass; tail inputs are then redone one by one.
+void inverseNormalCdfBuffer(const double *uniforms, double *normals, std::size_t count);
+
+// One stream of standard normals, identified by (seed, stream). Normals are produced in whole buffers. The same (generator, seed, stream)
+// and the same sequence of calls give bit-identical normals; with Philox, splitting the draws differently gives the same normals up to
+// the last bit or so, since elements can land in the vectorised or the scalar remainder of the transform.
+class NormalStream {
+public:
+    NormalStream(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream);
+
+    // Starts over as the stream (generator, seed, stream), exactly as if newly constructed, but keeps the buffers it has already
+    // grown, so a reused stream does not allocate
+    void restart(RandomGenerator generator, std::uint64_t seed, std::uint64_t stream);
+
+    // Writes the next count normals of the stream
+    void fill(double *output, std::size_t count);
+
+    // The next count normals, in a buffer owned by the stream that stays valid until the next call
+    const double *draw(std::size_t count);
+
+    // Whether the stream can jump to any position (Philox); a Mersenne Twister stream can only be read in order
+    bool seekable() const;
+
+    // Number of normals drawn so far, and a jump to the given position; seek throws std::logic_error on a stream that is not seekable
+    std::uint64_t tell() const;
+    void seek(std::uint64_t newPosition);
+
+private:
+    RandomGenerator generator;
+    Philox4x32 philox;
+    std::uint64_t position = 0; // normals drawn so far; each Philox block gives two
+    std::mt19937 mersenne;
+    std::normal_distribution<double> normal;
+    std::vector<double> uniformBuffer;
+    std::vector<double> buffer;
+};
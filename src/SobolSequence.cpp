@@ -0,0 +1,109 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "SobolSequence.hpp"
+#include "SobolDirectionNumbers.hpp"
+
+SobolSequence::SobolSequence(unsigned int dimension)
+        : dimension(dimension), directions(dimension * numBits), shift(dimension, 0), state(dimension, 0), index(0) {
+    if (dimension == 0) {
+        throw std::invalid_argument("SobolSequence requires a positive dimension");
+    }
+    if (dimension > maxDimension) {
+        throw std::invalid_argument("SobolSequence supports at most " + std::to_string(maxDimension) + " dimensions");
+    }
+
+    // Dimension 1: v_k = 2^-k
+    for (unsigned int k = 0; k < numBits; ++k) {
+        directions[k] = std::uint32_t(1) << (numBits - 1 - k);
+    }
+
+    const std::uint16_t *row = sobol_directions::table;
+    for (unsigned int d = 1; d < dimension; ++d) {
+        unsigned int degree = row[0];
+        unsigned int coefficients = row[1];
+        const std::uint16_t *initial = row + 2;
+        row += 2 + degree;
+        std::uint32_t *v = &directions[d * numBits];
+
+        // Initial direction numbers v_k = m_k / 2^k
+        for (unsigned int k = 0; k < degree; ++k) {
+            v[k] = static_cast<std::uint32_t>(initial[k]) << (numBits - 1 - k);
+        }
+
+        // Sobol recurrence: v_k = a_1 v_{k-1} ^ ... ^ a_{s-1} v_{k-s+1} ^ v_{k-s} ^ (v_{k-s} >> s)
+        for (unsigned int k = degree; k < numBits; ++k) {
+            std::uint32_t value = v[k - degree] ^ (v[k - degree] >> degree);
+            for (unsigned int i = 1; i < degree; ++i) {
+                if ((coefficients >> (degree - 1 - i)) & 1) {
+                    value ^= v[k - i];
+                }
+            }
+            v[k] = value;
+        }
+    }
+}
+
+SobolSequence::SobolSequence(unsigned int dimension, std::uint64_t scrambleSeed)
+        : SobolSequence(dimension) {
+    std::mt19937_64 gen(scrambleSeed);
+
+    for (unsigned int d = 0; d < dimension; ++d) {
+        // Random lower-triangular matrix with unit diagonal: output bit i (from the most significant) mixes input bits 0..i
+        std::uint32_t rows[numBits];
+        for (unsigned int i = 0; i < numBits; ++i) {
+            std::uint32_t diagonal = std::uint32_t(1) << (numBits - 1 - i);
+            std::uint32_t above = i == 0 ? 0 : static_cast<std::uint32_t>(gen()) & ~((diagonal << 1) - 1);
+            rows[i] = diagonal | above;
+        }
+
+        std::uint32_t *v = &directions[d * numBits];
+        for (unsigned int k = 0; k < numBits; ++k) {
+            std::uint32_t scrambled = 0;
+            for (unsigned int i = 0; i < numBits; ++i) {
+                scrambled |= static_cast<std::uint32_t>(__builtin_parity(rows[i] & v[k])) << (numBits - 1 - i);
+            }
+            v[k] = scrambled;
+        }
+        shift[d] = static_cast<std::uint32_t>(gen());
+    }
+}
+
+void SobolSequence::skipTo(std::uint64_t newIndex) {
+    // In Gray-code order point n is the XOR of the direction numbers selected by the bits of gray(n) = n ^ (n >> 1)
+    std::uint64_t gray = newIndex ^ (newIndex >> 1);
+    for (unsigned int d = 0; d < dimension; ++d) {
+        std::uint32_t value = 0;
+        for (unsigned int k = 0; k < numBits && (gray >> k); ++k) {
+            if ((gray >> k) & 1) {
+                value ^= directions[d * numBits + k];
+            }
+        }
+        state[d] = value;
+    }
+    index = newIndex;
+}
+
+void SobolSequence::next(double *point) {
+    // Centre each coordinate in its 2^-32 cell so it never equals 0 or 1
+    for (unsigned int d = 0; d < dimension; ++d) {
+        point[d] = ((state[d] ^ shift[d]) + 0.5) / 4294967296.0;
+    }
+
+    // Advance: flip the direction number of the lowest zero bit of the current index
+    unsigned int bit = 0;
+    while ((index >> bit) & 1) {
+        ++bit;
+    }
+    if (bit >= numBits) {
+        throw std::out_of_range("SobolSequence exhausted");
+    }
+    for (unsigned int d = 0; d < dimension; ++d) {
+        state[d] ^= directions[d * numBits + bit];
+    }
+    ++index;
+}
+
+unsigned int SobolSequence::getDimension() const {
+    return dimension;
+}
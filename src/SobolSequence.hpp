@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Sobol low-discrepancy sequence in [0, 1)^dimension, generated in Gray-code order with 32-bit direction numbers.
+// Dimension 1 is the van der Corput sequence; dimensions 2 to maxDimension use the primitive polynomials and initial direction numbers
+// of Joe and Kuo (new-joe-kuo-6.21201), chosen for good two-dimensional projections. The scrambled form applies a random
+// lower-triangular (Matousek) linear scramble and a random digital shift per dimension, which keeps the net structure while making
+// every point uniformly distributed.
+class SobolSequence {
+public:
+    static const unsigned int maxDimension = 1111; // dimensions with tabulated direction numbers; larger ones are rejected
+
+    explicit SobolSequence(unsigned int dimension); // unscrambled sequence
+    SobolSequence(unsigned int dimension, std::uint64_t scrambleSeed); // randomised (scrambled) sequence
+
+    // Positions the sequence so that the next call to next() returns the point with the given index
+    void skipTo(std::uint64_t index);
+
+    // Writes the current point to point[0 .. dimension) and advances; coordinates lie strictly inside (0, 1)
+    void next(double *point);
+
+    unsigned int getDimension() const;
+
+private:
+    static const unsigned int numBits = 32;
+
+    unsigned int dimension;
+    std::vector<std::uint32_t> directions; // directions[d * numBits + k] is direction number k of dimension d
+    std::vector<std::uint32_t> shift;      // digital shift applied to every output coordinate
+    std::vector<std::uint32_t> state;      // current integer point before the shift
+    std::uint64_t index;                   // index of the point held in state
+};
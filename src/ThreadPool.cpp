@@ -0,0 +1,92 @@
+#include <algorithm>
+#include "ThreadPool.hpp"
+
+namespace {
+
+// The pool and queue index of the calling thread, when it is a worker
+thread_local const void *currentPool = nullptr;
+thread_local unsigned int currentIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+    unsigned int workers = std::max(numThreads, 1u);
+    for (unsigned int i = 0; i < workers; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned int i = 0; i < workers; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+unsigned int ThreadPool::size() const {
+    return static_cast<unsigned int>(threads.size());
+}
+
+void ThreadPool::push(std::function<void()> task) {
+    unsigned int index = currentPool == this ? currentIndex : nextQueue++ % size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++pending;
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::popLocal(unsigned int index, std::function<void()> &task) {
+    WorkerQueue &queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned int index, std::function<void()> &task) {
+    for (unsigned int offset = 1; offset < size(); ++offset) {
+        WorkerQueue &queue = *queues[(index + offset) % size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned int index) {
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (popLocal(index, task) || steal(index, task)) {
+            --pending;
+            task(); // a packaged_task stores any exception in its future
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this]() { return stopping || pending > 0; });
+        if (stopping && pending == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads with one task deque each. A worker takes its own newest task first and, when its deque is empty,
+// steals the oldest task of another worker, so uneven grid points keep every thread busy. Tasks submitted from a worker go to
+// that worker's deque; other submissions are spread round-robin. The destructor runs every queued task before joining.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int numThreads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Queues function() and returns a future for its result (or exception)
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        std::future<Result> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+    unsigned int size() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void push(std::function<void()> task);
+    bool popLocal(unsigned int index, std::function<void()> &task);
+    bool steal(unsigned int index, std::function<void()> &task);
+    void workerLoop(unsigned int index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> pending{0}; // queued tasks not yet taken by a worker
+    std::atomic<unsigned int> nextQueue{0};
+    bool stopping = false;
+};
+
+// Evaluates function(point) for every point of a parameter grid on the pool and returns the results in the order of the points.
+// If any evaluation throws, every other one is still waited for and the first exception in grid order is rethrown.
+template <typename Point, typename Function>
+auto runSweep(ThreadPool &pool, const std::vector<Point> &points, Function function) -> std::vector<decltype(function(points.front()))> {
+    using Result = decltype(function(points.front()));
+    std::vector<std::future<Result>> futures;
+    futures.reserve(points.size());
+    for (const Point &point : points) {
+        futures.push_back(pool.submit([&function, &point]() { return function(point); }));
+    }
+
+    for (std::future<Result> &future : futures) {
+        future.wait();
+    }
+    std::vector<Result> results;
+    results.reserve(points.size());
+    for (std::future<Result> &future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include "TradeFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRADE_FILE_MMAP 1
+#endif
+
+namespace {
+
+// Binary header: magic, format version and record size, so a file written with another layout is rejected rather than misread
+const char binaryMagic[8] = {'A', 'S', 'N', 'T', 'R', 'A', 'D', 'E'};
+const std::uint32_t binaryVersion = 1;
+const std::size_t binaryHeaderBytes = 16;
+
+const char *const csvHeader = "id,type,averaging,strike,expiry,periods,spot,rate,volatility";
+const std::size_t csvColumns = 9;
+
+std::string trim(const std::string &text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::vector<std::string> splitFields(const std::string &line) {
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    while (true) {
+        std::size_t comma = line.find(',', start);
+        fields.push_back(trim(line.substr(start, comma - start)));
+        if (comma == std::string::npos) {
+            return fields;
+        }
+        start = comma + 1;
+    }
+}
+
+double parseDouble(const std::string &field, const char *name) {
+    char *end = nullptr;
+    errno = 0;
+    double value = std::strtod(field.c_str(), &end);
+    if (field.empty() || *end != '\0' || errno == ERANGE) {
+        throw std::invalid_argument(std::string("invalid ") + name + " '" + field + "'");
+    }
+    return value;
+}
+
+unsigned long long parseUnsigned(const std::string &field, const char *name, unsigned long long maximum) {
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(field.c_str(), &end, 10);
+    if (field.empty() || field[0] == '-' || *end != '\0' || errno == ERANGE || value > maximum) {
+        throw std::invalid_argument(std::string("invalid ") + name + " '" + field + "'");
+    }
+    return value;
+}
+
+TradeRecord parseTrade(const std::vector<std::string> &fields) {
+    if (fields.size() != csvColumns) {
+        throw std::invalid_argument("expected " + std::to_string(csvColumns) + " fields, found " + std::to_string(fields.size()));
+    }
+    TradeRecord trade{};
+    trade.id = parseUnsigned(fields[0], "id", UINT64_MAX);
+
+    std::string type = lowercase(fields[1]);
+    if (type != "call" && type != "put") {
+        throw std::invalid_argument("invalid type '" + fields[1] + "', expected call or put");
+    }
+    trade.type = type == "call" ? 0 : 1;
+
+    std::string averaging = lowercase(fields[2]);
+    if (averaging != "arithmetic" && averaging != "geometric") {
+        throw std::invalid_argument("invalid averaging '" + fields[2] + "', expected arithmetic or geometric");
+    }
+    trade.averaging = averaging == "arithmetic" ? 0 : 1;
+
+    trade.strike = parseDouble(fields[3], "strike");
+    trade.expiry = parseDouble(fields[4], "expiry");
+    trade.averagingPeriods = static_cast<std::uint32_t>(parseUnsigned(fields[5], "periods", UINT32_MAX));
+    trade.spot = parseDouble(fields[6], "spot");
+    trade.riskFreeRate = parseDouble(fields[7], "rate");
+    trade.volatility = parseDouble(fields[8], "volatility");
+    return trade;
+}
+
+} // namespace
+
+AsianOption TradeRecord::option() const {
+    return AsianOption(strike, expiry, type == 0 ? Option::Type::Call : Option::Type::Put,
+                       averaging == 0 ? AsianOption::AveragingType::Arithmetic : AsianOption::AveragingType::Geometric, averagingPeriods);
+}
+
+MarketData TradeRecord::marketData() const {
+    return MarketData{spot, riskFreeRate, volatility};
+}
+
+void checkTrade(const TradeRecord &trade) {
+    if (!(trade.strike >= 0.0) || !std::isfinite(trade.strike)) {
+        throw std::invalid_argument("strike must be non-negative");
+    }
+    if (!(trade.expiry > 0.0) || !std::isfinite(trade.expiry)) {
+        throw std::invalid_argument("expiry must be positive");
+    }
+    if (trade.averagingPeriods == 0) {
+        throw std::invalid_argument("periods must be positive");
+    }
+    if (!(trade.spot > 0.0) || !std::isfinite(trade.spot)) {
+        throw std::invalid_argument("spot must be positive");
+    }
+    if (!std::isfinite(trade.riskFreeRate)) {
+        throw std::invalid_argument("rate must be finite");
+    }
+    if (!(trade.volatility > 0.0) || !std::isfinite(trade.volatility)) {
+        throw std::invalid_argument("volatility must be positive");
+    }
+    if (trade.type > 1 || trade.averaging > 1) {
+        throw std::invalid_argument("unknown type or averaging code");
+    }
+}
+
+CsvTradeReader::CsvTradeReader(std::istream &input) : input(&input) {
+    readHeader();
+}
+
+CsvTradeReader::CsvTradeReader(const std::string &path) : file(path), input(&file) {
+    if (!file) {
+        throw std::runtime_error("cannot open trade file " + path);
+    }
+    readHeader();
+}
+
+void CsvTradeReader::readHeader() {
+    while (std::getline(*input, line)) {
+        ++lineNumber;
+        std::string header = lowercase(trim(line));
+        if (header.empty()) {
+            continue;
+        }
+        header.erase(std::remove(header.begin(), header.end(), ' '), header.end());
+        if (header != csvHeader) {
+            throw std::invalid_argument("trade file line " + std::to_string(lineNumber) + ": expected the header " + csvHeader);
+        }
+        return;
+    }
+    throw std::invalid_argument("trade file is empty");
+}
+
+std::size_t CsvTradeReader::read(std::vector<TradeRecord> &trades, std::size_t maxTrades) {
+    trades.clear();
+    while (trades.size() < maxTrades && std::getline(*input, line)) {
+        ++lineNumber;
+        if (trim(line).empty()) {
+            continue;
+        }
+        try {
+            TradeRecord trade = parseTrade(splitFields(line));
+            checkTrade(trade);
+            trades.push_back(trade);
+        } catch (const std::invalid_argument &error) {
+            throw std::invalid_argument("trade file line " + std::to_string(lineNumber) + ": " + error.what());
+        }
+    }
+    return trades.size();
+}
+
+#ifdef TRADE_FILE_MMAP
+
+BinaryTradeReader::BinaryTradeReader(const std::string &path) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("cannot open trade file " + path);
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < binaryHeaderBytes) {
+        ::close(descriptor);
+        throw std::runtime_error(path + " is not a binary trade file");
+    }
+    bytes = static_cast<std::size_t>(status.st_size);
+    void *mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("cannot map trade file " + path);
+    }
+    ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+    data = static_cast<const unsigned char *>(mapping);
+
+    std::uint32_t version, recordBytes;
+    std::memcpy(&version, data + 8, sizeof(version));
+    std::memcpy(&recordBytes, data + 12, sizeof(recordBytes));
+    if (std::memcmp(data, binaryMagic, sizeof(binaryMagic)) != 0 || version != binaryVersion || recordBytes != sizeof(TradeRecord)
+        || (bytes - binaryHeaderBytes) % sizeof(TradeRecord) != 0) {
+        ::munmap(mapping, bytes);
+        throw std::runtime_error(path + " is not a binary trade file of this version");
+    }
+    numTrades = (bytes - binaryHeaderBytes) / sizeof(TradeRecord);
+}
+
+BinaryTradeReader::~BinaryTradeReader() {
+    ::munmap(const_cast<unsigned char *>(data), bytes);
+}
+
+#else
+
+BinaryTradeReader::BinaryTradeReader(const std::string &path) {
+    throw std::runtime_error("binary trade files need memory mapping, which is not available on this platform: " + path);
+}
+
+BinaryTradeReader::~BinaryTradeReader() = default;
+
+#endif
+
+std::size_t BinaryTradeReader::read(std::vector<TradeRecord> &trades, std::size_t maxTrades) {
+    std::size_t count = std::min(maxTrades, numTrades - next);
+    trades.resize(count);
+    if (count > 0) {
+        std::memcpy(trades.data(), data + binaryHeaderBytes + next * sizeof(TradeRecord), count * sizeof(TradeRecord));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        try {
+            checkTrade(trades[i]);
+        } catch (const std::invalid_argument &error) {
+            throw std::invalid_argument("trade " + std::to_string(next + i) + " (id " + std::to_string(trades[i].id) + "): " + error.what());
+        }
+    }
+    next += count;
+#ifdef TRADE_FILE_MMAP
+    // Consumed pages are dropped so resident memory stays at about one batch, not the part of the file read so far
+    std::size_t pageBytes = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t consumed = (binaryHeaderBytes + next * sizeof(TradeRecord)) / pageBytes * pageBytes;
+    if (consumed > released) {
+        ::madvise(const_cast<unsigned char *>(data) + released, consumed - released, MADV_DONTNEED);
+        released = consumed;
+    }
+#endif
+    return count;
+}
+
+std::size_t BinaryTradeReader::size() const {
+    return numTrades;
+}
+
+BinaryTradeWriter::BinaryTradeWriter(std::ostream &output) : output(output) {
+    std::uint32_t recordBytes = sizeof(TradeRecord);
+    output.write(binaryMagic, sizeof(binaryMagic));
+    output.write(reinterpret_cast<const char *>(&binaryVersion), sizeof(binaryVersion));
+    output.write(reinterpret_cast<const char *>(&recordBytes), sizeof(recordBytes));
+}
+
+void BinaryTradeWriter::write(const std::vector<TradeRecord> &trades) {
+    output.write(reinterpret_cast<const char *>(trades.data()), static_cast<std::streamsize>(trades.size() * sizeof(TradeRecord)));
+}
+
+std::unique_ptr<TradeReader> openTradeFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open trade file " + path);
+    }
+    char magic[sizeof(binaryMagic)] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0) {
+        return std::make_unique<BinaryTradeReader>(path);
+    }
+    return std::make_unique<CsvTradeReader>(path);
+}
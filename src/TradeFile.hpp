@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "AsianOption.hpp"
+#include "PricingEngine.hpp"
+
+// Trade files for the batch pricer: one Asian contract on the equally spaced schedule and its market inputs per trade, either as CSV
+//   id,type,averaging,strike,expiry,periods,spot,rate,volatility
+//   1,call,arithmetic,105,1,12,100,0.05,0.2
+// or as a binary file of fixed-width TradeRecords after a 16-byte header, read through a memory map so a file of millions of trades
+// is paged in as it is consumed. Readers hand out trades a batch at a time, so memory does not grow with the size of the file.
+
+// One trade, laid out exactly as it is stored in a binary trade file (native byte order)
+struct TradeRecord {
+    std::uint64_t id;
+    double strike;
+    double expiry;
+    double spot;
+    double riskFreeRate;
+    double volatility;
+    std::uint32_t averagingPeriods;
+    std::uint8_t type;      // 0 call, 1 put
+    std::uint8_t averaging; // 0 arithmetic, 1 geometric
+    std::uint8_t reserved[2];
+
+    AsianOption option() const;
+    MarketData marketData() const;
+};
+static_assert(sizeof(TradeRecord) == 56, "TradeRecord is the binary trade file's record layout");
+
+// Throws std::invalid_argument naming the first field of the trade that cannot be priced
+void checkTrade(const TradeRecord &trade);
+
+// Source of trades, read in batches
+class TradeReader {
+public:
+    virtual ~TradeReader() = default;
+
+    // Replaces the contents of trades with the next (at most maxTrades) trades of the file and returns how many there are; zero at the end
+    virtual std::size_t read(std::vector<TradeRecord> &trades, std::size_t maxTrades) = 0;
+};
+
+// CSV trade file with the header line above. Type and averaging are case-insensitive; blank lines are skipped.
+// read() throws std::invalid_argument with the line number of the first malformed or unpriceable trade.
+class CsvTradeReader : public TradeReader {
+public:
+    explicit CsvTradeReader(std::istream &input);
+    explicit CsvTradeReader(const std::string &path); // throws std::runtime_error if the file cannot be opened
+
+    std::size_t read(std::vector<TradeRecord> &trades, std::size_t maxTrades) override;
+
+private:
+    void readHeader();
+
+    std::ifstream file;
+    std::istream *input;
+    std::string line;
+    unsigned long long lineNumber = 0;
+};
+
+// Memory-mapped binary trade file. The constructor throws std::runtime_error if the file cannot be mapped or is not a trade file;
+// read() throws std::invalid_argument with the index of the first unpriceable trade.
+class BinaryTradeReader : public TradeReader {
+public:
+    explicit BinaryTradeReader(const std::string &path);
+    ~BinaryTradeReader() override;
+    BinaryTradeReader(const BinaryTradeReader &) = delete;
+    BinaryTradeReader &operator=(const BinaryTradeReader &) = delete;
+
+    std::size_t read(std::vector<TradeRecord> &trades, std::size_t maxTrades) override;
+
+    std::size_t size() const; // number of trades in the file
+
+private:
+    const unsigned char *data = nullptr;
+    std::size_t bytes = 0;
+    std::size_t numTrades = 0;
+    std::size_t next = 0;
+    std::size_t released = 0; // bytes at the start of the mapping already given back to the kernel
+};
+
+// Writes the binary header once, then appends batches of trades
+class BinaryTradeWriter {
+public:
+    explicit BinaryTradeWriter(std::ostream &output);
+    void write(const std::vector<TradeRecord> &trades);
+
+private:
+    std::ostream &output;
+};
+
+// Binary reader if the file starts with the binary header, CSV reader otherwise
+std::unique_ptr<TradeReader> openTradeFile(const std::string &path);
@@ -1,9 +1,37 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include "Option.hpp"
 #include "AsianOption.hpp"
 #include "PricingEngine.hpp"
+#include "BatchPricer.hpp"
+#include "Instrumentation.hpp"
+#include "TradeFile.hpp"
 
-int main() {
+namespace {
+
+const char *const usage =
+        "Usage: IB9JHO_Group_Project                       print the demonstration call and put prices\n"
+        "       IB9JHO_Group_Project TRADES [options]      price every trade in a CSV or binary trade file\n"
+        "Options:\n"
+        "  --output FILE           write id,price,standard_error rows to FILE instead of standard output\n"
+        "  --paths N               paths per trade (default 10000)\n"
+        "  --threads N             worker threads (default: all hardware threads)\n"
+        "  --seed N                base seed (default 0)\n"
+        "  --batch N               trades read, priced and written at a time (default 1024)\n"
+        "  --to-binary FILE        convert the trade file to the binary format instead of pricing it\n"
+        "  --instrumentation FILE  write the engines' phase timings and counters as JSON (needs -DASIAN_PRICING_INSTRUMENTATION=ON)\n";
+
+// The original fixed example: one call and one put priced with each of the three basic methods
+int runDemonstration() {
     double spot_price = 100;
     double strike_price = 105;
     double risk_free_rate = 0.05;
@@ -35,3 +63,111 @@ int main() {
 
     return 0;
 }
+
+// Parses an option's value as a non-negative integer no greater than maximum, rejecting overflow as TradeFile's fields do
+unsigned long long parseCount(const std::string &option, const std::string &value, unsigned long long maximum) {
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long count = std::strtoull(value.c_str(), &end, 10);
+    if (value.empty() || value[0] == '-' || *end != '\0' || errno == ERANGE || count > maximum) {
+        throw std::invalid_argument(option + " expects a non-negative integer no greater than " + std::to_string(maximum) + ", got '" + value + "'");
+    }
+    return count;
+}
+
+int runBatch(const std::vector<std::string> &arguments) {
+    std::string tradePath = arguments[0];
+    std::string outputPath, binaryPath, instrumentationPath;
+    BatchPricerConfig config;
+    config.simulation.numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (std::size_t i = 1; i < arguments.size(); i += 2) {
+        const std::string &option = arguments[i];
+        if (i + 1 >= arguments.size()) {
+            throw std::invalid_argument(option + " expects a value");
+        }
+        const std::string &value = arguments[i + 1];
+        if (option == "--output") {
+            outputPath = value;
+        } else if (option == "--paths") {
+            config.numSimulations = static_cast<unsigned int>(parseCount(option, value, UINT32_MAX));
+        } else if (option == "--threads") {
+            config.simulation.numThreads = static_cast<unsigned int>(parseCount(option, value, UINT32_MAX));
+        } else if (option == "--seed") {
+            config.simulation.seed = parseCount(option, value, UINT64_MAX);
+        } else if (option == "--batch") {
+            config.tradesPerBatch = static_cast<std::size_t>(parseCount(option, value, SIZE_MAX));
+        } else if (option == "--to-binary") {
+            binaryPath = value;
+        } else if (option == "--instrumentation") {
+            instrumentationPath = value;
+        } else {
+            throw std::invalid_argument("unknown option " + option);
+        }
+    }
+    if (config.numSimulations == 0 || config.simulation.numThreads == 0 || config.tradesPerBatch == 0) {
+        throw std::invalid_argument("--paths, --threads and --batch must be positive");
+    }
+
+    std::unique_ptr<TradeReader> reader = openTradeFile(tradePath);
+
+    if (!binaryPath.empty()) {
+        std::ofstream binary(binaryPath, std::ios::binary);
+        if (!binary) {
+            throw std::runtime_error("cannot create " + binaryPath);
+        }
+        BinaryTradeWriter writer(binary);
+        std::vector<TradeRecord> trades;
+        unsigned long long count = 0;
+        while (reader->read(trades, config.tradesPerBatch) > 0) {
+            writer.write(trades);
+            count += trades.size();
+        }
+        std::cerr << "Wrote " << count << " trades to " << binaryPath << std::endl;
+        return 0;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            throw std::runtime_error("cannot create " + outputPath);
+        }
+    }
+    BatchPricerSummary summary = priceTradeFile(*reader, outputPath.empty() ? std::cout : file, config);
+
+    // The summary goes to standard error so the results can be piped
+    std::cerr << "Priced " << summary.contracts << " contracts in " << summary.wallTime << " s ("
+              << summary.contractsPerSecond() << " contracts/s, " << config.numSimulations << " paths each, "
+              << config.simulation.numThreads << " threads)" << std::endl;
+
+    if (!instrumentationPath.empty()) {
+        InstrumentationReport report = instrumentationReport();
+        if (!report.enabled) {
+            std::cerr << "Instrumentation is not built in; reconfigure with -DASIAN_PRICING_INSTRUMENTATION=ON" << std::endl;
+        }
+        std::ofstream json(instrumentationPath);
+        writeInstrumentationJson(json, report);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        return runDemonstration();
+    }
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments[0] == "--help" || arguments[0] == "-h") {
+        std::cout << usage;
+        return 0;
+    }
+
+    try {
+        return runBatch(arguments);
+    } catch (const std::exception &error) {
+        std::cerr << "Error: " << error.what() << '\n' << usage;
+        return 1;
+    }
+}
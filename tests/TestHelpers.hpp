@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../src/PricingEngine.hpp"
+
+// Market and simulation settings shared by the engine test suites
+
+const double spot = 100.0;
+const double riskFreeRate = 0.05;
+const double volatility = 0.2;
+
+// A fixed seed, so statistical tolerances are checked against the same paths on every run
+inline SimulationConfig seededConfig(unsigned int numThreads = 1) {
+    SimulationConfig config;
+    config.seed = 20261017;
+    config.numThreads = numThreads;
+    return config;
+}
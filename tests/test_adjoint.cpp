@@ -0,0 +1,41 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../src/Adjoint.hpp"
+
+// Test case ensuring one backward sweep gives the gradient of an expression with respect to every input
+TEST(AdjointTest, GradientOfExpression) {
+    Tape &tape = Tape::current();
+    std::size_t origin = tape.mark();
+
+    Active x = Active::variable(1.5);
+    Active y = Active::variable(0.5);
+    Active f = exp(x * y) / y + log(x) * sqrt(y) - 3.0 * x;
+    f += max(x - 2.0, 0.0) + max(y, 0.25);
+
+    tape.clearAdjoints();
+    tape.adjoint(f.getIndex()) = 1.0;
+    tape.propagate(origin);
+
+    double xv = 1.5, yv = 0.5;
+    EXPECT_NEAR(f.getValue(), std::exp(xv * yv) / yv + std::log(xv) * std::sqrt(yv) - 3.0 * xv + yv, 1e-14);
+    EXPECT_NEAR(tape.adjoint(x.getIndex()), std::exp(xv * yv) + std::sqrt(yv) / xv - 3.0, 1e-14);
+    EXPECT_NEAR(tape.adjoint(y.getIndex()), std::exp(xv * yv) * (xv * yv - 1.0) / (yv * yv) + std::log(xv) / (2.0 * std::sqrt(yv)) + 1.0, 1e-13);
+    tape.rewind(origin);
+}
+
+// Test case ensuring constants are not recorded and a rewound tape is reused
+TEST(AdjointTest, ConstantsAreNotRecorded) {
+    Tape &tape = Tape::current();
+    std::size_t origin = tape.mark();
+
+    Active constant = exp(Active(2.0)) * 3.0;
+    EXPECT_EQ(constant.getIndex(), 0u);
+    EXPECT_EQ(tape.mark(), origin);
+
+    Active x = Active::variable(2.0);
+    Active y = x * x;
+    EXPECT_EQ(tape.mark(), origin + 2);
+    tape.rewind(origin);
+    EXPECT_EQ(tape.mark(), origin);
+    EXPECT_DOUBLE_EQ(y.getValue(), 4.0);
+}
@@ -1,3 +1,6 @@
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 #include "../src/Option.hpp"
 #include "../src/AsianOption.hpp"
@@ -53,3 +56,46 @@ TEST_F(AsianOptionTest, GetType) {
     EXPECT_EQ(expectedType, asianOption->getType());
 }
 
+
+// Test case ensuring an option without any averaging periods is rejected
+TEST_F(AsianOptionTest, ZeroAveragingPeriodsThrows) {
+    EXPECT_THROW(AsianOption(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 0), std::invalid_argument);
+}
+
+// Test case ensuring the legacy constructor stores the equally spaced schedule and no past fixings
+TEST_F(AsianOptionTest, UniformSchedule) {
+    const std::vector<double> &times = asianOption->getFixingTimes();
+    ASSERT_EQ(times.size(), 10u);
+    EXPECT_EQ(times.front(), 0.0);
+    EXPECT_DOUBLE_EQ(times.back(), 0.9);
+    EXPECT_EQ(asianOption->getPastFixings(), 0u);
+    EXPECT_TRUE(asianOption->hasUniformSchedule());
+}
+
+// Test case ensuring a seasoned option counts its past and remaining fixings
+TEST_F(AsianOptionTest, SeasonedSchedule) {
+    AsianOption seasoned(105.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Geometric, {0.5, 0.75, 1.0}, 2, 98.5);
+    EXPECT_EQ(seasoned.getAveragingPeriods(), 5u);
+    EXPECT_EQ(seasoned.getPastFixings(), 2u);
+    EXPECT_EQ(seasoned.getPastAverage(), 98.5);
+    EXPECT_EQ(seasoned.getFixingTimes().size(), 3u);
+    EXPECT_FALSE(seasoned.hasUniformSchedule());
+
+    // Every fixing observed: nothing left to simulate
+    AsianOption fixed(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, std::vector<double>(), 4, 101.0);
+    EXPECT_EQ(fixed.getAveragingPeriods(), 4u);
+}
+
+// Test case ensuring invalid schedules and past averages are rejected
+TEST_F(AsianOptionTest, InvalidScheduleThrows) {
+    auto make = [](std::vector<double> times, unsigned int pastFixings, double pastAverage) {
+        return AsianOption(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, std::move(times), pastFixings, pastAverage);
+    };
+    EXPECT_THROW(make({}, 0, 0.0), std::invalid_argument);            // no fixings at all
+    EXPECT_THROW(make({-0.1, 0.5}, 0, 0.0), std::invalid_argument);    // a fixing in the past
+    EXPECT_THROW(make({0.5, 0.2}, 0, 0.0), std::invalid_argument);     // out of order
+    EXPECT_THROW(make({0.5, 0.5}, 0, 0.0), std::invalid_argument);     // repeated
+    EXPECT_THROW(make({0.5, 1.5}, 0, 0.0), std::invalid_argument);     // after expiry
+    EXPECT_THROW(make({0.5, 1.0}, 3, 0.0), std::invalid_argument);     // past fixings without an average
+    EXPECT_NO_THROW(make({0.0, 0.5, 1.0}, 0, 0.0));
+}
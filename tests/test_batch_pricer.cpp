@@ -0,0 +1,87 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/BatchPricer.hpp"
+#include "../src/PricingEngine.hpp"
+
+namespace {
+
+std::string tradeCsv() {
+    return "id,type,averaging,strike,expiry,periods,spot,rate,volatility\n"
+           "101,call,arithmetic,105,1,12,100,0.05,0.2\n"
+           "102,put,arithmetic,105,1,12,100,0.05,0.2\n"
+           "103,call,geometric,95,0.5,6,102,0.03,0.3\n"
+           "104,put,geometric,110,2,24,98,0.01,0.25\n"
+           "105,call,arithmetic,100,1,52,100,0.05,0.4\n";
+}
+
+std::vector<std::vector<std::string>> parseRows(const std::string &text) {
+    std::vector<std::vector<std::string>> rows;
+    std::istringstream input(text);
+    std::string line;
+    while (std::getline(input, line)) {
+        std::vector<std::string> fields;
+        std::istringstream fieldInput(line);
+        std::string field;
+        while (std::getline(fieldInput, field, ',')) {
+            fields.push_back(field);
+        }
+        rows.push_back(fields);
+    }
+    return rows;
+}
+
+} // namespace
+
+// Test case ensuring every row is the GBM price of its trade, in file order, whatever the batch size and thread count
+TEST(BatchPricerTest, RowsMatchGbmPrices) {
+    BatchPricerConfig config;
+    config.numSimulations = 5000;
+    config.tradesPerBatch = 2;
+    config.simulation.seed = 17;
+    config.simulation.numThreads = 3;
+
+    std::istringstream input(tradeCsv());
+    CsvTradeReader reader(input);
+    std::ostringstream output;
+    BatchPricerSummary summary = priceTradeFile(reader, output, config);
+
+    EXPECT_EQ(summary.contracts, 5u);
+    EXPECT_EQ(summary.batches, 3u);
+    EXPECT_GT(summary.contractsPerSecond(), 0.0);
+
+    std::vector<std::vector<std::string>> rows = parseRows(output.str());
+    ASSERT_EQ(rows.size(), 6u);
+    EXPECT_EQ(rows[0], (std::vector<std::string>{"id", "price", "standard_error"}));
+
+    std::istringstream again(tradeCsv());
+    CsvTradeReader expectedReader(again);
+    std::vector<TradeRecord> trades;
+    expectedReader.read(trades, 10);
+    SimulationConfig single = config.simulation;
+    single.numThreads = 1;
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        MarketData market = trades[i].marketData();
+        PricingResult expected = PricingEngine::calculatePriceGBM(trades[i].option(), market.spot, market.riskFreeRate, market.volatility,
+                                                                  config.numSimulations, single);
+        ASSERT_EQ(rows[i + 1].size(), 3u);
+        EXPECT_EQ(rows[i + 1][0], std::to_string(trades[i].id));
+        EXPECT_EQ(std::stod(rows[i + 1][1]), expected.price);
+        EXPECT_EQ(std::stod(rows[i + 1][2]), expected.standardError);
+    }
+}
+
+// Test case ensuring an empty file gives just the header, and a zero batch size is rejected
+TEST(BatchPricerTest, EmptyFileAndInvalidBatch) {
+    std::istringstream input("id,type,averaging,strike,expiry,periods,spot,rate,volatility\n");
+    CsvTradeReader reader(input);
+    std::ostringstream output;
+    BatchPricerConfig config;
+    BatchPricerSummary summary = priceTradeFile(reader, output, config);
+    EXPECT_EQ(summary.contracts, 0u);
+    EXPECT_EQ(output.str(), "id,price,standard_error\n");
+
+    config.tradesPerBatch = 0;
+    EXPECT_THROW(priceTradeFile(reader, output, config), std::invalid_argument);
+}
@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/BrownianBridge.hpp"
+
+// Test case ensuring the bridge reproduces Brownian covariances: with the construction matrix A (columns = paths built from unit
+// normals), A A^T must equal min(t_i, t_j), for uniform and non-uniform times
+TEST(BrownianBridgeTest, CovarianceIsMinOfTimes) {
+    std::vector<std::vector<double>> schedules = {{0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7}, {0.05, 0.3, 0.31, 0.9, 1.4, 2.0}, {1.0}};
+    for (const std::vector<double> &times : schedules) {
+        BrownianBridge bridge(times);
+        unsigned int m = bridge.size();
+        std::vector<std::vector<double>> columns(m, std::vector<double>(m));
+        for (unsigned int i = 0; i < m; ++i) {
+            std::vector<double> unit(m, 0.0);
+            unit[i] = 1.0;
+            bridge.buildPath(unit.data(), columns[i].data());
+        }
+        for (unsigned int a = 0; a < m; ++a) {
+            for (unsigned int b = 0; b < m; ++b) {
+                double covariance = 0.0;
+                for (unsigned int i = 0; i < m; ++i) {
+                    covariance += columns[i][a] * columns[i][b];
+                }
+                EXPECT_NEAR(covariance, std::min(times[a], times[b]), 1e-12);
+            }
+        }
+    }
+}
+
+// Test case ensuring the first normal alone sets the end point, scaled by sqrt(T)
+TEST(BrownianBridgeTest, FirstNormalDrivesEndPoint) {
+    BrownianBridge bridge({0.25, 0.5, 0.75, 1.0});
+    double normals[] = {2.0, 0.0, 0.0, 0.0};
+    double path[4];
+    bridge.buildPath(normals, path);
+    EXPECT_DOUBLE_EQ(path[3], 2.0);
+    EXPECT_DOUBLE_EQ(path[1], 1.0);
+}
+
+TEST(BrownianBridgeTest, RejectsUnorderedTimes) {
+    EXPECT_THROW(BrownianBridge({0.5, 0.5}), std::invalid_argument);
+    EXPECT_THROW(BrownianBridge({0.0, 0.5}), std::invalid_argument);
+}
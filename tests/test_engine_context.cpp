@@ -0,0 +1,162 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <gtest/gtest.h>
+#include "../src/EngineContext.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+
+// Every heap allocation made by this test binary, so the tests can check what a pricing call costs once its context is warm
+namespace {
+std::atomic<unsigned long long> heapAllocationCount{0};
+}
+
+void *operator new(std::size_t size) {
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+unsigned long long allocationsDuring(const std::function<void()> &body) {
+    unsigned long long before = heapAllocationCount.load();
+    body();
+    return heapAllocationCount.load() - before;
+}
+
+} // namespace
+
+// Test case ensuring arena allocations are cache-line aligned and do not overlap
+TEST(EngineContextTest, ArenaAllocationsAreAligned) {
+    PathArena arena(1024);
+    double *a = arena.allocate<double>(3);
+    double *b = arena.allocate<double>(0);
+    double *c = arena.allocate<double>(200); // larger than a block
+
+    for (const double *p : {a, b, c}) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % PathArena::alignment, 0u);
+    }
+    EXPECT_GE(reinterpret_cast<const char *>(b) - reinterpret_cast<const char *>(a), 64);
+
+    ArenaStatistics statistics = arena.getStatistics();
+    EXPECT_EQ(statistics.heapAllocations, 2u);
+    EXPECT_EQ(statistics.bytesInUse, 64u + 64u + 1600u);
+    EXPECT_EQ(statistics.peakBytesInUse, statistics.bytesInUse);
+}
+
+// Test case ensuring rewinding hands the same memory out again without touching the heap
+TEST(EngineContextTest, ArenaRewindReusesBlocks) {
+    PathArena arena(4096);
+    double *first = nullptr;
+    {
+        ArenaScope scope(arena);
+        first = arena.allocate<double>(100);
+        arena.allocate<double>(1000);
+    }
+    EXPECT_EQ(arena.getStatistics().bytesInUse, 0u);
+    unsigned long long blocks = arena.getStatistics().heapAllocations;
+
+    unsigned long long allocations = allocationsDuring([&]() {
+        ArenaScope scope(arena);
+        EXPECT_EQ(arena.allocate<double>(100), first);
+        arena.allocate<double>(1000);
+    });
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(arena.getStatistics().heapAllocations, blocks);
+    EXPECT_EQ(arena.getStatistics().peakBytesInUse, 832u + 8000u);
+}
+
+// Test case ensuring a context hands a released slot out again and only grows for concurrent leases
+TEST(EngineContextTest, LeasesReuseSlots) {
+    EngineContext context;
+    {
+        EngineContext::Lease lease = context.acquire();
+        lease.arena().allocate<double>(10);
+        EXPECT_EQ(context.getStatistics().bytesInUse, 128u);
+    }
+    EXPECT_EQ(context.numSlots(), 1u);
+    EXPECT_EQ(context.getStatistics().bytesInUse, 0u);
+    {
+        EngineContext::Lease first = context.acquire();
+        EngineContext::Lease second = context.acquire();
+        EXPECT_NE(&first.arena(), &second.arena());
+    }
+    EXPECT_EQ(context.numSlots(), 2u);
+}
+
+// Test case ensuring a leased stream restarts exactly as a freshly constructed stream
+TEST(EngineContextTest, LeasedStreamMatchesNewStream) {
+    EngineContext context;
+    EngineContext::Lease lease = context.acquire();
+    for (RandomGenerator generator : {RandomGenerator::Philox, RandomGenerator::MersenneTwister}) {
+        double restarted[10], expected[10];
+        lease.stream(generator, 1, 2).fill(restarted, 5);
+        lease.stream(generator, 7, 3).fill(restarted, 10);
+        NormalStream(generator, 7, 3).fill(expected, 10);
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(restarted[i], expected[i]);
+        }
+    }
+}
+
+// Test case ensuring a warm context prices without heap allocations per path: ten times the paths cost the same allocations
+TEST(EngineContextTest, SteadyStateAllocationsDoNotGrowWithPaths) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 52);
+    EngineContext context;
+    SimulationConfig config;
+    config.seed = 3;
+    config.context = &context;
+
+    for (RandomGenerator generator : {RandomGenerator::Philox, RandomGenerator::MersenneTwister}) {
+        config.generator = generator;
+        PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.2, 4 * PricingEngine::pathsPerChunk, config);
+        PricingEngine::calculatePriceStreaming(option, 100.0, 0.05, 0.2, 4 * PricingEngine::pathsPerChunk, config);
+
+        unsigned long long few = allocationsDuring([&]() {
+            PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.2, PricingEngine::pathsPerChunk, config);
+        });
+        unsigned long long many = allocationsDuring([&]() {
+            PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.2, 10 * PricingEngine::pathsPerChunk, config);
+        });
+        EXPECT_LE(many, few + 1); // the vector of chunk sums
+
+        unsigned long long fewStreaming = allocationsDuring([&]() {
+            PricingEngine::calculatePriceStreaming(option, 100.0, 0.05, 0.2, PricingEngine::pathsPerChunk, config);
+        });
+        unsigned long long manyStreaming = allocationsDuring([&]() {
+            PricingEngine::calculatePriceStreaming(option, 100.0, 0.05, 0.2, 10 * PricingEngine::pathsPerChunk, config);
+        });
+        EXPECT_LE(manyStreaming, fewStreaming + 1);
+    }
+    EXPECT_EQ(context.numSlots(), 1u);
+    EXPECT_EQ(context.getStatistics().bytesInUse, 0u);
+}
+
+// Test case ensuring prices do not depend on which context supplied the scratch memory
+TEST(EngineContextTest, PricesDoNotDependOnContext) {
+    AsianOption option(95.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Geometric, 12);
+    EngineContext context;
+    SimulationConfig config;
+    config.seed = 5;
+    config.numThreads = 3;
+    PricingResult shared = PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.3, 50000, config);
+    config.context = &context;
+    PricingResult own = PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.3, 50000, config);
+
+    EXPECT_EQ(shared.price, own.price);
+    EXPECT_EQ(shared.standardError, own.standardError);
+    EXPECT_GE(context.numSlots(), 1u);
+}
@@ -0,0 +1,110 @@
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/FiniteDifference.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+#include "TestHelpers.hpp"
+
+// Test case ensuring the Thomas solver, in one call and factorised with two right-hand sides, recovers known solutions
+TEST(FiniteDifferenceTest, TridiagonalSolverRecoversKnownSolution) {
+    const unsigned int n = 7;
+    std::vector<double> lower(n), diagonal(n), upper(n), x(n), y(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        lower[i] = -1.0 - 0.1 * i;
+        diagonal[i] = 4.0 + 0.5 * i;
+        upper[i] = -2.0 + 0.2 * i;
+        x[i] = std::sin(1.0 + i);
+        y[i] = 0.5 * i - 1.0;
+    }
+    auto multiply = [&](const std::vector<double> &v) {
+        std::vector<double> product(n);
+        for (unsigned int i = 0; i < n; ++i) {
+            product[i] = diagonal[i] * v[i] + (i > 0 ? lower[i] * v[i - 1] : 0.0) + (i + 1 < n ? upper[i] * v[i + 1] : 0.0);
+        }
+        return product;
+    };
+
+    std::vector<double> values = multiply(x), scratch(2 * n - 1);
+    solveTridiagonal(n, lower.data(), diagonal.data(), upper.data(), values.data(), scratch.data());
+    for (unsigned int i = 0; i < n; ++i) {
+        EXPECT_NEAR(values[i], x[i], 1e-14);
+    }
+
+    std::vector<double> ratios(n - 1), inversePivots(n);
+    factorTridiagonal(n, lower.data(), diagonal.data(), upper.data(), ratios.data(), inversePivots.data());
+    for (const std::vector<double> *expected : {&x, &y}) {
+        std::vector<double> rhs = multiply(*expected);
+        solveFactoredTridiagonal(n, lower.data(), ratios.data(), inversePivots.data(), rhs.data());
+        for (unsigned int i = 0; i < n; ++i) {
+            EXPECT_NEAR(rhs[i], (*expected)[i], 1e-14);
+        }
+    }
+}
+
+// Test case ensuring calls and puts across strikes agree with long control-variate Monte Carlo runs
+TEST(FiniteDifferenceTest, MatchesControlVariateMonteCarlo) {
+    for (Option::Type type : {Option::Type::Call, Option::Type::Put}) {
+        for (double strike : {90.0, 100.0, 115.0}) {
+            AsianOption option(strike, 1.0, type, AsianOption::AveragingType::Arithmetic, 12);
+            FiniteDifferenceResult pde = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility);
+            PricingResult reference = PricingEngine::calculatePriceControlVariate(option, spot, riskFreeRate, volatility, 200000, seededConfig());
+            EXPECT_NEAR(pde.price, reference.price, 4.0 * reference.standardError + 1e-3) << "strike " << strike;
+            EXPECT_GT(pde.wallTime, 0.0);
+        }
+    }
+}
+
+// Test case ensuring a seasoned contract on an explicit schedule agrees with Monte Carlo, and that its grid delta and gamma agree
+// with bumping the spot and re-solving
+TEST(FiniteDifferenceTest, SeasonedScheduleAndGreeks) {
+    AsianOption option(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, {0.25, 0.5, 0.75, 1.0}, 2, 110.0);
+    FiniteDifferenceConfig fine;
+    fine.spaceSteps = 800;
+    fine.timeSteps = 400;
+    FiniteDifferenceResult pde = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility, fine);
+    PricingResult reference = PricingEngine::calculatePriceControlVariate(option, spot, riskFreeRate, volatility, 200000, seededConfig());
+    EXPECT_NEAR(pde.price, reference.price, 4.0 * reference.standardError + 1e-3);
+
+    const double h = 0.5;
+    double up = PricingEngine::calculatePriceFiniteDifference(option, spot + h, riskFreeRate, volatility, fine).price;
+    double down = PricingEngine::calculatePriceFiniteDifference(option, spot - h, riskFreeRate, volatility, fine).price;
+    EXPECT_NEAR(pde.delta, (up - down) / (2.0 * h), 1e-3);
+    EXPECT_NEAR(pde.gamma, (up - 2.0 * pde.price + down) / (h * h), 1e-3);
+    EXPECT_GT(pde.delta, 0.0);
+    EXPECT_GT(pde.gamma, 0.0);
+}
+
+// Test case ensuring a daily schedule, solved in fewer steps than it has fixing dates, agrees with a solve that steps through every date
+TEST(FiniteDifferenceTest, DenseScheduleAveragesCoefficients) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 252);
+    FiniteDifferenceResult merged = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility);
+    FiniteDifferenceConfig everyDate;
+    everyDate.timeSteps = 1008;
+    FiniteDifferenceResult stepped = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility, everyDate);
+    EXPECT_NEAR(merged.price, stepped.price, 1e-3);
+    EXPECT_NEAR(merged.delta, stepped.delta, 1e-4);
+    EXPECT_NEAR(merged.gamma, stepped.gamma, 1e-4);
+}
+
+// Test case ensuring repeated solves are identical and reuse the context's memory, and that geometric averaging is refused
+TEST(FiniteDifferenceTest, DeterministicAllocationFreeAndArithmeticOnly) {
+    AsianOption option(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Arithmetic, 26);
+    EngineContext context;
+    FiniteDifferenceConfig config;
+    config.context = &context;
+    FiniteDifferenceResult first = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility, config);
+    unsigned long long allocations = context.getStatistics().heapAllocations;
+    for (int i = 0; i < 3; ++i) {
+        FiniteDifferenceResult again = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, volatility, config);
+        EXPECT_EQ(again.price, first.price);
+        EXPECT_EQ(again.delta, first.delta);
+        EXPECT_EQ(again.gamma, first.gamma);
+    }
+    EXPECT_EQ(context.getStatistics().heapAllocations, allocations);
+    EXPECT_EQ(context.getStatistics().bytesInUse, 0u);
+
+    AsianOption geometric(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Geometric, 26);
+    EXPECT_THROW(PricingEngine::calculatePriceFiniteDifference(geometric, spot, riskFreeRate, volatility), std::invalid_argument);
+}
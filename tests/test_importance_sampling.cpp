@@ -0,0 +1,88 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/ImportanceSampling.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+#include "TestHelpers.hpp"
+
+// Test case ensuring the solved drift is a stationary point and a maximum of the objective, pointing up for calls and down for puts
+TEST(ImportanceSamplingTest, DriftMaximisesTheObjective) {
+    for (Option::Type type : {Option::Type::Call, Option::Type::Put}) {
+        for (AsianOption::AveragingType averaging : {AsianOption::AveragingType::Arithmetic, AsianOption::AveragingType::Geometric}) {
+            AsianOption option(type == Option::Type::Call ? 150.0 : 65.0, 1.0, type, averaging, 12);
+            KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+            std::vector<double> shift = optimalDriftShift(parameters, averaging, type);
+            ASSERT_EQ(shift.size(), 11u);
+
+            double value = importanceSamplingObjective(parameters, averaging, type, shift);
+            ASSERT_TRUE(std::isfinite(value));
+            for (unsigned int j = 0; j < shift.size(); ++j) {
+                EXPECT_EQ(shift[j] > 0.0, type == Option::Type::Call);
+                const double h = 1e-5;
+                std::vector<double> up = shift, down = shift;
+                up[j] += h;
+                down[j] -= h;
+                double upValue = importanceSamplingObjective(parameters, averaging, type, up);
+                double downValue = importanceSamplingObjective(parameters, averaging, type, down);
+                EXPECT_NEAR((upValue - downValue) / (2.0 * h), 0.0, 1e-6);
+                EXPECT_LE(upValue, value);
+                EXPECT_LE(downValue, value);
+            }
+        }
+    }
+}
+
+// Test case ensuring a contract no path can exercise gets no shift and prices at zero
+TEST(ImportanceSamplingTest, UnreachableExerciseGivesNoShift) {
+    AsianOption option(0.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Arithmetic, 12);
+    KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+    EXPECT_EQ(optimalDriftShift(parameters, AsianOption::AveragingType::Arithmetic, Option::Type::Put), std::vector<double>(11, 0.0));
+
+    ImportanceSamplingResult result = PricingEngine::calculatePriceImportanceSampling(option, spot, riskFreeRate, volatility, 1000, seededConfig());
+    EXPECT_EQ(result.price.price, 0.0);
+    EXPECT_EQ(result.price.pathsUsed, 1000u);
+}
+
+// Test case ensuring out-of-the-money geometric prices agree with the closed form, with a large variance reduction over plain Monte Carlo
+TEST(ImportanceSamplingTest, GeometricWingsMatchClosedForm) {
+    AsianOption call(150.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, 12);
+    AsianOption put(65.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Geometric, 12);
+    AsianOption seasoned(140.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, {0.25, 0.5, 0.75, 1.0}, 2, 110.0);
+
+    for (const AsianOption *option : {&call, &put, &seasoned}) {
+        ImportanceSamplingResult result = PricingEngine::calculatePriceImportanceSampling(*option, spot, riskFreeRate, volatility, 50000, seededConfig());
+        double exact = PricingEngine::calculatePriceGeometricClosedForm(*option, spot, riskFreeRate, volatility);
+        EXPECT_GT(exact, 0.0);
+        EXPECT_NEAR(result.price.price, exact, 4.0 * result.price.standardError);
+        EXPECT_GT(result.varianceReduction, 10.0);
+        EXPECT_NEAR(result.naiveVariance, result.price.variance * result.varianceReduction, 1e-12 * result.naiveVariance);
+    }
+}
+
+// Test case ensuring the arithmetic out-of-the-money call agrees with a much longer control-variate run, and that plain Monte Carlo's
+// variance estimated from the weighted paths matches the variance plain Monte Carlo actually shows
+TEST(ImportanceSamplingTest, ArithmeticWingMatchesControlVariate) {
+    AsianOption option(150.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    ImportanceSamplingResult result = PricingEngine::calculatePriceImportanceSampling(option, spot, riskFreeRate, volatility, 50000, seededConfig());
+    PricingResult reference = PricingEngine::calculatePriceControlVariate(option, spot, riskFreeRate, volatility, 400000, seededConfig());
+    PricingResult plain = PricingEngine::calculatePriceGBM(option, spot, riskFreeRate, volatility, 400000, seededConfig());
+
+    double combinedError = std::hypot(result.price.standardError, reference.standardError);
+    EXPECT_NEAR(result.price.price, reference.price, 4.0 * combinedError);
+    EXPECT_GT(result.varianceReduction, 10.0);
+    EXPECT_NEAR(result.naiveVariance, plain.variance, 0.25 * plain.variance);
+}
+
+// Test case ensuring the estimate does not depend on the number of threads, and that the run-time method selector returns the same price
+TEST(ImportanceSamplingTest, ReproducibleAcrossThreadsAndMethodSelector) {
+    AsianOption option(130.0, 0.5, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 26);
+    ImportanceSamplingResult single = PricingEngine::calculatePriceImportanceSampling(option, spot, riskFreeRate, volatility, 20000, seededConfig(1));
+    ImportanceSamplingResult threaded = PricingEngine::calculatePriceImportanceSampling(option, spot, riskFreeRate, volatility, 20000, seededConfig(3));
+    EXPECT_EQ(single.price.price, threaded.price.price);
+    EXPECT_EQ(single.price.variance, threaded.price.variance);
+    EXPECT_EQ(single.driftShift, threaded.driftShift);
+
+    PricingResult selected = PricingEngine::calculatePrice(PricingEngine::Method::ImportanceSampling, option, spot, riskFreeRate, volatility, 20000, seededConfig());
+    EXPECT_EQ(selected.price, single.price.price);
+}
@@ -0,0 +1,95 @@
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+#include "../src/Instrumentation.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+
+namespace {
+
+// Blocks of pathBlockWidth = 8 paths within chunks of 4096 paths
+std::uint64_t expectedBlocks(unsigned int numSimulations) {
+    std::uint64_t blocks = 0;
+    for (unsigned int first = 0; first < numSimulations; first += PricingEngine::pathsPerChunk) {
+        unsigned int numPaths = std::min(PricingEngine::pathsPerChunk, numSimulations - first);
+        blocks += (numPaths + 7) / 8;
+    }
+    return blocks;
+}
+
+} // namespace
+
+// Test case ensuring the counters add up to exactly the work a GBM run does, summed over its threads
+TEST(InstrumentationTest, CountsMatchTheSimulation) {
+    ASSERT_TRUE(ASIAN_PRICING_INSTRUMENTATION);
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    SimulationConfig config;
+    config.seed = 1;
+    config.numThreads = 3;
+
+    resetInstrumentation();
+    PricingEngine::calculatePriceGBM(option, 100.0, 0.05, 0.2, 10000, config);
+    InstrumentationReport report = instrumentationReport();
+
+    EXPECT_TRUE(report.enabled);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Paths), 10000u);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Steps), 10000u * 11);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Normals), 10000u * 11);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Chunks), 3u);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Blocks), expectedBlocks(10000));
+
+    EXPECT_EQ(report.calls(InstrumentedPhase::Chunk), 3u);
+    EXPECT_EQ(report.calls(InstrumentedPhase::RandomNumbers), expectedBlocks(10000));
+    EXPECT_EQ(report.calls(InstrumentedPhase::PathStepping), expectedBlocks(10000));
+    EXPECT_EQ(report.calls(InstrumentedPhase::Payoff), expectedBlocks(10000));
+
+    // The other phases run inside chunks and never overlap, so they cannot add up to more than the chunks' time
+    std::uint64_t inner = report.ticks(InstrumentedPhase::RandomNumbers) + report.ticks(InstrumentedPhase::PathStepping)
+                          + report.ticks(InstrumentedPhase::Payoff) + report.ticks(InstrumentedPhase::Statistics);
+    EXPECT_GT(report.ticks(InstrumentedPhase::PathStepping), 0u);
+    EXPECT_LE(inner, report.ticks(InstrumentedPhase::Chunk));
+}
+
+// Test case ensuring counts accumulate over calls until reset, and worker threads' blocks are reused rather than added per call
+TEST(InstrumentationTest, AccumulatesAndResets) {
+    AsianOption option(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Geometric, 6);
+    SimulationConfig config;
+    config.numThreads = 4;
+
+    // Which workers end up recording varies from call to call, but without reuse every call would add up to four new blocks
+    resetInstrumentation();
+    for (int call = 0; call < 5; ++call) {
+        PricingEngine::calculatePriceStreaming(option, 100.0, 0.05, 0.2, 20000, config);
+    }
+
+    InstrumentationReport report = instrumentationReport();
+    EXPECT_EQ(report.counter(InstrumentedCounter::Paths), 100000u);
+    EXPECT_EQ(report.counter(InstrumentedCounter::Chunks), 25u);
+    EXPECT_LE(report.threads, 4u + 1u);
+
+    resetInstrumentation();
+    report = instrumentationReport();
+    EXPECT_EQ(report.counter(InstrumentedCounter::Paths), 0u);
+    EXPECT_EQ(report.ticks(InstrumentedPhase::Chunk), 0u);
+}
+
+// Test case ensuring the JSON dump names every counter and phase with its value
+TEST(InstrumentationTest, WritesJson) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 4);
+    SimulationConfig config;
+
+    resetInstrumentation();
+    PricingEngine::calculatePriceControlVariate(option, 100.0, 0.05, 0.2, 100, config);
+    std::ostringstream output;
+    writeInstrumentationJson(output, instrumentationReport());
+    std::string json = output.str();
+
+    EXPECT_NE(json.find("\"enabled\": true"), std::string::npos);
+    EXPECT_NE(json.find("\"paths\": 100,"), std::string::npos);
+    EXPECT_NE(json.find("\"steps\": 300,"), std::string::npos);
+    EXPECT_NE(json.find("\"chunks\": 1}"), std::string::npos);
+    EXPECT_NE(json.find("\"chunk\": {\"ticks\": "), std::string::npos);
+    EXPECT_NE(json.find("\"statistics\": {\"ticks\": "), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 2), "}\n");
+}
@@ -0,0 +1,11 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../src/MathUtils.hpp"
+
+// Test case for known values of the normal CDF and PDF
+TEST(MathUtilsTest, NormalCdfAndPdf) {
+    EXPECT_DOUBLE_EQ(normalCdf(0.0), 0.5);
+    EXPECT_NEAR(normalCdf(1.96), 0.9750021048517795, 1e-15);
+    EXPECT_NEAR(normalCdf(-1.0) + normalCdf(1.0), 1.0, 1e-15);
+    EXPECT_NEAR(normalPdf(0.0), 1.0 / std::sqrt(2.0 * M_PI), 1e-15);
+}
@@ -0,0 +1,136 @@
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/MomentMatching.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+#include "TestHelpers.hpp"
+
+// Test case ensuring the distribution's moments match the direct double sums over an explicit, seasoned schedule
+TEST(MomentMatchingTest, MomentsMatchDirectSums) {
+    std::vector<double> times = {0.1, 0.35, 0.6, 0.8, 1.0};
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, times, 3, 95.0);
+    AverageDistribution distribution = makeAverageDistribution(option, spot, riskFreeRate, volatility);
+
+    double mean = 0.0, secondMoment = 0.0;
+    for (double ti : times) {
+        mean += spot * std::exp(riskFreeRate * ti) / 8.0;
+        for (double tj : times) {
+            secondMoment += spot * spot * std::exp(riskFreeRate * (ti + tj) + volatility * volatility * std::min(ti, tj)) / 64.0;
+        }
+    }
+    EXPECT_NEAR(distribution.known, 3.0 * 95.0 / 8.0, 1e-12);
+    EXPECT_NEAR(distribution.mean, mean, 1e-12);
+    EXPECT_NEAR(distribution.secondMoment, secondMoment, 1e-9);
+    EXPECT_EQ(distribution.deterministic, 0.0);
+}
+
+// Test case ensuring the bracket holds the finite-difference price for calls and puts across strikes and volatilities, so the
+// error bound covers the actual error
+TEST(MomentMatchingTest, BracketHoldsReferencePrices) {
+    FiniteDifferenceConfig fine;
+    fine.spaceSteps = 1600;
+    fine.timeSteps = 800;
+    for (Option::Type type : {Option::Type::Call, Option::Type::Put}) {
+        for (double strike : {80.0, 100.0, 125.0}) {
+            for (double vol : {0.1, 0.4}) {
+                AsianOption option(strike, 1.0, type, AsianOption::AveragingType::Arithmetic, 12);
+                MomentMatchingResult result = PricingEngine::calculatePriceMomentMatching(option, spot, riskFreeRate, vol);
+                double reference = PricingEngine::calculatePriceFiniteDifference(option, spot, riskFreeRate, vol, fine).price;
+                EXPECT_LE(result.lowerBound, reference + 1e-4) << "strike " << strike << " vol " << vol;
+                EXPECT_GE(result.upperBound, reference - 1e-4) << "strike " << strike << " vol " << vol;
+                EXPECT_LE(std::abs(result.price - reference), result.errorBound + 1e-4);
+                EXPECT_GE(result.price, result.lowerBound);
+                EXPECT_LE(result.price, result.upperBound);
+            }
+        }
+    }
+
+    // At the money the bracket is a small fraction of the lognormal approximation's own error
+    AsianOption atm(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    MomentMatchingResult result = PricingEngine::calculatePriceMomentMatching(atm, spot, riskFreeRate, volatility);
+    EXPECT_LT(result.errorBound, 0.005);
+    EXPECT_GT(std::abs(result.lognormalPrice - result.price), 0.01);
+}
+
+// Test case ensuring contracts whose exercise is already decided are priced exactly, and geometric averaging by its closed form
+TEST(MomentMatchingTest, DecidedAndGeometricContractsAreExact) {
+    AsianOption call(60.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, {0.5, 1.0}, 6, 90.0);
+    AsianOption put(60.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Arithmetic, {0.5, 1.0}, 6, 90.0);
+    double discount = std::exp(-riskFreeRate);
+    double expectedAverage = (6.0 * 90.0 + spot * std::exp(riskFreeRate * 0.5) + spot * std::exp(riskFreeRate)) / 8.0;
+
+    MomentMatchingResult callResult = PricingEngine::calculatePriceMomentMatching(call, spot, riskFreeRate, volatility);
+    EXPECT_NEAR(callResult.price, discount * (expectedAverage - 60.0), 1e-12);
+    EXPECT_EQ(callResult.errorBound, 0.0);
+    EXPECT_EQ(callResult.lowerBound, callResult.upperBound);
+    EXPECT_EQ(PricingEngine::calculatePriceMomentMatching(put, spot, riskFreeRate, volatility).price, 0.0);
+
+    AsianOption geometric(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, 12);
+    MomentMatchingResult geometricResult = PricingEngine::calculatePriceMomentMatching(geometric, spot, riskFreeRate, volatility);
+    EXPECT_EQ(geometricResult.price, PricingEngine::calculatePriceGeometricClosedForm(geometric, spot, riskFreeRate, volatility));
+    EXPECT_EQ(geometricResult.errorBound, 0.0);
+}
+
+// Test case ensuring the batch form returns exactly the single-contract results across shared and distinct markets
+TEST(MomentMatchingTest, BatchMatchesSingleContracts) {
+    std::vector<AsianOption> options;
+    std::vector<MarketData> markets;
+    for (int i = 0; i < 40; ++i) {
+        Option::Type type = i % 2 == 0 ? Option::Type::Call : Option::Type::Put;
+        AsianOption::AveragingType averaging = i % 5 == 0 ? AsianOption::AveragingType::Geometric : AsianOption::AveragingType::Arithmetic;
+        options.emplace_back(80.0 + i, 1.0, type, averaging, i % 3 == 0 ? 52 : 12);
+        markets.push_back({i % 4 == 0 ? 105.0 : spot, riskFreeRate, volatility});
+    }
+    std::vector<MomentMatchingResult> batch = PricingEngine::calculatePricesMomentMatching(options, markets);
+    ASSERT_EQ(batch.size(), options.size());
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        MomentMatchingResult single = PricingEngine::calculatePriceMomentMatching(options[i], markets[i].spot, markets[i].riskFreeRate, markets[i].volatility);
+        EXPECT_EQ(batch[i].price, single.price);
+        EXPECT_EQ(batch[i].lowerBound, single.lowerBound);
+        EXPECT_EQ(batch[i].upperBound, single.upperBound);
+    }
+    markets.pop_back();
+    EXPECT_THROW(PricingEngine::calculatePricesMomentMatching(options, markets), std::invalid_argument);
+}
+
+// Test case ensuring each contract priced in strike lanes gets exactly its single-contract result, whatever shares its lane block,
+// with decided contracts and a short last block included
+TEST(MomentMatchingTest, LanesMatchSingleContracts) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    AverageDistribution distribution = makeAverageDistribution(option, spot, riskFreeRate, volatility);
+    std::vector<double> strikes;
+    std::vector<Option::Type> types;
+    for (int i = 0; i < 21; ++i) {
+        strikes.push_back(5.0 + 10.0 * i);
+        types.push_back(i % 3 == 0 ? Option::Type::Put : Option::Type::Call);
+    }
+    std::vector<MomentMatchingResult> lanes(strikes.size());
+    momentMatchingPayoffs(distribution, strikes.data(), types.data(), strikes.size(), lanes.data());
+    for (std::size_t i = 0; i < strikes.size(); ++i) {
+        MomentMatchingResult single = momentMatchingPayoff(distribution, strikes[i], types[i]);
+        EXPECT_EQ(lanes[i].price, single.price);
+        EXPECT_EQ(lanes[i].lognormalPrice, single.lognormalPrice);
+        EXPECT_EQ(lanes[i].lowerBound, single.lowerBound);
+        EXPECT_EQ(lanes[i].upperBound, single.upperBound);
+    }
+    EXPECT_EQ(lanes[0].errorBound, 0.0); // strike 5 is below today's share of the average, so the put is decided
+    EXPECT_GT(lanes[10].errorBound, 0.0);
+}
+
+// Test case ensuring the tiered quote keeps the approximation within tolerance and otherwise runs control-variate Monte Carlo
+TEST(MomentMatchingTest, TieredFallsBackOnlyBeyondTolerance) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    TieredResult quick = PricingEngine::calculatePriceTiered(option, spot, riskFreeRate, volatility, 0.01, 20000, seededConfig());
+    EXPECT_FALSE(quick.usedMonteCarlo);
+    EXPECT_EQ(quick.price.price, quick.approximation.price);
+    EXPECT_EQ(quick.price.pathsUsed, 0u);
+
+    TieredResult simulated = PricingEngine::calculatePriceTiered(option, spot, riskFreeRate, volatility, 1e-6, 20000, seededConfig());
+    EXPECT_TRUE(simulated.usedMonteCarlo);
+    PricingResult controlVariate = PricingEngine::calculatePriceControlVariate(option, spot, riskFreeRate, volatility, 20000, seededConfig());
+    EXPECT_EQ(simulated.price.price, controlVariate.price);
+    EXPECT_EQ(simulated.price.pathsUsed, 20000u);
+    EXPECT_NEAR(simulated.price.price, quick.price.price, quick.approximation.errorBound + 4.0 * controlVariate.standardError);
+}
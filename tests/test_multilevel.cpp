@@ -0,0 +1,149 @@
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Multilevel.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+#include "TestHelpers.hpp"
+
+namespace {
+
+double sum(const std::vector<double> &values) {
+    return std::accumulate(values.begin(), values.end(), 0.0);
+}
+
+} // namespace
+
+// Test case ensuring every level accounts for each remaining fixing exactly once, from one step on level 0 to the schedule itself
+TEST(MultilevelTest, GridsCoverEveryFixing) {
+    AsianOption daily(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 52);
+    AsianOption irregular(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, {0.1, 0.15, 0.4, 0.45, 0.5, 0.9, 1.0}, 3, 98.0);
+
+    for (const AsianOption *option : {&daily, &irregular}) {
+        KernelParameters parameters = makeKernelParameters(*option, spot, riskFreeRate, volatility);
+        unsigned int numLevels = multilevelLevels(parameters.numSteps);
+        EXPECT_EQ(1u << (numLevels - 1), parameters.numSteps <= 1 ? 1u : 1u << static_cast<unsigned int>(std::ceil(std::log2(parameters.numSteps))));
+
+        for (unsigned int level = 0; level < numLevels; ++level) {
+            MultilevelGrid grid = makeMultilevelGrid(parameters, level);
+            EXPECT_NEAR(sum(grid.weight), parameters.numSteps, 1e-12);
+            EXPECT_NEAR(sum(grid.drift), sum(parameters.drift), 1e-12);
+            if (level > 0) {
+                EXPECT_NEAR(sum(grid.coarseWeight), parameters.numSteps, 1e-12);
+                EXPECT_EQ(grid.coarseWeight.size(), grid.weight.size());
+            }
+        }
+        EXPECT_EQ(makeMultilevelGrid(parameters, 0).numSteps(), 1u);
+
+        MultilevelGrid finest = makeMultilevelGrid(parameters, numLevels - 1);
+        EXPECT_EQ(finest.numSteps(), parameters.numSteps);
+        EXPECT_EQ(finest.weight[0], 0.0);
+        for (unsigned int j = 0; j < parameters.numSteps; ++j) {
+            EXPECT_EQ(finest.weight[j + 1], 1.0);
+            EXPECT_NEAR(finest.diffusion[j], parameters.diffusion[j], 1e-15);
+        }
+        EXPECT_THROW(makeMultilevelGrid(parameters, numLevels), std::invalid_argument);
+    }
+}
+
+// Test case ensuring a level's coarse sums are exactly the coarser level's own sums on the same Brownian path
+TEST(MultilevelTest, CoarseSumsFollowTheSamePath) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+    unsigned int level = multilevelLevels(parameters.numSteps) - 1;
+    MultilevelGrid fineGrid = makeMultilevelGrid(parameters, level);
+    MultilevelGrid coarseGrid = makeMultilevelGrid(parameters, level - 1);
+
+    // Step j of the coarse grid spans fine steps 2j and 2j + 1 (the last may span one); its normal is their variance-weighted sum
+    std::vector<double> fineNormals(fineGrid.numSteps() * pathBlockWidth), coarseNormals(coarseGrid.numSteps() * pathBlockWidth, 0.0);
+    for (std::size_t i = 0; i < fineNormals.size(); ++i) {
+        fineNormals[i] = std::sin(1.7 * i + 0.3) * 1.5;
+    }
+    for (unsigned int j = 0, fine = 0; j < coarseGrid.numSteps(); ++j) {
+        double variance = 0.0;
+        for (double spanned = 0.0; spanned < coarseGrid.diffusion[j] * coarseGrid.diffusion[j] * (1.0 - 1e-12); ++fine) {
+            spanned += fineGrid.diffusion[fine] * fineGrid.diffusion[fine];
+            for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+                coarseNormals[j * pathBlockWidth + k] += fineGrid.diffusion[fine] * fineNormals[fine * pathBlockWidth + k];
+            }
+            variance = spanned;
+        }
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            coarseNormals[j * pathBlockWidth + k] /= std::sqrt(variance);
+        }
+    }
+
+    for (bool logarithms : {false, true}) {
+        double fine[pathBlockWidth], coarse[pathBlockWidth], coarseLevelFine[pathBlockWidth], unused[pathBlockWidth];
+        simulateMultilevelBlock(fineGrid, spot, logarithms, fineNormals.data(), fine, coarse);
+        simulateMultilevelBlock(coarseGrid, spot, logarithms, coarseNormals.data(), coarseLevelFine, unused);
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            EXPECT_NEAR(coarse[k], coarseLevelFine[k], 1e-9 * std::fabs(coarseLevelFine[k]));
+            EXPECT_NE(coarse[k], fine[k]);
+        }
+    }
+}
+
+// Test case ensuring a daily geometric contract prices within the target of its closed form, for much less work than plain Monte Carlo
+TEST(MultilevelTest, DailyGeometricMeetsTarget) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, 252);
+    MultilevelCriteria criteria;
+    criteria.targetError = 0.01;
+    MultilevelResult result = PricingEngine::calculatePriceMultilevel(option, spot, riskFreeRate, volatility, criteria, seededConfig());
+    double exact = PricingEngine::calculatePriceGeometricClosedForm(option, spot, riskFreeRate, volatility);
+
+    EXPECT_NEAR(result.price.price, exact, 3.0 * criteria.targetError);
+    EXPECT_LE(std::hypot(result.price.standardError, result.bias), criteria.targetError * 1.05);
+    EXPECT_GE(result.levels.size(), 3u);
+    EXPECT_EQ(result.levels.front().steps, 1u);
+    EXPECT_LT(5.0 * result.cost, result.singleLevelCost);
+
+    // Sample counts fall with the level, as the corrections' variance does
+    EXPECT_GT(result.levels[0].samples, result.levels[1].samples);
+    EXPECT_GT(result.levels[0].variance, result.levels[2].variance);
+}
+
+// Test case ensuring the arithmetic and put contracts agree with long control-variate runs on the full schedule
+TEST(MultilevelTest, MatchesSingleLevelPrices) {
+    AsianOption call(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 128);
+    AsianOption put(95.0, 2.0, Option::Type::Put, AsianOption::AveragingType::Arithmetic, 200);
+    MultilevelCriteria criteria;
+    criteria.targetError = 0.01;
+
+    for (const AsianOption *option : {&call, &put}) {
+        MultilevelResult result = PricingEngine::calculatePriceMultilevel(*option, spot, riskFreeRate, volatility, criteria, seededConfig());
+        PricingResult reference = PricingEngine::calculatePriceControlVariate(*option, spot, riskFreeRate, volatility, 100000, seededConfig());
+        EXPECT_NEAR(result.price.price, reference.price, 3.0 * criteria.targetError + 3.0 * reference.standardError);
+        EXPECT_LT(result.cost, result.singleLevelCost);
+    }
+}
+
+// Test case ensuring a run cut short by its sample cap on a coarse grid still reports the bias of stopping there
+TEST(MultilevelTest, BudgetCappedRunReportsBias) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 252);
+    MultilevelCriteria criteria;
+    criteria.targetError = 0.001;
+    criteria.maxSimulations = 3 * criteria.initialSamples;
+    MultilevelResult result = PricingEngine::calculatePriceMultilevel(option, spot, riskFreeRate, volatility, criteria, seededConfig());
+
+    KernelParameters parameters = makeKernelParameters(option, spot, riskFreeRate, volatility);
+    EXPECT_EQ(result.price.pathsUsed, criteria.maxSimulations);
+    EXPECT_LT(result.levels.size(), multilevelLevels(parameters.numSteps));
+    EXPECT_GT(result.bias, 0.0);
+}
+
+// Test case ensuring results do not depend on the number of threads, and that bad criteria are rejected
+TEST(MultilevelTest, ReproducibleAndValidated) {
+    AsianOption option(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 64);
+    MultilevelCriteria criteria;
+    criteria.targetError = 0.02;
+    MultilevelResult single = PricingEngine::calculatePriceMultilevel(option, spot, riskFreeRate, volatility, criteria, seededConfig(1));
+    MultilevelResult threaded = PricingEngine::calculatePriceMultilevel(option, spot, riskFreeRate, volatility, criteria, seededConfig(4));
+    EXPECT_EQ(single.price.price, threaded.price.price);
+    EXPECT_EQ(single.price.pathsUsed, threaded.price.pathsUsed);
+
+    criteria.targetError = 0.0;
+    EXPECT_THROW(PricingEngine::calculatePriceMultilevel(option, spot, riskFreeRate, volatility, criteria, seededConfig()), std::invalid_argument);
+}
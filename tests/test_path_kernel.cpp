@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/PathKernel.hpp"
+
+// Test case ensuring the vectorisable exp agrees with std::exp to within a few ulp across the supported range
+TEST(PathKernelTest, FastExpMatchesStdExp) {
+    for (double x = -700.0; x <= 700.0; x += 0.0731) {
+        double expected = std::exp(x);
+        EXPECT_NEAR(fastExp(x), expected, 4.0 * std::numeric_limits<double>::epsilon() * expected);
+    }
+    EXPECT_DOUBLE_EQ(fastExp(0.0), 1.0);
+}
+
+// Test case ensuring the block kernel matches a scalar loop stepping the same normals one path at a time
+TEST(PathKernelTest, BlockMatchesScalarPaths) {
+    double spot = 100.0;
+    double drift = 0.001;
+    double diffusion = 0.02;
+    unsigned int numSteps = 251;
+
+    std::vector<double> normals(numSteps * pathBlockWidth);
+    for (unsigned int i = 0; i < normals.size(); ++i) {
+        normals[i] = std::sin(0.37 * i);
+    }
+
+    double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+    simulatePathBlock(spot, drift, diffusion, normals.data(), numSteps, sumSpot, sumLogSpot);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        double spotPath = spot;
+        double expectedSum = spot;
+        double expectedLogSum = std::log(spot);
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            spotPath *= std::exp(drift + diffusion * normals[j * pathBlockWidth + k]);
+            expectedSum += spotPath;
+            expectedLogSum += std::log(spotPath);
+        }
+        EXPECT_NEAR(sumSpot[k], expectedSum, 1e-10 * expectedSum);
+        EXPECT_NEAR(sumLogSpot[k], expectedLogSum, 1e-10 * std::fabs(expectedLogSum));
+    }
+}
+
+// Test case ensuring the sensitivity kernel reproduces the block kernel's sums and accumulates the weighted sums it documents
+TEST(PathKernelTest, SensitivityBlockMatchesScalarPaths) {
+    double spot = 100.0;
+    double drift = 0.001;
+    double diffusion = 0.02;
+    unsigned int numSteps = 30;
+
+    std::vector<double> normals(numSteps * pathBlockWidth);
+    for (unsigned int i = 0; i < normals.size(); ++i) {
+        normals[i] = std::cos(0.61 * i);
+    }
+
+    double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth], sumSpotStep[pathBlockWidth], sumSpotNormal[pathBlockWidth], sumNormal[pathBlockWidth];
+    double blockSumSpot[pathBlockWidth], blockSumLogSpot[pathBlockWidth];
+    simulateSensitivityBlock(spot, drift, diffusion, normals.data(), numSteps, sumSpot, sumLogSpot, sumSpotStep, sumSpotNormal, sumNormal);
+    simulatePathBlock(spot, drift, diffusion, normals.data(), numSteps, blockSumSpot, blockSumLogSpot);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        EXPECT_DOUBLE_EQ(sumSpot[k], blockSumSpot[k]);
+        EXPECT_DOUBLE_EQ(sumLogSpot[k], blockSumLogSpot[k]);
+
+        double spotPath = spot, brownian = 0.0;
+        double expectedSpotStep = 0.0, expectedSpotNormal = 0.0, expectedNormal = 0.0;
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            spotPath *= std::exp(drift + diffusion * normals[j * pathBlockWidth + k]);
+            brownian += normals[j * pathBlockWidth + k];
+            expectedSpotStep += (j + 1) * spotPath;
+            expectedSpotNormal += spotPath * brownian;
+            expectedNormal += brownian;
+        }
+        EXPECT_NEAR(sumSpotStep[k], expectedSpotStep, 1e-10 * expectedSpotStep);
+        EXPECT_NEAR(sumSpotNormal[k], expectedSpotNormal, 1e-10 * std::fabs(expectedSpotStep));
+        EXPECT_NEAR(sumNormal[k], expectedNormal, 1e-10 * numSteps * numSteps);
+    }
+}
+
+// Test case ensuring a schedule advanced in tiles with constant coefficients reproduces the block kernel's fixings
+TEST(PathKernelTest, TilesMatchBlockKernel) {
+    const unsigned int numSteps = 20;
+    std::vector<double> normals(numSteps * pathBlockWidth);
+    for (std::size_t i = 0; i < normals.size(); ++i) {
+        normals[i] = std::sin(1.0 + 0.37 * i);
+    }
+    std::vector<double> drift(numSteps, 0.001), diffusion(numSteps, 0.04);
+
+    double logSpot[pathBlockWidth], spots[numSteps * pathBlockWidth], logSpots[numSteps * pathBlockWidth];
+    std::fill(logSpot, logSpot + pathBlockWidth, std::log(50.0));
+    advancePathTile(drift.data(), diffusion.data(), normals.data(), 12, logSpot, spots, logSpots);
+    advancePathTile(drift.data() + 12, diffusion.data() + 12, normals.data() + 12 * pathBlockWidth, numSteps - 12, logSpot,
+                    spots + 12 * pathBlockWidth, logSpots + 12 * pathBlockWidth);
+
+    double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth];
+    simulatePathBlock(50.0, 0.001, 0.04, normals.data(), numSteps, sumSpot, sumLogSpot);
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        double tiledSum = 50.0, tiledLogSum = std::log(50.0);
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            tiledSum += spots[j * pathBlockWidth + k];
+            tiledLogSum += logSpots[j * pathBlockWidth + k];
+        }
+        EXPECT_DOUBLE_EQ(tiledSum, sumSpot[k]);
+        EXPECT_DOUBLE_EQ(tiledLogSum, sumLogSpot[k]);
+        EXPECT_EQ(logSpot[k], logSpots[(numSteps - 1) * pathBlockWidth + k]);
+    }
+}
+
+// Test case ensuring the exp saturates outside [-708, 709] instead of building garbage exponent bits
+TEST(PathKernelTest, FastExpSaturatesOutsideRange) {
+    EXPECT_NEAR(fastExp(709.0), std::exp(709.0), 4.0 * std::numeric_limits<double>::epsilon() * std::exp(709.0));
+    EXPECT_EQ(fastExp(750.0), fastExp(709.0));
+    EXPECT_EQ(fastExp(1e6), fastExp(709.0));
+    EXPECT_TRUE(std::isfinite(fastExp(1e6)));
+    EXPECT_EQ(fastExp(-750.0), fastExp(-708.0));
+    EXPECT_GT(fastExp(-1e6), 0.0);
+    EXPECT_LT(fastExp(-1e6), 1e-300);
+}
+
+// Test case ensuring blocks whose log-spots cross the exp range, upwards on even paths and downwards on odd ones, saturate in every
+// kernel: each fixing is exp of its log-spot clamped to [-708, 709], and the sums stay finite and positive
+TEST(PathKernelTest, BlocksSaturateBeyondExpRange) {
+    const unsigned int numSteps = 71;
+    const double spot = 100.0;
+    std::vector<double> normals(numSteps * pathBlockWidth);
+    for (unsigned int j = 0; j < numSteps; ++j) {
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            normals[j * pathBlockWidth + k] = k % 2 == 0 ? 1.0 : -1.1;
+        }
+    }
+    std::vector<double> drift(numSteps, 0.0), diffusion(numSteps, 10.0); // log-spots reach 714.6 and -776.4
+
+    double sumSpot[pathBlockWidth], sumLogSpot[pathBlockWidth], scheduleSum[pathBlockWidth], scheduleLogSum[pathBlockWidth];
+    simulatePathBlock(spot, 0.0, 10.0, normals.data(), numSteps, sumSpot, sumLogSpot);
+    simulateScheduleBlock(spot, drift.data(), diffusion.data(), 1.0, normals.data(), numSteps, spot, std::log(spot), scheduleSum, scheduleLogSum);
+    double logSpot[pathBlockWidth], spots[numSteps * pathBlockWidth], logSpots[numSteps * pathBlockWidth];
+    std::fill(logSpot, logSpot + pathBlockWidth, std::log(spot));
+    advancePathTile(drift.data(), diffusion.data(), normals.data(), numSteps, logSpot, spots, logSpots);
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        double logPath = std::log(spot);
+        double expectedSum = spot;
+        for (unsigned int j = 0; j < numSteps; ++j) {
+            logPath += 10.0 * normals[j * pathBlockWidth + k];
+            double fixing = std::exp(std::min(std::max(logPath, -708.0), 709.0));
+            expectedSum += fixing;
+            EXPECT_NEAR(spots[j * pathBlockWidth + k], fixing, 1e-13 * fixing);
+        }
+        EXPECT_TRUE(std::isfinite(sumSpot[k]));
+        EXPECT_NEAR(sumSpot[k], expectedSum, 1e-13 * expectedSum);
+        EXPECT_EQ(scheduleSum[k], sumSpot[k]);
+        EXPECT_EQ(scheduleLogSum[k], sumLogSpot[k]);
+        EXPECT_NEAR(logSpot[k], logPath, 1e-9);
+    }
+}
@@ -0,0 +1,104 @@
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/AsianOption.hpp"
+#include "../src/PathStream.hpp"
+
+// Test case ensuring the step table holds the drift and diffusion of every gap between fixings, skipping a fixing today
+TEST(PathStreamTest, StepTableFromSchedule) {
+    StepTable table = makeStepTable(100.0, 0.05, 0.2, {0.0, 0.25, 1.0});
+    EXPECT_TRUE(table.spotIsFixing);
+    ASSERT_EQ(table.numSteps(), 2u);
+    EXPECT_EQ(table.numFixings(), 3u);
+    EXPECT_DOUBLE_EQ(table.drift[0], (0.05 - 0.02) * 0.25);
+    EXPECT_DOUBLE_EQ(table.drift[1], (0.05 - 0.02) * 0.75);
+    EXPECT_DOUBLE_EQ(table.diffusion[0], 0.2 * 0.5);
+    EXPECT_DOUBLE_EQ(table.diffusion[1], 0.2 * std::sqrt(0.75));
+
+    // Without a fixing today the first step starts from the spot
+    StepTable forward = makeStepTable(100.0, 0.05, 0.2, {0.5, 1.0});
+    EXPECT_FALSE(forward.spotIsFixing);
+    EXPECT_EQ(forward.numSteps(), 2u);
+    EXPECT_EQ(forward.numFixings(), 2u);
+    EXPECT_DOUBLE_EQ(forward.diffusion[0], 0.2 * std::sqrt(0.5));
+
+    // A fully fixed contract has nothing left to simulate
+    StepTable fixed = makeStepTable(100.0, 0.05, 0.2, {});
+    EXPECT_FALSE(fixed.spotIsFixing);
+    EXPECT_EQ(fixed.numFixings(), 0u);
+
+    EXPECT_THROW(makeStepTable(100.0, 0.05, 0.2, {-0.1, 1.0}), std::invalid_argument);
+    EXPECT_THROW(makeStepTable(100.0, 0.05, 0.2, {0.0, 0.5, 0.5}), std::invalid_argument);
+}
+
+// Test case ensuring the streamed paths match the block kernel on the same normals, across several tiles, for both generators
+TEST(PathStreamTest, StreamedPathsMatchBlockKernel) {
+    const unsigned int averagingPeriods = 3 * pathTileSteps + 7;
+    StepTable table = makeStepTable(100.0, 0.05, 0.3, AsianOption::uniformFixingTimes(1.0, averagingPeriods));
+    const unsigned int numSteps = table.numSteps();
+
+    PathArena arena;
+    for (RandomGenerator generator : {RandomGenerator::Philox, RandomGenerator::MersenneTwister}) {
+        NormalStream streamed(generator, 9, 2), drawn(generator, 9, 2);
+        ArenaScope scope(arena);
+        PathStreamer streamer(table, arena);
+
+        for (unsigned int width : {pathBlockWidth, 5u}) {
+            double sumSpot[pathBlockWidth] = {}, sumLogSpot[pathBlockWidth] = {};
+            unsigned int expectedFixing = 0;
+            streamer.simulateBlock(streamed, width, [&](unsigned int fixing, const double *spots, const double *logSpots) {
+                EXPECT_EQ(fixing, expectedFixing++);
+                for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+                    sumSpot[k] += spots[k];
+                    sumLogSpot[k] += logSpots[k];
+                }
+            });
+            EXPECT_EQ(expectedFixing, averagingPeriods);
+
+            // The same paths through the block kernel, with the normals transposed to its step-major layout
+            const double *pathNormals = drawn.draw(static_cast<std::size_t>(width) * numSteps);
+            std::vector<double> normals(numSteps * pathBlockWidth, 0.0);
+            for (unsigned int k = 0; k < width; ++k) {
+                for (unsigned int j = 0; j < numSteps; ++j) {
+                    normals[j * pathBlockWidth + k] = pathNormals[k * numSteps + j];
+                }
+            }
+            double blockSumSpot[pathBlockWidth], blockSumLogSpot[pathBlockWidth];
+            simulatePathBlock(100.0, table.drift[0], table.diffusion[0], normals.data(), numSteps, blockSumSpot, blockSumLogSpot);
+
+            for (unsigned int k = 0; k < width; ++k) {
+                EXPECT_NEAR(sumSpot[k], blockSumSpot[k], 1e-10 * blockSumSpot[k]);
+                EXPECT_NEAR(sumLogSpot[k], blockSumLogSpot[k], 1e-10 * std::fabs(blockSumLogSpot[k]));
+            }
+            EXPECT_EQ(streamed.tell(), drawn.tell());
+        }
+    }
+}
+
+// Test case ensuring a daily-averaged schedule stays finite: ten thousand fixings of a volatile path keep an exact log-sum
+TEST(PathStreamTest, LongScheduleLogSumsStayFinite) {
+    const unsigned int numFixings = 10000;
+    StepTable table = makeStepTable(1e-3, 0.0, 0.8, AsianOption::uniformFixingTimes(40.0, numFixings));
+    NormalStream stream(RandomGenerator::Philox, 1, 0);
+    PathArena arena;
+    PathStreamer streamer(table, arena);
+
+    double sumLogSpot[pathBlockWidth] = {};
+    double productSpot[pathBlockWidth];
+    std::fill(productSpot, productSpot + pathBlockWidth, 1.0);
+    streamer.simulateBlock(stream, pathBlockWidth, [&](unsigned int, const double *spots, const double *logSpots) {
+        for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+            sumLogSpot[k] += logSpots[k];
+            productSpot[k] *= spots[k];
+        }
+    });
+
+    for (unsigned int k = 0; k < pathBlockWidth; ++k) {
+        // The product of the fixings leaves the range of a double; the log-sum does not
+        EXPECT_TRUE(productSpot[k] == 0.0 || std::isinf(productSpot[k]));
+        EXPECT_TRUE(std::isfinite(sumLogSpot[k]));
+        EXPECT_GT(std::exp(sumLogSpot[k] / numFixings), 0.0);
+    }
+}
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/PriceCache.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+
+namespace {
+
+const double riskFreeRate = 0.05;
+
+AsianOption cacheOption(double strike = 100.0) {
+    return AsianOption(strike, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, 12);
+}
+
+PriceCacheConfig smallConfig() {
+    PriceCacheConfig config;
+    config.spotPoints = 9;
+    config.volatilityPoints = 5;
+    config.numSimulations = 8192;
+    config.simulation.seed = 11;
+    config.simulation.numThreads = 2;
+    return config;
+}
+
+} // namespace
+
+// Test case ensuring the surface passes through its nodes, which are exactly the GBM prices with the same configuration
+TEST(PriceCacheTest, SurfaceReproducesNodes) {
+    AsianOption option = cacheOption();
+    SimulationConfig config;
+    config.seed = 5;
+    GridAxis spotAxis{80.0, 120.0, 5};
+    GridAxis volatilityAxis{0.1, 0.3, 3};
+    PriceSurface surface(option, riskFreeRate, spotAxis, volatilityAxis, 4096, config);
+
+    for (unsigned int i = 0; i < spotAxis.points; ++i) {
+        for (unsigned int j = 0; j < volatilityAxis.points; ++j) {
+            double direct = PricingEngine::calculatePriceGBM(option, spotAxis.node(i), riskFreeRate, volatilityAxis.node(j), 4096, config).price;
+            EXPECT_EQ(surface.nodePrice(i, j), direct);
+            EXPECT_NEAR(surface.quote(spotAxis.node(i), volatilityAxis.node(j)).price, direct, 1e-12 * direct);
+        }
+    }
+    EXPECT_THROW(surface.quote(79.0, 0.2), std::out_of_range);
+    EXPECT_THROW(PriceSurface(option, riskFreeRate, GridAxis{80.0, 120.0, 1}, volatilityAxis, 10, config), std::invalid_argument);
+    EXPECT_THROW(PriceSurface(option, riskFreeRate, spotAxis, GridAxis{0.0, 0.3, 3}, 10, config), std::invalid_argument);
+}
+
+// Test case ensuring interpolated prices and sensitivities between nodes agree with the geometric closed form and its derivatives
+TEST(PriceCacheTest, InterpolationMatchesClosedForm) {
+    AsianOption option = cacheOption();
+    PriceCacheConfig config = smallConfig();
+    config.numSimulations = 100000;
+    PriceCache cache(config);
+
+    auto closedForm = [&](double spot, double volatility) {
+        return PricingEngine::calculatePriceGeometricClosedForm(option, spot, riskFreeRate, volatility);
+    };
+    for (double spot : {100.0, 97.3, 104.1}) {
+        for (double volatility : {0.2, 0.17, 0.26}) {
+            SurfaceQuote quote = cache.quote(option, spot, riskFreeRate, volatility);
+            double h = 1e-3 * spot, v = 1e-4;
+            EXPECT_NEAR(quote.price, closedForm(spot, volatility), 0.05);
+            EXPECT_NEAR(quote.delta, (closedForm(spot + h, volatility) - closedForm(spot - h, volatility)) / (2.0 * h), 0.005);
+            EXPECT_NEAR(quote.gamma, (closedForm(spot + h, volatility) - 2.0 * closedForm(spot, volatility) + closedForm(spot - h, volatility)) / (h * h), 0.002);
+            EXPECT_NEAR(quote.vega, (closedForm(spot, volatility + v) - closedForm(spot, volatility - v)) / (2.0 * v), 0.3);
+        }
+    }
+
+    // One surface answered every query
+    PriceCacheStatistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.builds, 1u);
+    EXPECT_EQ(statistics.hits, 8u);
+}
+
+// Test case ensuring a query outside its contract's grid rebuilds that surface around the new inputs
+TEST(PriceCacheTest, LeavingTheGridInvalidates) {
+    PriceCache cache(smallConfig());
+    AsianOption option = cacheOption();
+    cache.quote(option, 100.0, riskFreeRate, 0.2);
+    cache.quote(option, 110.0, riskFreeRate, 0.25);
+    EXPECT_EQ(cache.getStatistics().invalidations, 0u);
+
+    SurfaceQuote moved = cache.quote(option, 130.0, riskFreeRate, 0.2);
+    PriceCacheStatistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.invalidations, 1u);
+    EXPECT_EQ(statistics.entries, 1u);
+    EXPECT_GT(moved.price, 0.0);
+
+    // A different rate is a different key
+    cache.quote(option, 130.0, 0.03, 0.2);
+    EXPECT_EQ(cache.getStatistics().builds, 2u);
+}
+
+// Test case ensuring the cache stays within its memory bound by dropping the least recently used surfaces
+TEST(PriceCacheTest, EvictsLeastRecentlyUsed) {
+    PriceCacheConfig config = smallConfig();
+    config.numSimulations = 512;
+    config.maxBytes = 3 * (sizeof(PriceSurface) + 4 * config.spotPoints * config.volatilityPoints * sizeof(double) + 12 * sizeof(double));
+    PriceCache cache(config);
+
+    for (double strike : {90.0, 100.0, 110.0}) {
+        cache.quote(cacheOption(strike), 100.0, riskFreeRate, 0.2);
+    }
+    cache.quote(cacheOption(90.0), 100.0, riskFreeRate, 0.2); // 100 is now the oldest
+    cache.quote(cacheOption(120.0), 100.0, riskFreeRate, 0.2);
+
+    PriceCacheStatistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.entries, 3u);
+    EXPECT_EQ(statistics.evictions, 1u);
+    EXPECT_LE(statistics.bytes, config.maxBytes);
+
+    cache.quote(cacheOption(90.0), 100.0, riskFreeRate, 0.2);
+    EXPECT_EQ(cache.getStatistics().builds, 4u);
+    cache.quote(cacheOption(100.0), 100.0, riskFreeRate, 0.2);
+    EXPECT_EQ(cache.getStatistics().builds, 5u);
+
+    cache.clear();
+    EXPECT_EQ(cache.getStatistics().bytes, 0u);
+
+    PriceCacheConfig tiny = smallConfig();
+    tiny.maxBytes = 64;
+    EXPECT_THROW(PriceCache cache(tiny), std::invalid_argument);
+}
+
+// Test case ensuring simultaneous misses on one contract share a single build, and a failed build leaves nothing behind
+TEST(PriceCacheTest, ConcurrentMissesShareOneBuild) {
+    PriceCache cache(smallConfig());
+    AsianOption option = cacheOption();
+    std::vector<std::future<SurfaceQuote>> quotes;
+    for (int i = 0; i < 6; ++i) {
+        quotes.push_back(std::async(std::launch::async, [&]() { return cache.quote(option, 100.0, riskFreeRate, 0.2); }));
+    }
+    double price = quotes.front().get().price;
+    for (std::size_t i = 1; i < quotes.size(); ++i) {
+        EXPECT_EQ(quotes[i].get().price, price);
+    }
+    PriceCacheStatistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.builds, 1u);
+    EXPECT_EQ(statistics.hits, 5u);
+    EXPECT_EQ(statistics.entries, 1u);
+
+    AsianOption other = cacheOption(110.0);
+    EXPECT_THROW(cache.quote(other, 100.0, riskFreeRate, 0.0), std::invalid_argument);
+    EXPECT_GT(cache.quote(other, 100.0, riskFreeRate, 0.2).price, 0.0);
+    EXPECT_EQ(cache.getStatistics().builds, 3u);
+    EXPECT_EQ(cache.getStatistics().entries, 2u);
+}
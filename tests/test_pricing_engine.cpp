@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include "gtest/gtest.h"
 #include "../src/PricingEngine.hpp"
 #include "../src/AsianOption.hpp"
@@ -182,4 +184,542 @@ TEST_F(PricingEngineTest, GBMCallEdgeCaseExpiry) {
     double GBMPriceGeometric = PricingEngine::calculatePriceGBM(*callOptionEdgeG, spot_price, risk_free_rate, volatility,num_simulations);
     EXPECT_NEAR(GBMPriceArithmetic, 0.0, 0.00001);
     EXPECT_NEAR(GBMPriceGeometric, 0.0, 0.00001);
-}
\ No newline at end of file
+}
+
+// Test case ensuring that a seeded run returns bit-identical prices regardless of the number of threads used
+TEST_F(PricingEngineTest, SeededPriceIndependentOfThreads) {
+    SimulationConfig singleThread;
+    singleThread.seed = 42;
+    SimulationConfig multiThread = singleThread;
+    multiThread.numThreads = 4;
+
+    double naiveSingle = PricingEngine::calculatePriceNaive(*callOption, spot_price, risk_free_rate, volatility, num_simulations, singleThread).price;
+    double naiveMulti = PricingEngine::calculatePriceNaive(*callOption, spot_price, risk_free_rate, volatility, num_simulations, multiThread).price;
+    double antitheticSingle = PricingEngine::calculatePriceAntithetic(*putOptionG, spot_price, risk_free_rate, volatility, num_simulations, singleThread).price;
+    double antitheticMulti = PricingEngine::calculatePriceAntithetic(*putOptionG, spot_price, risk_free_rate, volatility, num_simulations, multiThread).price;
+    double GBMSingle = PricingEngine::calculatePriceGBM(*callOptionG, spot_price, risk_free_rate, volatility, num_simulations, singleThread).price;
+    double GBMMulti = PricingEngine::calculatePriceGBM(*callOptionG, spot_price, risk_free_rate, volatility, num_simulations, multiThread).price;
+    EXPECT_EQ(naiveSingle, naiveMulti);
+    EXPECT_EQ(antitheticSingle, antitheticMulti);
+    EXPECT_EQ(GBMSingle, GBMMulti);
+}
+
+// Test case ensuring that different seeds produce different (but close) prices
+TEST_F(PricingEngineTest, DifferentSeedsDiffer) {
+    SimulationConfig config1;
+    config1.seed = 1;
+    SimulationConfig config2;
+    config2.seed = 2;
+
+    double price1 = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, num_simulations, config1).price;
+    double price2 = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, num_simulations, config2).price;
+    EXPECT_NE(price1, price2);
+    EXPECT_NEAR(price1, price2, 0.1);
+}
+
+// Test case ensuring the vectorised GBM engine reproduces the scalar naive loop when both consume the same seeded normals
+TEST_F(PricingEngineTest, VectorisedGBMMatchesScalarNaive) {
+    SimulationConfig config;
+    config.seed = 7;
+    AsianOption dailyCall(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 252);
+
+    double naiveArithmetic = PricingEngine::calculatePriceNaive(dailyCall, spot_price, risk_free_rate, volatility, 10001, config).price;
+    double GBMArithmetic = PricingEngine::calculatePriceGBM(dailyCall, spot_price, risk_free_rate, volatility, 10001, config).price;
+    double naiveGeometric = PricingEngine::calculatePriceNaive(*putOptionG, spot_price, risk_free_rate, volatility, 10001, config).price;
+    double GBMGeometric = PricingEngine::calculatePriceGBM(*putOptionG, spot_price, risk_free_rate, volatility, 10001, config).price;
+    EXPECT_NEAR(naiveArithmetic, GBMArithmetic, 1e-9);
+    EXPECT_NEAR(naiveGeometric, GBMGeometric, 1e-9);
+}
+
+// Test case ensuring batch pricing over shared path sets reproduces the individual GBM prices exactly
+TEST_F(PricingEngineTest, BatchMatchesIndividualGBM) {
+    SimulationConfig config;
+    config.seed = 11;
+    config.numThreads = 3;
+
+    std::vector<AsianOption> options = {*callOption, *putOption, *callOptionG, *putOptionG, *callOptionEdge,
+                                        AsianOption(95.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 10)};
+    std::vector<MarketData> marketData(options.size(), MarketData{spot_price, risk_free_rate, volatility});
+    marketData[3].volatility = 0.3;
+
+    std::vector<PricingResult> results = PricingEngine::calculatePricesBatch(options, marketData, 20000, config);
+    ASSERT_EQ(results.size(), options.size());
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        PricingResult individual = PricingEngine::calculatePriceGBM(options[i], marketData[i].spot, marketData[i].riskFreeRate, marketData[i].volatility, 20000, config);
+        EXPECT_EQ(results[i].price, individual.price);
+        EXPECT_EQ(results[i].standardError, individual.standardError);
+    }
+}
+
+TEST_F(PricingEngineTest, BatchRejectsMismatchedInputs) {
+    std::vector<AsianOption> options = {*callOption, *putOption};
+    std::vector<MarketData> marketData(1, MarketData{spot_price, risk_free_rate, volatility});
+    EXPECT_THROW(PricingEngine::calculatePricesBatch(options, marketData, 1000, SimulationConfig()), std::invalid_argument);
+}
+
+// Test case ensuring the closed-form geometric price agrees with a large Monte Carlo run and satisfies put-call parity
+TEST_F(PricingEngineTest, GeometricClosedFormMatchesMonteCarlo) {
+    SimulationConfig config;
+    config.seed = 3;
+    config.numThreads = 4;
+
+    double closedFormCall = PricingEngine::calculatePriceGeometricClosedForm(*callOptionG, spot_price, risk_free_rate, volatility);
+    double closedFormPut = PricingEngine::calculatePriceGeometricClosedForm(*putOptionG, spot_price, risk_free_rate, volatility);
+    double monteCarloCall = PricingEngine::calculatePriceGBM(*callOptionG, spot_price, risk_free_rate, volatility, 400000, config).price;
+    double monteCarloPut = PricingEngine::calculatePriceGBM(*putOptionG, spot_price, risk_free_rate, volatility, 400000, config).price;
+    EXPECT_NEAR(closedFormCall, monteCarloCall, 0.05);
+    EXPECT_NEAR(closedFormPut, monteCarloPut, 0.05);
+
+    // C - P = exp(-rT) (E[G] - K), with E[G] from the moments of log G for 10 equally spaced fixings starting at t = 0
+    double meanLog = std::log(spot_price) + (risk_free_rate - 0.5 * volatility * volatility) * 0.45;
+    double varianceLog = volatility * volatility * 0.1 * 9.0 * 10.0 * 19.0 / 6.0 / 100.0;
+    double forward = std::exp(meanLog + 0.5 * varianceLog);
+    EXPECT_NEAR(closedFormCall - closedFormPut, std::exp(-risk_free_rate) * (forward - 105.0), 1e-10);
+}
+
+TEST_F(PricingEngineTest, GeometricClosedFormRejectsArithmetic) {
+    EXPECT_THROW(PricingEngine::calculatePriceGeometricClosedForm(*callOption, spot_price, risk_free_rate, volatility), std::invalid_argument);
+}
+
+// Test case ensuring the control variate estimate agrees with plain Monte Carlo and is far less noisy across seeds
+TEST_F(PricingEngineTest, ControlVariateReducesNoise) {
+    SimulationConfig reference;
+    reference.seed = 5;
+    reference.numThreads = 4;
+    double referencePrice = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 1000000, reference).price;
+
+    double maxErrorControlVariate = 0.0;
+    double maxErrorGBM = 0.0;
+    for (std::uint64_t seed = 100; seed < 110; ++seed) {
+        SimulationConfig config;
+        config.seed = seed;
+        maxErrorControlVariate = std::max(maxErrorControlVariate, std::fabs(PricingEngine::calculatePriceControlVariate(*callOption, spot_price, risk_free_rate, volatility, 5000, config).price - referencePrice));
+        maxErrorGBM = std::max(maxErrorGBM, std::fabs(PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 5000, config).price - referencePrice));
+    }
+    EXPECT_LT(maxErrorControlVariate, 0.05);
+    EXPECT_LT(maxErrorControlVariate, maxErrorGBM);
+
+    // For a geometric option the control is the payoff itself, so the estimate collapses onto the closed form
+    double controlVariateGeometric = PricingEngine::calculatePriceControlVariate(*callOptionG, spot_price, risk_free_rate, volatility, 5000, reference).price;
+    EXPECT_NEAR(controlVariateGeometric, PricingEngine::calculatePriceGeometricClosedForm(*callOptionG, spot_price, risk_free_rate, volatility), 1e-9);
+}
+
+// Test case ensuring the reported standard error matches the spread of prices across seeds and its interval covers the exact price
+TEST_F(PricingEngineTest, StandardErrorMatchesSpreadAcrossSeeds) {
+    double exactPrice = PricingEngine::calculatePriceGeometricClosedForm(*callOptionG, spot_price, risk_free_rate, volatility);
+
+    RunningStatistics prices;
+    double meanStandardError = 0.0;
+    unsigned int covered = 0;
+    const unsigned int numRuns = 40;
+    for (std::uint64_t seed = 0; seed < numRuns; ++seed) {
+        SimulationConfig config;
+        config.seed = seed;
+        PricingResult result = PricingEngine::calculatePriceGBM(*callOptionG, spot_price, risk_free_rate, volatility, 5000, config);
+        EXPECT_EQ(result.pathsUsed, 5000u);
+        EXPECT_GE(result.wallTime, 0.0);
+        prices.add(result.price);
+        meanStandardError += result.standardError / numRuns;
+        std::pair<double, double> interval = result.confidenceInterval(3.0);
+        covered += interval.first <= exactPrice && exactPrice <= interval.second;
+    }
+    EXPECT_NEAR(std::sqrt(prices.getVariance()), meanStandardError, 0.35 * meanStandardError);
+    EXPECT_GE(covered, numRuns - 1);
+}
+
+// Test case ensuring the control variate reports a much smaller standard error than plain Monte Carlo on the same paths
+TEST_F(PricingEngineTest, ControlVariateStandardErrorSmaller) {
+    SimulationConfig config;
+    config.seed = 9;
+    PricingResult plain = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 20000, config);
+    PricingResult controlled = PricingEngine::calculatePriceControlVariate(*callOption, spot_price, risk_free_rate, volatility, 20000, config);
+    EXPECT_GT(controlled.standardError, 0.0);
+    EXPECT_LT(controlled.standardError * 10.0, plain.standardError);
+    EXPECT_NEAR(controlled.price, plain.price, 4.0 * plain.standardError);
+}
+
+// Test case ensuring an adaptive run stops once the target standard error is met, well before the sample cap
+TEST_F(PricingEngineTest, AdaptiveStopsAtTargetError) {
+    SimulationConfig config;
+    config.seed = 21;
+    StoppingCriteria criteria;
+    criteria.absoluteError = 0.02;
+
+    PricingResult result = PricingEngine::calculatePriceAdaptive(PricingEngine::Method::GBM, *callOption, spot_price, risk_free_rate, volatility, criteria, config);
+    EXPECT_LE(result.standardError, 0.02);
+    EXPECT_LT(result.pathsUsed, criteria.maxSimulations);
+    EXPECT_GT(result.pathsUsed, 0u);
+
+    // The control variate converges far sooner on the same target
+    PricingResult controlled = PricingEngine::calculatePriceAdaptive(PricingEngine::Method::ControlVariate, *callOption, spot_price, risk_free_rate, volatility, criteria, config);
+    EXPECT_LE(controlled.standardError, 0.02);
+    EXPECT_LT(controlled.pathsUsed, result.pathsUsed);
+    EXPECT_NEAR(controlled.price, result.price, 4.0 * result.standardError);
+
+    // A relative target is met as well
+    StoppingCriteria relative;
+    relative.relativeError = 0.01;
+    PricingResult relativeResult = PricingEngine::calculatePriceAdaptive(PricingEngine::Method::Antithetic, *putOption, spot_price, risk_free_rate, volatility, relative, config);
+    EXPECT_LE(relativeResult.standardError, 0.01 * relativeResult.price);
+}
+
+// Test case ensuring a time budget stops the run close to the deadline with the estimate so far
+TEST_F(PricingEngineTest, AdaptiveHonoursTimeBudget) {
+    SimulationConfig config;
+    config.seed = 22;
+    StoppingCriteria criteria;
+    criteria.absoluteError = 1e-6; // unreachable in the budget
+    criteria.timeBudget = 0.05;
+
+    PricingResult result = PricingEngine::calculatePriceAdaptive(PricingEngine::Method::Naive, *callOption, spot_price, risk_free_rate, volatility, criteria, config);
+    EXPECT_LT(result.wallTime, 0.1);
+    EXPECT_GT(result.pathsUsed, 0u);
+    EXPECT_GT(result.price, 0.0);
+}
+
+// Test case ensuring pooling batches run on consecutive chunks reproduces a single run over the same paths
+TEST_F(PricingEngineTest, ContinuedRunsPoolToSingleRun) {
+    SimulationConfig config;
+    config.seed = 23;
+    SimulationConfig continued = config;
+    continued.firstChunk = 3;
+
+    PricingResult whole = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 5 * PricingEngine::pathsPerChunk, config);
+    PricingResult pooled = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 3 * PricingEngine::pathsPerChunk, config);
+    pooled += PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 2 * PricingEngine::pathsPerChunk, continued);
+    EXPECT_EQ(pooled.pathsUsed, whole.pathsUsed);
+    EXPECT_NEAR(pooled.price, whole.price, 1e-12);
+    EXPECT_NEAR(pooled.standardError, whole.standardError, 1e-12);
+}
+
+// Test case ensuring randomised QMC matches the closed-form geometric price with a far smaller error than Monte Carlo on the same budget
+TEST_F(PricingEngineTest, QuasiMonteCarloConvergesFaster) {
+    SimulationConfig config;
+    config.seed = 31;
+    config.numThreads = 2;
+
+    double exactPrice = PricingEngine::calculatePriceGeometricClosedForm(*callOptionG, spot_price, risk_free_rate, volatility);
+    PricingResult quasi = PricingEngine::calculatePriceQuasiMonteCarlo(*callOptionG, spot_price, risk_free_rate, volatility, 4096, 16, config);
+    PricingResult monteCarlo = PricingEngine::calculatePriceGBM(*callOptionG, spot_price, risk_free_rate, volatility, 4096 * 16, config);
+
+    EXPECT_EQ(quasi.pathsUsed, 4096u * 16u);
+    EXPECT_NEAR(quasi.price, exactPrice, 4.0 * quasi.standardError + 1e-4);
+    EXPECT_LT(quasi.standardError * 5.0, monteCarlo.standardError);
+
+    // Arithmetic puts converge too
+    PricingResult quasiPut = PricingEngine::calculatePriceQuasiMonteCarlo(*putOption, spot_price, risk_free_rate, volatility, 4096, 16, config);
+    PricingResult controlPut = PricingEngine::calculatePriceControlVariate(*putOption, spot_price, risk_free_rate, volatility, 200000, config);
+    EXPECT_NEAR(quasiPut.price, controlPut.price, 4.0 * (quasiPut.standardError + controlPut.standardError));
+}
+
+// Test case ensuring single-pass Greeks of a geometric option match central differences of the closed form
+TEST_F(PricingEngineTest, PathwiseGreeksMatchClosedForm) {
+    SimulationConfig config;
+    config.seed = 8;
+    config.numThreads = 2;
+
+    for (AsianOption *option : {callOptionG, putOptionG}) {
+        auto exact = [&](double spot, double rate, double vol) {
+            return PricingEngine::calculatePriceGeometricClosedForm(*option, spot, rate, vol);
+        };
+        double h = 1e-3;
+        double delta = (exact(spot_price + h, risk_free_rate, volatility) - exact(spot_price - h, risk_free_rate, volatility)) / (2.0 * h);
+        double gamma = (exact(spot_price + 0.1, risk_free_rate, volatility) - 2.0 * exact(spot_price, risk_free_rate, volatility)
+                        + exact(spot_price - 0.1, risk_free_rate, volatility)) / 0.01;
+        double vega = (exact(spot_price, risk_free_rate, volatility + h) - exact(spot_price, risk_free_rate, volatility - h)) / (2.0 * h);
+        double rho = (exact(spot_price, risk_free_rate + h, volatility) - exact(spot_price, risk_free_rate - h, volatility)) / (2.0 * h);
+
+        Greeks greeks = PricingEngine::calculateGreeks(*option, spot_price, risk_free_rate, volatility, 200000, config);
+        EXPECT_NEAR(greeks.delta.price, delta, 4.0 * greeks.delta.standardError);
+        EXPECT_NEAR(greeks.gamma.price, gamma, 4.0 * greeks.gamma.standardError);
+        EXPECT_NEAR(greeks.vega.price, vega, 4.0 * greeks.vega.standardError);
+        EXPECT_NEAR(greeks.rho.price, rho, 4.0 * greeks.rho.standardError);
+
+        // The price comes from the same paths as calculatePriceGBM
+        PricingResult price = PricingEngine::calculatePriceGBM(*option, spot_price, risk_free_rate, volatility, 200000, config);
+        EXPECT_NEAR(greeks.price.price, price.price, 1e-10);
+    }
+}
+
+// Test case ensuring pathwise/likelihood-ratio and common-random-number bump Greeks agree for arithmetic options
+TEST_F(PricingEngineTest, PathwiseGreeksMatchBumpAndReprice) {
+    SimulationConfig config;
+    config.seed = 9;
+
+    for (AsianOption *option : {callOption, putOption}) {
+        Greeks pathwise = PricingEngine::calculateGreeks(*option, spot_price, risk_free_rate, volatility, 100000, config);
+        Greeks bumped = PricingEngine::calculateGreeks(*option, spot_price, risk_free_rate, volatility, 100000, config, PricingEngine::GreeksMethod::BumpAndReprice);
+
+        // Same paths, so the smooth sensitivities agree far inside their standard errors
+        EXPECT_DOUBLE_EQ(pathwise.price.price, bumped.price.price);
+        EXPECT_NEAR(pathwise.delta.price, bumped.delta.price, pathwise.delta.standardError);
+        EXPECT_NEAR(pathwise.vega.price, bumped.vega.price, pathwise.vega.standardError);
+        EXPECT_NEAR(pathwise.rho.price, bumped.rho.price, pathwise.rho.standardError);
+        EXPECT_NEAR(pathwise.gamma.price, bumped.gamma.price, 4.0 * (pathwise.gamma.standardError + bumped.gamma.standardError));
+        EXPECT_GT(pathwise.gamma.price, 0.0);
+    }
+}
+
+// Test case ensuring adjoint Greeks reproduce the pathwise ones on the same paths, whatever the checkpoint interval
+TEST_F(PricingEngineTest, AdjointGreeksMatchPathwise) {
+    SimulationConfig config;
+    config.seed = 10;
+    config.numThreads = 2;
+    AsianOption longOption(105.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Arithmetic, 52);
+
+    for (AsianOption *option : {callOption, callOptionG, &longOption}) {
+        Greeks pathwise = PricingEngine::calculateGreeks(*option, spot_price, risk_free_rate, volatility, 20000, config);
+        for (unsigned int checkpointSteps : {1u, 7u, 64u}) {
+            AdjointGreeks adjoint = PricingEngine::calculateGreeksAdjoint(*option, spot_price, risk_free_rate, volatility, 20000, config, checkpointSteps);
+            EXPECT_NEAR(adjoint.price.price, pathwise.price.price, 1e-10);
+            EXPECT_NEAR(adjoint.delta.price, pathwise.delta.price, 1e-10);
+            EXPECT_NEAR(adjoint.vega.price, pathwise.vega.price, 1e-8);
+            EXPECT_NEAR(adjoint.rho.price, pathwise.rho.price, 1e-8);
+            EXPECT_EQ(adjoint.fixingTimes.size(), option->getAveragingPeriods() - 1);
+        }
+    }
+}
+
+// Test case ensuring the date sensitivities are consistent: discounting alone gives dV/dT = -rV, and rescaling time by a factor
+// while dividing the rate by it and the volatility by its square root leaves every path unchanged, so
+// T dV/dT + sum_i t_i dV/dt_i - (sigma / 2) dV/dsigma - r dV/dr = 0
+TEST_F(PricingEngineTest, AdjointFixingSensitivitiesSatisfyTimeScaling) {
+    SimulationConfig config;
+    config.seed = 11;
+    AdjointGreeks greeks = PricingEngine::calculateGreeksAdjoint(*callOption, spot_price, risk_free_rate, volatility, 20000, config);
+
+    EXPECT_NEAR(greeks.expiry.price, -risk_free_rate * greeks.price.price, 1e-12);
+
+    double expiry = callOption->getExpiry();
+    double dt = expiry / callOption->getAveragingPeriods();
+    double identity = expiry * greeks.expiry.price - 0.5 * volatility * greeks.vega.price - risk_free_rate * greeks.rho.price;
+    for (unsigned int i = 0; i < greeks.fixingTimes.size(); ++i) {
+        identity += (i + 1) * dt * greeks.fixingTimes[i].price;
+    }
+    EXPECT_NEAR(identity, 0.0, 1e-10);
+
+    EXPECT_THROW(PricingEngine::calculateGreeksAdjoint(*callOption, spot_price, risk_free_rate, volatility, 1000, config, 0), std::invalid_argument);
+}
+
+// A contract the engines do not support
+class DigitalOption : public Option {
+public:
+    DigitalOption() : Option(100.0, 1.0, Option::Type::Call) {}
+    double payoff(double underlyingPrice) const override { return underlyingPrice > strike ? 1.0 : 0.0; }
+};
+
+// Test case ensuring every engine rejects a non-Asian option instead of returning garbage
+TEST_F(PricingEngineTest, NonAsianOptionThrows) {
+    DigitalOption digital;
+    SimulationConfig config;
+    EXPECT_THROW(PricingEngine::calculatePriceNaive(digital, spot_price, risk_free_rate, volatility, 1000), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceAntithetic(digital, spot_price, risk_free_rate, volatility, 1000), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceGBM(digital, spot_price, risk_free_rate, volatility, 1000), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceControlVariate(digital, spot_price, risk_free_rate, volatility, 1000, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceQuasiMonteCarlo(digital, spot_price, risk_free_rate, volatility, 1000, 2, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculateGreeks(digital, spot_price, risk_free_rate, volatility, 1000, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculateGreeksAdjoint(digital, spot_price, risk_free_rate, volatility, 1000, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceGeometricClosedForm(digital, spot_price, risk_free_rate, volatility), std::invalid_argument);
+}
+
+// Test case ensuring every running estimate of a convergence sweep equals an independent run with that many paths
+TEST_F(PricingEngineTest, ConvergenceMatchesIndependentRuns) {
+    SimulationConfig config;
+    config.seed = 2024;
+    config.numThreads = 3;
+    // Checkpoints inside the first chunk, on a chunk boundary, in the same later chunk and several chunks apart
+    std::vector<unsigned int> checkpoints = {1, 7, 1000, 4096, 5000, 6001, 20000};
+
+    for (PricingEngine::Method method : {PricingEngine::Method::Naive, PricingEngine::Method::Antithetic, PricingEngine::Method::GBM}) {
+        std::vector<PricingResult> running = PricingEngine::calculatePriceConvergence(method, *putOption, spot_price, risk_free_rate, volatility, checkpoints, config);
+        ASSERT_EQ(running.size(), checkpoints.size());
+        for (std::size_t i = 0; i < checkpoints.size(); ++i) {
+            PricingResult independent = PricingEngine::calculatePrice(method, *putOption, spot_price, risk_free_rate, volatility, checkpoints[i], config);
+            EXPECT_EQ(running[i].price, independent.price);
+            EXPECT_EQ(running[i].variance, independent.variance);
+            EXPECT_EQ(running[i].pathsUsed, checkpoints[i]);
+        }
+    }
+}
+
+// Test case ensuring a convergence sweep rejects unordered checkpoints and methods without a running estimate
+TEST_F(PricingEngineTest, ConvergenceRejectsInvalidInput) {
+    SimulationConfig config;
+    EXPECT_THROW(PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, *callOption, spot_price, risk_free_rate, volatility, {1000, 1000}, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, *callOption, spot_price, risk_free_rate, volatility, {0, 1000}, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceConvergence(PricingEngine::Method::GBM, *callOption, spot_price, risk_free_rate, volatility, {}, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculatePriceConvergence(PricingEngine::Method::ControlVariate, *callOption, spot_price, risk_free_rate, volatility, {1000}, config), std::invalid_argument);
+}
+
+// Test case ensuring the Philox and Mersenne Twister generators price the same contract consistently
+TEST_F(PricingEngineTest, GeneratorsAgree) {
+    SimulationConfig philox;
+    philox.seed = 99;
+    SimulationConfig mersenne = philox;
+    mersenne.generator = RandomGenerator::MersenneTwister;
+
+    for (PricingEngine::Method method : {PricingEngine::Method::Naive, PricingEngine::Method::GBM}) {
+        PricingResult fromPhilox = PricingEngine::calculatePrice(method, *callOption, spot_price, risk_free_rate, volatility, 100000, philox);
+        PricingResult fromMersenne = PricingEngine::calculatePrice(method, *callOption, spot_price, risk_free_rate, volatility, 100000, mersenne);
+        EXPECT_NE(fromPhilox.price, fromMersenne.price);
+        EXPECT_NEAR(fromPhilox.price, fromMersenne.price, 4.0 * std::hypot(fromPhilox.standardError, fromMersenne.standardError));
+    }
+}
+
+// Test case ensuring a seed and stream id pin the result exactly, and other stream ids give independent estimates
+TEST_F(PricingEngineTest, StreamIdSelectsIndependentStreams) {
+    SimulationConfig config;
+    config.seed = 5;
+    SimulationConfig otherStream = config;
+    otherStream.streamId = 1;
+
+    for (RandomGenerator generator : {RandomGenerator::Philox, RandomGenerator::MersenneTwister}) {
+        config.generator = otherStream.generator = generator;
+        PricingResult first = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 50000, config);
+        PricingResult repeated = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 50000, config);
+        PricingResult other = PricingEngine::calculatePriceGBM(*callOption, spot_price, risk_free_rate, volatility, 50000, otherStream);
+
+        EXPECT_EQ(first.price, repeated.price);
+        EXPECT_NE(first.price, other.price);
+        EXPECT_NEAR(first.price, other.price, 4.0 * std::hypot(first.standardError, other.standardError));
+    }
+}
+
+// Undiscounted geometric-average call or put for arbitrary remaining fixing times after pastFixings fixings of geometric average
+// pastAverage: log G is normal with mean (m log G_p + k log(spot) + (r - sigma^2/2) sum(t)) / N and variance sigma^2 / N^2 sum_ij min(t_i, t_j)
+static double geometricExpectedPayoffForSchedule(bool call, double strike, const std::vector<double> &times, unsigned int pastFixings, double pastAverage,
+                                                 double spot, double r, double sigma) {
+    double k = static_cast<double>(times.size()), n = k + pastFixings, sumTime = 0.0, sumMin = 0.0;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        sumTime += times[i];
+        for (std::size_t j = 0; j < times.size(); ++j) {
+            sumMin += std::min(times[i], times[j]);
+        }
+    }
+    double meanLog = ((pastFixings > 0 ? pastFixings * std::log(pastAverage) : 0.0) + k * std::log(spot) + (r - 0.5 * sigma * sigma) * sumTime) / n;
+    double stdDevLog = sigma * std::sqrt(sumMin) / n;
+    double forward = std::exp(meanLog + 0.5 * stdDevLog * stdDevLog);
+    double d1 = (meanLog - std::log(strike) + stdDevLog * stdDevLog) / stdDevLog;
+    double d2 = d1 - stdDevLog;
+    auto cdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+    return call ? forward * cdf(d1) - strike * cdf(d2) : strike * cdf(-d2) - forward * cdf(-d1);
+}
+
+// Test case ensuring the streaming engine reproduces the GBM engine on the uniform schedule, from the same normals
+TEST_F(PricingEngineTest, StreamingMatchesGBMOnUniformSchedule) {
+    SimulationConfig config;
+    config.seed = 8;
+    for (AsianOption *option : {callOption, putOptionG}) {
+        PricingResult streamed = PricingEngine::calculatePriceStreaming(*option, spot_price, risk_free_rate, volatility, 10000, config);
+        PricingResult blocked = PricingEngine::calculatePriceGBM(*option, spot_price, risk_free_rate, volatility, 10000, config);
+        EXPECT_NEAR(streamed.price, blocked.price, 1e-10 * blocked.price);
+        EXPECT_NEAR(streamed.standardError, blocked.standardError, 1e-8 * blocked.standardError);
+        EXPECT_EQ(streamed.pathsUsed, 10000u);
+    }
+}
+
+// Test case ensuring streamed geometric prices match the closed form on a non-uniform schedule and on ten thousand daily fixings
+TEST_F(PricingEngineTest, StreamingGeometricMatchesClosedForm) {
+    SimulationConfig config;
+    config.seed = 21;
+    config.numThreads = 2;
+
+    std::vector<double> irregular = {0.1, 0.15, 0.4, 0.45, 0.9, 1.0};
+    AsianOption irregularCall(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, irregular);
+    PricingResult result = PricingEngine::calculatePriceStreaming(irregularCall, spot_price, risk_free_rate, volatility, 200000, config);
+    double expected = std::exp(-risk_free_rate) * geometricExpectedPayoffForSchedule(true, 100.0, irregular, 0, 0.0, spot_price, risk_free_rate, volatility);
+    EXPECT_NEAR(result.price, expected, 4.0 * result.standardError);
+    EXPECT_NEAR(PricingEngine::calculatePriceGeometricClosedForm(irregularCall, spot_price, risk_free_rate, volatility), expected, 1e-12);
+
+    AsianOption daily(100.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Geometric, 10000);
+    PricingResult dailyResult = PricingEngine::calculatePriceStreaming(daily, spot_price, risk_free_rate, volatility, 4000, config);
+    double closedForm = PricingEngine::calculatePriceGeometricClosedForm(daily, spot_price, risk_free_rate, volatility);
+    EXPECT_NEAR(dailyResult.price, closedForm, 4.0 * dailyResult.standardError);
+}
+
+// Test case ensuring an explicit schedule equal to the equally spaced one prices exactly like the legacy constructor
+TEST_F(PricingEngineTest, ExplicitUniformScheduleMatchesLegacy) {
+    SimulationConfig config;
+    config.seed = 31;
+    AsianOption explicitCall(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, AsianOption::uniformFixingTimes(1.0, 10));
+    EXPECT_TRUE(explicitCall.hasUniformSchedule());
+    for (PricingEngine::Method method : {PricingEngine::Method::Naive, PricingEngine::Method::GBM, PricingEngine::Method::ControlVariate}) {
+        EXPECT_EQ(PricingEngine::calculatePrice(method, explicitCall, spot_price, risk_free_rate, volatility, 5000, config).price,
+                  PricingEngine::calculatePrice(method, *callOption, spot_price, risk_free_rate, volatility, 5000, config).price);
+    }
+}
+
+// Test case ensuring seasoned geometric prices match the closed form with the past fixings, for every simulation method
+TEST_F(PricingEngineTest, SeasonedGeometricMatchesClosedForm) {
+    SimulationConfig config;
+    config.seed = 37;
+    config.numThreads = 2;
+
+    // Four of eight quarterly fixings observed; the remaining ones fall a month off the quarter, so today is not a fixing
+    std::vector<double> remaining = {1.0 / 12.0, 4.0 / 12.0, 7.0 / 12.0, 10.0 / 12.0};
+    AsianOption seasoned(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Geometric, remaining, 4, 95.0);
+    EXPECT_EQ(seasoned.getAveragingPeriods(), 8u);
+    EXPECT_FALSE(seasoned.hasUniformSchedule());
+
+    double expected = std::exp(-risk_free_rate) * geometricExpectedPayoffForSchedule(true, 100.0, remaining, 4, 95.0, spot_price, risk_free_rate, volatility);
+    EXPECT_NEAR(PricingEngine::calculatePriceGeometricClosedForm(seasoned, spot_price, risk_free_rate, volatility), expected, 1e-12);
+
+    for (PricingEngine::Method method : {PricingEngine::Method::Naive, PricingEngine::Method::Antithetic, PricingEngine::Method::GBM}) {
+        PricingResult result = PricingEngine::calculatePrice(method, seasoned, spot_price, risk_free_rate, volatility, 100000, config);
+        EXPECT_NEAR(result.price, expected, 4.0 * result.standardError);
+    }
+    PricingResult streamed = PricingEngine::calculatePriceStreaming(seasoned, spot_price, risk_free_rate, volatility, 100000, config);
+    EXPECT_NEAR(streamed.price, expected, 4.0 * streamed.standardError);
+    PricingResult quasi = PricingEngine::calculatePriceQuasiMonteCarlo(seasoned, spot_price, risk_free_rate, volatility, 8192, 8, config);
+    EXPECT_NEAR(quasi.price, expected, 4.0 * quasi.standardError + 1e-4);
+
+    // The geometric control is exact for a geometric contract, whatever the schedule
+    PricingResult controlled = PricingEngine::calculatePriceControlVariate(seasoned, spot_price, risk_free_rate, volatility, 10000, config);
+    EXPECT_NEAR(controlled.price, expected, 1e-10);
+}
+
+// Test case ensuring a seasoned arithmetic contract prices consistently across methods and through the batch pricer
+TEST_F(PricingEngineTest, SeasonedArithmeticAgreesAcrossMethods) {
+    SimulationConfig config;
+    config.seed = 41;
+    config.numThreads = 2;
+
+    std::vector<double> remaining = {0.0, 0.1, 0.35, 0.4, 0.5};
+    AsianOption seasoned(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Arithmetic, remaining, 3, 104.0);
+    PricingResult gbm = PricingEngine::calculatePriceGBM(seasoned, spot_price, risk_free_rate, volatility, 100000, config);
+    PricingResult controlled = PricingEngine::calculatePriceControlVariate(seasoned, spot_price, risk_free_rate, volatility, 100000, config);
+    PricingResult quasi = PricingEngine::calculatePriceQuasiMonteCarlo(seasoned, spot_price, risk_free_rate, volatility, 8192, 8, config);
+    EXPECT_LT(controlled.standardError, gbm.standardError);
+    EXPECT_NEAR(gbm.price, controlled.price, 4.0 * gbm.standardError);
+    EXPECT_NEAR(quasi.price, controlled.price, 4.0 * (quasi.standardError + controlled.standardError) + 1e-4);
+
+    // The batch shares paths only between contracts with the same schedule and past fixings
+    AsianOption otherPast(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Arithmetic, remaining, 3, 96.0);
+    std::vector<AsianOption> options = {seasoned, otherPast, *putOption};
+    std::vector<MarketData> market(options.size(), MarketData{spot_price, risk_free_rate, volatility});
+    std::vector<PricingResult> batch = PricingEngine::calculatePricesBatch(options, market, 20000, config);
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        EXPECT_EQ(batch[i].price, PricingEngine::calculatePriceGBM(options[i], spot_price, risk_free_rate, volatility, 20000, config).price);
+    }
+    EXPECT_LT(batch[0].price, batch[1].price);
+}
+
+// Test case ensuring an option whose every fixing is past has a known payoff, and that Greeks reject seasoned contracts
+TEST_F(PricingEngineTest, FullyFixedOptionIsDeterministic) {
+    SimulationConfig config;
+    config.seed = 43;
+    AsianOption fixedCall(100.0, 0.5, Option::Type::Call, AsianOption::AveragingType::Arithmetic, std::vector<double>(), 12, 110.0);
+    double expected = std::exp(-risk_free_rate * 0.5) * 10.0;
+    for (PricingEngine::Method method : {PricingEngine::Method::Naive, PricingEngine::Method::Antithetic, PricingEngine::Method::GBM, PricingEngine::Method::ControlVariate}) {
+        PricingResult result = PricingEngine::calculatePrice(method, fixedCall, spot_price, risk_free_rate, volatility, 1000, config);
+        EXPECT_NEAR(result.price, expected, 1e-12);
+        EXPECT_EQ(result.standardError, 0.0);
+    }
+    EXPECT_NEAR(PricingEngine::calculatePriceStreaming(fixedCall, spot_price, risk_free_rate, volatility, 1000, config).price, expected, 1e-12);
+
+    AsianOption fixedGeometric(100.0, 0.5, Option::Type::Put, AsianOption::AveragingType::Geometric, std::vector<double>(), 12, 90.0);
+    EXPECT_NEAR(PricingEngine::calculatePriceGeometricClosedForm(fixedGeometric, spot_price, risk_free_rate, volatility), expected, 1e-12);
+
+    EXPECT_THROW(PricingEngine::calculateGreeks(fixedCall, spot_price, risk_free_rate, volatility, 1000, config), std::invalid_argument);
+    EXPECT_THROW(PricingEngine::calculateGreeksAdjoint(fixedCall, spot_price, risk_free_rate, volatility, 1000, config), std::invalid_argument);
+}
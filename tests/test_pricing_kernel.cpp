@@ -0,0 +1,75 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/PricingKernel.hpp"
+
+// Test case ensuring the payoff and averaging policies agree with AsianOption for every contract type
+TEST(PricingKernelTest, PoliciesMatchAsianOption) {
+    for (Option::Type type : {Option::Type::Call, Option::Type::Put}) {
+        for (AsianOption::AveragingType averagingType : {AsianOption::AveragingType::Arithmetic, AsianOption::AveragingType::Geometric}) {
+            AsianOption option(100.0, 1.0, type, averagingType, 4);
+            double sumSpot = 396.0;
+            double sumLogSpot = std::log(90.0) + std::log(95.0) + std::log(105.0) + std::log(106.0);
+            double average = averagingType == AsianOption::AveragingType::Arithmetic ? sumSpot / 4.0 : std::exp(sumLogSpot / 4.0);
+
+            double fromPolicies = withPolicies(option, [&](auto averaging, auto payoff) {
+                return decltype(payoff)::payoff(decltype(averaging)::average(sumSpot, sumLogSpot, 4), option.getStrike());
+            });
+            EXPECT_DOUBLE_EQ(fromPolicies, option.payoff(average));
+        }
+    }
+}
+
+// Test case ensuring the scalar, vectorised and antithetic schemes price the same paths consistently
+TEST(PricingKernelTest, SchemesAgreeOnTheSamePaths) {
+    AsianOption option(100.0, 0.5, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 26);
+    KernelParameters parameters = makeKernelParameters(option, 100.0, 0.03, 0.2);
+
+    NormalStream naiveStream(RandomGenerator::Philox, 3, 0), plainStream(RandomGenerator::Philox, 3, 0), antitheticStream(RandomGenerator::Philox, 3, 0);
+    PathArena arena;
+    RunningStatistics naive = simulateChunk<ArithmeticAveraging, CallPayoff, NaiveScheme>(naiveStream, arena, 1001, parameters);
+    RunningStatistics plain = simulateChunk<ArithmeticAveraging, CallPayoff, PlainScheme>(plainStream, arena, 1001, parameters);
+    RunningStatistics antithetic = simulateChunk<ArithmeticAveraging, CallPayoff, AntitheticScheme>(antitheticStream, arena, 1001, parameters);
+
+    EXPECT_EQ(naive.getCount(), 1001u);
+    EXPECT_NEAR(naive.getMean(), plain.getMean(), 1e-10);
+    EXPECT_NEAR(naive.getVariance(), plain.getVariance(), 1e-8);
+
+    // Antithetic pairs average out much of the noise but target the same mean
+    EXPECT_LT(antithetic.getVariance(), plain.getVariance());
+    EXPECT_NEAR(antithetic.getMean(), plain.getMean(), 4.0 * std::sqrt(plain.getVariance() / 1001));
+}
+
+// Test case ensuring the kernel inputs step between the remaining fixings only, starting from the past sums
+TEST(PricingKernelTest, ParametersFollowSchedule) {
+    // Equally spaced: one coefficient repeated, the spot as the first fixing
+    AsianOption uniform(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 4);
+    KernelParameters parameters = makeKernelParameters(uniform, 100.0, 0.05, 0.2);
+    ASSERT_EQ(parameters.numSteps, 3u);
+    for (unsigned int j = 0; j < 3; ++j) {
+        EXPECT_DOUBLE_EQ(parameters.drift[j], (0.05 - 0.02) * 0.25);
+        EXPECT_DOUBLE_EQ(parameters.diffusion[j], 0.2 * 0.5);
+    }
+    EXPECT_EQ(parameters.initialSum, 100.0);
+    EXPECT_EQ(parameters.initialLogSum, std::log(100.0));
+
+    // Half of twelve monthly fixings observed: six steps, the first from today to the next fixing
+    std::vector<double> remaining;
+    for (int i = 1; i <= 6; ++i) {
+        remaining.push_back(i / 12.0 - 0.02);
+    }
+    AsianOption seasoned(100.0, 0.5, Option::Type::Call, AsianOption::AveragingType::Arithmetic, remaining, 6, 104.0);
+    KernelParameters seasonedParameters = makeKernelParameters(seasoned, 100.0, 0.05, 0.2);
+    EXPECT_EQ(seasonedParameters.numSteps, 6u);
+    EXPECT_EQ(seasonedParameters.averagingPeriods, 12u);
+    EXPECT_DOUBLE_EQ(seasonedParameters.diffusion[0], 0.2 * std::sqrt(1.0 / 12.0 - 0.02));
+    EXPECT_DOUBLE_EQ(seasonedParameters.diffusion[1], 0.2 * std::sqrt(1.0 / 12.0));
+    EXPECT_DOUBLE_EQ(seasonedParameters.initialSum, 6 * 104.0);
+    EXPECT_DOUBLE_EQ(seasonedParameters.initialLogSum, 6 * std::log(104.0));
+
+    // The paths draw one normal per remaining step
+    NormalStream stream(RandomGenerator::Philox, 5, 0);
+    PathArena arena;
+    simulateChunk<ArithmeticAveraging, CallPayoff, PlainScheme>(stream, arena, 10, seasonedParameters);
+    EXPECT_EQ(stream.tell(), 60u);
+}
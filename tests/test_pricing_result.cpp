@@ -0,0 +1,51 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../src/PricingResult.hpp"
+
+// Test case ensuring the online statistics agree with the two-pass formulas
+TEST(PricingResultTest, RunningStatisticsMatchesTwoPass) {
+    double values[] = {4.0, 7.0, 13.0, 16.0, 1e9 + 4.0, 1e9 + 7.0};
+    RunningStatistics statistics;
+    double sum = 0.0;
+    for (double value : values) {
+        statistics.add(value);
+        sum += value;
+    }
+    double mean = sum / 6.0;
+    double sumSquares = 0.0;
+    for (double value : values) {
+        sumSquares += (value - mean) * (value - mean);
+    }
+    EXPECT_EQ(statistics.getCount(), 6u);
+    EXPECT_DOUBLE_EQ(statistics.getMean(), mean);
+    EXPECT_NEAR(statistics.getVariance(), sumSquares / 5.0, 1e-9 * sumSquares);
+}
+
+// Test case ensuring merging partial accumulators gives the same result as one sequential pass
+TEST(PricingResultTest, MergeMatchesSequential) {
+    RunningStatistics sequential, first, second, empty;
+    for (int i = 0; i < 100; ++i) {
+        double value = std::sin(i) * 10.0 + 50.0;
+        sequential.add(value);
+        (i < 37 ? first : second).add(value);
+    }
+    first += empty;
+    first += second;
+    EXPECT_EQ(first.getCount(), sequential.getCount());
+    EXPECT_NEAR(first.getMean(), sequential.getMean(), 1e-12);
+    EXPECT_NEAR(first.getVariance(), sequential.getVariance(), 1e-10);
+
+    empty += sequential;
+    EXPECT_EQ(empty.getCount(), sequential.getCount());
+    EXPECT_EQ(empty.getMean(), sequential.getMean());
+}
+
+// Test case for the confidence interval helper
+TEST(PricingResultTest, ConfidenceInterval) {
+    PricingResult result;
+    result.price = 10.0;
+    result.standardError = 0.5;
+    std::pair<double, double> interval = result.confidenceInterval();
+    EXPECT_DOUBLE_EQ(interval.first, 10.0 - 1.96 * 0.5);
+    EXPECT_DOUBLE_EQ(interval.second, 10.0 + 1.96 * 0.5);
+}
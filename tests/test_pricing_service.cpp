@@ -0,0 +1,132 @@
+#include <future>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/PricingService.hpp"
+#include "../src/PricingEngine.hpp"
+#include "../src/AsianOption.hpp"
+
+namespace {
+
+const MarketData market = {100.0, 0.05, 0.2};
+
+PricingServiceConfig serviceConfig(unsigned int workers, std::size_t queueCapacity = 1024) {
+    PricingServiceConfig config;
+    config.workers = workers;
+    config.queueCapacity = queueCapacity;
+    config.simulation.seed = 20261017;
+    return config;
+}
+
+} // namespace
+
+// Test case ensuring every request gets exactly the price the GBM engine gives it on its own, whatever it was batched with
+TEST(PricingServiceTest, ResultsMatchDirectPricing) {
+    PricingServiceConfig config = serviceConfig(2);
+    PricingService service(config);
+    std::vector<AsianOption> options;
+    std::vector<MarketData> markets;
+    std::vector<unsigned int> paths;
+    std::vector<std::future<PricingResult>> futures;
+    for (int i = 0; i < 24; ++i) {
+        options.emplace_back(90.0 + i, 1.0, i % 2 == 0 ? Option::Type::Call : Option::Type::Put,
+                             i % 3 == 0 ? AsianOption::AveragingType::Geometric : AsianOption::AveragingType::Arithmetic, 12);
+        markets.push_back({i % 4 == 0 ? 105.0 : 100.0, 0.05, 0.2});
+        paths.push_back(i % 5 == 0 ? 4096 : 10000);
+        futures.push_back(service.submit(options.back(), markets.back(), paths.back()));
+    }
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        PricingResult result = futures[i].get();
+        PricingResult direct = PricingEngine::calculatePriceGBM(options[i], markets[i].spot, markets[i].riskFreeRate, markets[i].volatility, paths[i], config.simulation);
+        EXPECT_EQ(result.price, direct.price);
+        EXPECT_EQ(result.variance, direct.variance);
+        EXPECT_EQ(result.pathsUsed, direct.pathsUsed);
+    }
+
+    PricingServiceStatistics statistics = service.getStatistics();
+    EXPECT_EQ(statistics.submitted, 24u);
+    EXPECT_EQ(statistics.completed, 24u);
+    EXPECT_EQ(statistics.queueDepth, 0u);
+    EXPECT_EQ(statistics.inFlight, 0u);
+    EXPECT_GT(statistics.p50Latency, 0.0);
+    EXPECT_LE(statistics.p50Latency, statistics.p99Latency);
+}
+
+// Test case ensuring identical requests arriving together share one queue entry, and compatible ones one engine call
+TEST(PricingServiceTest, CoalescesIdenticalAndCompatibleRequests) {
+    PricingService service(serviceConfig(1));
+    service.pause(); // the requests below wait in the queue together
+
+    AsianOption call(105.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    AsianOption put(95.0, 1.0, Option::Type::Put, AsianOption::AveragingType::Arithmetic, 12);
+    std::vector<std::future<PricingResult>> calls;
+    for (int i = 0; i < 10; ++i) {
+        calls.push_back(service.submit(call, market, 20000));
+    }
+    std::future<PricingResult> putResult = service.submit(put, market, 20000);
+
+    PricingServiceStatistics waiting = service.getStatistics();
+    EXPECT_EQ(waiting.queueDepth, 2u);
+    EXPECT_EQ(waiting.coalesced, 9u);
+
+    service.resume();
+    double price = calls.front().get().price;
+    for (std::size_t i = 1; i < calls.size(); ++i) {
+        EXPECT_EQ(calls[i].get().price, price);
+    }
+    EXPECT_GT(putResult.get().price, 0.0);
+
+    // The eleven waiting requests took a single engine call
+    PricingServiceStatistics statistics = service.getStatistics();
+    EXPECT_EQ(statistics.batches, 1u);
+    EXPECT_EQ(statistics.completed, 11u);
+}
+
+// Test case ensuring a full queue refuses trySubmit, still takes requests that coalesce, and makes submit wait for room
+TEST(PricingServiceTest, BoundedQueueAppliesBackPressure) {
+    PricingService service(serviceConfig(1, 2));
+    service.pause();
+
+    AsianOption first(100.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    AsianOption second(110.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    AsianOption third(120.0, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+    std::future<PricingResult> a = service.submit(first, market, 8192);
+    std::future<PricingResult> b = service.submit(second, market, 8192);
+
+    std::future<PricingResult> refused;
+    EXPECT_FALSE(service.trySubmit(third, market, 8192, refused));
+    EXPECT_FALSE(refused.valid());
+    std::future<PricingResult> twin;
+    EXPECT_TRUE(service.trySubmit(first, market, 8192, twin));
+
+    // Blocks until the resumed worker takes the queued pair, then goes through
+    std::future<PricingResult> c = std::async(std::launch::async, [&]() { return service.submit(third, market, 8192).get(); });
+    service.resume();
+    EXPECT_EQ(twin.get().price, a.get().price);
+    EXPECT_GT(b.get().price, c.get().price);
+
+    PricingServiceStatistics statistics = service.getStatistics();
+    EXPECT_EQ(statistics.rejected, 1u);
+    EXPECT_EQ(statistics.coalesced, 1u);
+    EXPECT_EQ(statistics.submitted, 4u);
+    EXPECT_EQ(statistics.completed, 4u);
+}
+
+// Test case ensuring an invalid configuration is refused and the destructor prices every request already accepted, even when paused
+TEST(PricingServiceTest, ValidatesConfigurationAndDrainsOnDestruction) {
+    EXPECT_THROW(PricingService(serviceConfig(0)), std::invalid_argument);
+    EXPECT_THROW(PricingService(serviceConfig(1, 0)), std::invalid_argument);
+
+    std::vector<std::future<PricingResult>> futures;
+    {
+        PricingService service(serviceConfig(1));
+        service.pause();
+        for (int i = 0; i < 8; ++i) {
+            AsianOption option(95.0 + i, 1.0, Option::Type::Call, AsianOption::AveragingType::Arithmetic, 12);
+            futures.push_back(service.submit(option, market, 4096));
+        }
+    }
+    for (std::future<PricingResult> &future : futures) {
+        EXPECT_GT(future.get().price, 0.0);
+    }
+}
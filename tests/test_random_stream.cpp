@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/RandomStream.hpp"
+#include "../src/MathUtils.hpp"
+
+// Test case ensuring Philox4x32-10 reproduces the published known-answer vectors of the reference implementation (Random123)
+TEST(RandomStreamTest, PhiloxKnownAnswers) {
+    std::uint32_t output[4];
+
+    Philox4x32(0, 0).block(0, output);
+    EXPECT_EQ(output[0], 0x6627e8d5u);
+    EXPECT_EQ(output[1], 0xe169c58du);
+    EXPECT_EQ(output[2], 0xbc57ac4cu);
+    EXPECT_EQ(output[3], 0x9b00dbd8u);
+
+    Philox4x32(0xffffffffffffffffULL, 0xffffffffffffffffULL).block(0xffffffffffffffffULL, output);
+    EXPECT_EQ(output[0], 0x408f276du);
+    EXPECT_EQ(output[1], 0x41c83b0eu);
+    EXPECT_EQ(output[2], 0xa20bc7c6u);
+    EXPECT_EQ(output[3], 0x6d5451fdu);
+
+    // Counter 243f6a88 85a308d3 13198a2e 03707344, key a4093822 299f31d0 (the digits of pi)
+    Philox4x32(0x299f31d0a4093822ULL, 0x0370734413198a2eULL).block(0x85a308d3243f6a88ULL, output);
+    EXPECT_EQ(output[0], 0xd16cfe09u);
+    EXPECT_EQ(output[1], 0x94fdccebu);
+    EXPECT_EQ(output[2], 0x5001e420u);
+    EXPECT_EQ(output[3], 0x24126ea1u);
+}
+
+// Test case ensuring the vectorised uniforms are the scalar blocks, and lie strictly inside (0, 1)
+TEST(RandomStreamTest, UniformsMatchBlocks) {
+    Philox4x32 philox(42, 7);
+    std::vector<double> uniforms(2 * 37);
+    philox.uniforms(1000, 37, uniforms.data());
+
+    for (unsigned int i = 0; i < 37; ++i) {
+        std::uint32_t output[4];
+        philox.block(1000 + i, output);
+        double expected0 = (static_cast<double>((static_cast<std::uint64_t>(output[0]) << 32 | output[1]) >> 12) + 0.5) * std::ldexp(1.0, -52);
+        double expected1 = (static_cast<double>((static_cast<std::uint64_t>(output[2]) << 32 | output[3]) >> 12) + 0.5) * std::ldexp(1.0, -52);
+        EXPECT_EQ(uniforms[2 * i], expected0);
+        EXPECT_EQ(uniforms[2 * i + 1], expected1);
+        EXPECT_GT(uniforms[2 * i], 0.0);
+        EXPECT_LT(uniforms[2 * i + 1], 1.0);
+    }
+}
+
+// Test case ensuring the buffered inverse CDF round-trips through the CDF to near machine precision over the whole range, tails included
+TEST(RandomStreamTest, InverseNormalCdfRoundTrip) {
+    std::vector<double> uniforms;
+    for (int i = 1; i < 20000; ++i) {
+        uniforms.push_back(i / 20000.0);
+    }
+    for (double p : {1e-300, 1e-100, 1e-20, 1e-10, 1e-5, 0.0749, 0.075, 0.0751, 0.9249, 0.925, 0.9251}) {
+        uniforms.push_back(p);
+    }
+
+    std::vector<double> normals(uniforms.size());
+    inverseNormalCdfBuffer(uniforms.data(), normals.data(), uniforms.size());
+    for (std::size_t i = 0; i < uniforms.size(); ++i) {
+        double p = uniforms[i];
+        EXPECT_NEAR(normalCdf(normals[i]), p, 1e-13 * std::min(p, 1.0 - p) + 1e-16) << "p = " << p;
+    }
+    double known[] = {0.5, 0.975};
+    inverseNormalCdfBuffer(known, normals.data(), 2);
+    EXPECT_NEAR(normals[0], 0.0, 1e-15);
+    EXPECT_NEAR(normals[1], 1.959963984540054, 1e-12);
+}
+
+// Test case ensuring a stream continues where it left off, so normals do not depend on how the draws are split
+TEST(RandomStreamTest, StreamIsSplitInvariant) {
+    NormalStream whole(RandomGenerator::Philox, 11, 3), pieces(RandomGenerator::Philox, 11, 3);
+    std::vector<double> expected(1001), actual(1001);
+    whole.fill(expected.data(), expected.size());
+    pieces.fill(actual.data(), 1);
+    pieces.fill(actual.data() + 1, 500);
+    const double *drawn = pieces.draw(500);
+    std::copy(drawn, drawn + 500, actual.begin() + 501);
+
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(actual[i], expected[i], 1e-15 * std::max(1.0, std::fabs(expected[i])));
+    }
+
+    // Different streams of the same seed are different
+    NormalStream other(RandomGenerator::Philox, 11, 4);
+    EXPECT_NE(other.draw(1)[0], expected[0]);
+}
+
+// Test case ensuring the Mersenne Twister generator reproduces mt19937 with std::normal_distribution, seeded as before
+TEST(RandomStreamTest, MersenneTwisterReproducesStandardLibrary) {
+    std::uint64_t seed = 0x123456789ULL;
+    std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), 5u};
+    std::mt19937 gen(sequence);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    NormalStream stream(RandomGenerator::MersenneTwister, seed, 5);
+    const double *drawn = stream.draw(999);
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(drawn[i], dist(gen));
+    }
+}
+
+// Test case ensuring a restarted stream is the new stream exactly, including a Mersenne Twister seeded from four words
+TEST(RandomStreamTest, RestartMatchesNewStream) {
+    const std::uint64_t streamId = (7ULL << 32) | 3;
+    std::seed_seq sequence{9u, 0u, 3u, 7u};
+    std::mt19937 gen(sequence);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    for (RandomGenerator generator : {RandomGenerator::Philox, RandomGenerator::MersenneTwister}) {
+        NormalStream reused(RandomGenerator::MersenneTwister, 1, 2);
+        reused.draw(37); // leaves a cached normal in std::normal_distribution
+        reused.restart(generator, 9, streamId);
+        NormalStream fresh(generator, 9, streamId);
+        const double *expected = fresh.draw(101);
+        std::vector<double> actual(101);
+        reused.fill(actual.data(), actual.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i], expected[i]);
+            if (generator == RandomGenerator::MersenneTwister) {
+                EXPECT_EQ(actual[i], dist(gen));
+            }
+        }
+        EXPECT_EQ(reused.tell(), 101u);
+    }
+}
+
+// Test case ensuring Philox normals have the moments of a standard normal
+TEST(RandomStreamTest, PhiloxNormalMoments) {
+    const std::size_t count = 1 << 20;
+    NormalStream stream(RandomGenerator::Philox, 2024, 0);
+    const double *normals = stream.draw(count);
+
+    double sum = 0.0, sumSquares = 0.0, sumFourth = 0.0, below = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        double x = normals[i];
+        sum += x;
+        sumSquares += x * x;
+        sumFourth += x * x * x * x;
+        below += x < -1.0;
+    }
+    EXPECT_NEAR(sum / count, 0.0, 5.0 / std::sqrt(count));
+    EXPECT_NEAR(sumSquares / count, 1.0, 5.0 * std::sqrt(2.0 / count));
+    EXPECT_NEAR(sumFourth / count, 3.0, 5.0 * std::sqrt(96.0 / count));
+    EXPECT_NEAR(below / count, normalCdf(-1.0), 5.0 * std::sqrt(0.16 / count));
+}
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/SobolSequence.hpp"
+
+// Test case ensuring the first dimension is the van der Corput sequence (cell-centred at 32 bits)
+TEST(SobolSequenceTest, FirstDimensionIsVanDerCorput) {
+    SobolSequence sequence(3);
+    double point[3];
+    double expected[] = {0.0, 0.5, 0.75, 0.25, 0.375, 0.875, 0.625, 0.125};
+    for (double value : expected) {
+        sequence.next(point);
+        EXPECT_NEAR(point[0], value, 1e-9);
+    }
+}
+
+// Test case ensuring every dimension of the first 2^k points puts exactly one point in each interval of width 2^-k,
+// for the plain and the scrambled sequence
+TEST(SobolSequenceTest, OneDimensionalStratification) {
+    const unsigned int dimension = 40;
+    const unsigned int numPoints = 1024;
+    SobolSequence plain(dimension);
+    SobolSequence scrambled(dimension, 12345);
+    std::vector<double> point(dimension);
+
+    for (SobolSequence *sequence : {&plain, &scrambled}) {
+        std::vector<std::set<unsigned int>> cells(dimension);
+        for (unsigned int i = 0; i < numPoints; ++i) {
+            sequence->next(point.data());
+            for (unsigned int d = 0; d < dimension; ++d) {
+                EXPECT_GT(point[d], 0.0);
+                EXPECT_LT(point[d], 1.0);
+                cells[d].insert(static_cast<unsigned int>(point[d] * numPoints));
+            }
+        }
+        for (unsigned int d = 0; d < dimension; ++d) {
+            EXPECT_EQ(cells[d].size(), numPoints);
+        }
+    }
+}
+
+// Test case ensuring skipTo gives random access consistent with sequential generation
+TEST(SobolSequenceTest, SkipToMatchesSequential) {
+    SobolSequence sequential(8, 7);
+    SobolSequence skipped(8, 7);
+    std::vector<double> expected(8), actual(8);
+    for (unsigned int i = 0; i < 1000; ++i) {
+        sequential.next(expected.data());
+    }
+    skipped.skipTo(999);
+    skipped.next(actual.data());
+    for (unsigned int d = 0; d < 8; ++d) {
+        EXPECT_EQ(expected[d], actual[d]);
+    }
+}
+
+// Test case ensuring the points match the Joe-Kuo (new-joe-kuo-6.21201) sequence as generated by Boost.Random's sobol_engine, in
+// low and high dimensions and at indices that reach the later direction numbers. References are 32-bit integer points; ours are
+// cell-centred, half a cell above them.
+TEST(SobolSequenceTest, MatchesJoeKuoReferencePoints) {
+    const unsigned int dimensions[] = {2, 3, 7, 100, 252, 1111};
+    struct Reference {
+        std::uint64_t index;
+        std::uint32_t coordinates[6];
+    };
+    const Reference references[] = {
+        {1, {2147483648u, 2147483648u, 2147483648u, 2147483648u, 2147483648u, 2147483648u}},
+        {2, {1073741824u, 1073741824u, 1073741824u, 3221225472u, 3221225472u, 3221225472u}},
+        {3, {3221225472u, 3221225472u, 3221225472u, 1073741824u, 1073741824u, 1073741824u}},
+        {4, {1610612736u, 2684354560u, 1610612736u, 3758096384u, 536870912u, 3758096384u}},
+        {1000, {415236096u, 2227175424u, 197132288u, 801112064u, 734003200u, 1589641216u}},
+        {65535, {4294901760u, 2421489664u, 2221342720u, 2030501888u, 1965228032u, 268894208u}},
+    };
+
+    SobolSequence sequence(SobolSequence::maxDimension);
+    std::vector<double> point(SobolSequence::maxDimension);
+    for (const Reference &reference : references) {
+        sequence.skipTo(reference.index);
+        sequence.next(point.data());
+        for (unsigned int i = 0; i < 6; ++i) {
+            EXPECT_EQ(point[dimensions[i] - 1], (reference.coordinates[i] + 0.5) / 4294967296.0)
+                    << "index " << reference.index << ", dimension " << dimensions[i];
+        }
+    }
+}
+
+TEST(SobolSequenceTest, RejectsZeroDimension) {
+    EXPECT_THROW(SobolSequence(0), std::invalid_argument);
+}
+
+// Test case ensuring dimensions beyond the direction-number table are refused rather than filled with ad hoc numbers
+TEST(SobolSequenceTest, RejectsDimensionsBeyondTable) {
+    EXPECT_NO_THROW(SobolSequence(SobolSequence::maxDimension));
+    EXPECT_THROW(SobolSequence(SobolSequence::maxDimension + 1), std::invalid_argument);
+}
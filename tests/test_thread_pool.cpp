@@ -0,0 +1,108 @@
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/ThreadPool.hpp"
+#include "../src/Parallel.hpp"
+
+// Test case ensuring a sweep returns its results in the order of the grid points, whatever order they finish in
+TEST(ThreadPoolTest, SweepResultsInGridOrder) {
+    ThreadPool pool(4);
+    std::vector<int> points;
+    for (int i = 0; i < 200; ++i) {
+        points.push_back(i);
+    }
+
+    std::vector<long> results = runSweep(pool, points, [](int point) {
+        long sum = 0;
+        for (int i = 0; i < (200 - point) * 1000; ++i) {
+            sum += i % 7;
+        }
+        return static_cast<long>(point) * point + (sum >= 0 ? 0 : 1);
+    });
+
+    ASSERT_EQ(results.size(), points.size());
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(results[i], static_cast<long>(i) * i);
+    }
+}
+
+// Test case ensuring a task submitted from inside a worker lands on that worker's deque and is stolen by an idle worker
+TEST(ThreadPoolTest, NestedSubmission) {
+    ThreadPool pool(3);
+    std::future<int> outer = pool.submit([&pool]() {
+        std::future<int> inner = pool.submit([]() { return 21; });
+        return inner.get() * 2;
+    });
+    EXPECT_EQ(outer.get(), 42);
+}
+
+// Test case ensuring an exception thrown by one grid point reaches the caller after the other points have run
+TEST(ThreadPoolTest, SweepRethrowsException) {
+    ThreadPool pool(2);
+    std::atomic<int> completed{0};
+    std::vector<int> points = {0, 1, 2, 3, 4, 5};
+
+    EXPECT_THROW(runSweep(pool, points, [&completed](int point) {
+        if (point == 2) {
+            throw std::runtime_error("grid point failed");
+        }
+        ++completed;
+        return point;
+    }), std::runtime_error);
+    EXPECT_EQ(completed.load(), 5);
+}
+
+// Test case ensuring the destructor runs every queued task before the workers are joined
+TEST(ThreadPoolTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> completed{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&completed]() { ++completed; });
+        }
+    }
+    EXPECT_EQ(completed.load(), 1000);
+}
+
+// Test case ensuring parallelFor runs every index on the pool's existing workers and the caller, and rethrows a failing index
+TEST(ThreadPoolTest, ParallelForUsesPoolWorkers) {
+    ThreadPool pool(3);
+    std::vector<int> hits(1000, 0);
+    std::set<std::thread::id> threads;
+    std::mutex threadsMutex;
+    parallelFor(pool, 1000, 4, [&](unsigned int i) {
+        ++hits[i];
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        threads.insert(std::this_thread::get_id());
+    });
+    for (int hit : hits) {
+        EXPECT_EQ(hit, 1);
+    }
+    EXPECT_LE(threads.size(), 4u);
+
+    EXPECT_THROW(parallelFor(pool, 100, 4, [](unsigned int i) {
+        if (i == 50) {
+            throw std::runtime_error("index failed");
+        }
+    }), std::runtime_error);
+}
+
+// Test case ensuring a parallelFor issued from every worker of a pool at once completes, the callers doing the work themselves
+TEST(ThreadPoolTest, ParallelForFromInsideThePool) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+    std::vector<std::future<void>> outer;
+    for (int t = 0; t < 2; ++t) {
+        outer.push_back(pool.submit([&pool, &total]() {
+            parallelFor(pool, 100, 3, [&total](unsigned int) { ++total; });
+        }));
+    }
+    for (std::future<void> &future : outer) {
+        future.get();
+    }
+    EXPECT_EQ(total.load(), 200);
+}
@@ -0,0 +1,139 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/TradeFile.hpp"
+
+namespace {
+
+TradeRecord makeTrade(std::uint64_t id, double strike, std::uint8_t type) {
+    TradeRecord trade{};
+    trade.id = id;
+    trade.strike = strike;
+    trade.expiry = 1.0;
+    trade.spot = 100.0;
+    trade.riskFreeRate = 0.05;
+    trade.volatility = 0.2;
+    trade.averagingPeriods = 12;
+    trade.type = type;
+    trade.averaging = 1;
+    return trade;
+}
+
+} // namespace
+
+// Test case ensuring CSV trades are parsed field by field, ignoring case, spaces and blank lines, and handed out in batches
+TEST(TradeFileTest, ReadsCsvInBatches) {
+    std::istringstream input("id, type, averaging, strike, expiry, periods, spot, rate, volatility\n"
+                             "7,Call,arithmetic,105,1,12,100,0.05,0.2\n"
+                             "\n"
+                             "8, put , GEOMETRIC ,95.5,0.5,6,101,-0.01,0.35\r\n"
+                             "9,call,geometric,100,2,24,99,0.03,0.25\n");
+    CsvTradeReader reader(input);
+    std::vector<TradeRecord> trades;
+
+    ASSERT_EQ(reader.read(trades, 2), 2u);
+    EXPECT_EQ(trades[0].id, 7u);
+    EXPECT_EQ(trades[0].type, 0);
+    EXPECT_EQ(trades[0].averaging, 0);
+    EXPECT_EQ(trades[0].averagingPeriods, 12u);
+    EXPECT_EQ(trades[1].id, 8u);
+    EXPECT_EQ(trades[1].type, 1);
+    EXPECT_EQ(trades[1].averaging, 1);
+    EXPECT_DOUBLE_EQ(trades[1].strike, 95.5);
+    EXPECT_DOUBLE_EQ(trades[1].expiry, 0.5);
+    EXPECT_DOUBLE_EQ(trades[1].spot, 101.0);
+    EXPECT_DOUBLE_EQ(trades[1].riskFreeRate, -0.01);
+    EXPECT_DOUBLE_EQ(trades[1].volatility, 0.35);
+
+    AsianOption option = trades[1].option();
+    EXPECT_EQ(option.getType(), Option::Type::Put);
+    EXPECT_EQ(option.getAveragingType(), AsianOption::AveragingType::Geometric);
+    EXPECT_EQ(option.getAveragingPeriods(), 6u);
+
+    ASSERT_EQ(reader.read(trades, 2), 1u);
+    EXPECT_EQ(trades[0].id, 9u);
+    EXPECT_EQ(reader.read(trades, 2), 0u);
+}
+
+// Test case ensuring a malformed or unpriceable row is reported with its line number
+TEST(TradeFileTest, CsvErrorsNameTheLine) {
+    auto errorFor = [](const std::string &row) {
+        std::istringstream input(std::string("id,type,averaging,strike,expiry,periods,spot,rate,volatility\n"
+                                             "1,call,arithmetic,105,1,12,100,0.05,0.2\n") + row + "\n");
+        CsvTradeReader reader(input);
+        std::vector<TradeRecord> trades;
+        try {
+            reader.read(trades, 10);
+        } catch (const std::invalid_argument &error) {
+            return std::string(error.what());
+        }
+        return std::string();
+    };
+
+    EXPECT_NE(errorFor("2,call,arithmetic,105,1,12,100,0.05").find("line 3"), std::string::npos);
+    EXPECT_NE(errorFor("2,straddle,arithmetic,105,1,12,100,0.05,0.2").find("type"), std::string::npos);
+    EXPECT_NE(errorFor("2,call,arithmetic,105,1,12,abc,0.05,0.2").find("spot"), std::string::npos);
+    EXPECT_NE(errorFor("2,call,arithmetic,105,1,0,100,0.05,0.2").find("periods"), std::string::npos);
+    EXPECT_NE(errorFor("2,call,arithmetic,105,1,12,100,0.05,-0.2").find("volatility"), std::string::npos);
+    EXPECT_EQ(errorFor("2,call,arithmetic,105,1,12,100,0.05,0.2"), "");
+
+    std::istringstream noHeader("1,call,arithmetic,105,1,12,100,0.05,0.2\n");
+    EXPECT_THROW(CsvTradeReader reader(noHeader), std::invalid_argument);
+}
+
+// Test case ensuring binary files round-trip through the writer and the memory-mapped reader, and are recognised by openTradeFile
+TEST(TradeFileTest, BinaryRoundTrip) {
+    std::string path = testing::TempDir() + "trades.bin";
+    std::vector<TradeRecord> written;
+    for (std::uint64_t id = 0; id < 1000; ++id) {
+        written.push_back(makeTrade(id, 80.0 + 0.04 * id, static_cast<std::uint8_t>(id % 2)));
+    }
+    {
+        std::ofstream file(path, std::ios::binary);
+        BinaryTradeWriter writer(file);
+        writer.write(std::vector<TradeRecord>(written.begin(), written.begin() + 600));
+        writer.write(std::vector<TradeRecord>(written.begin() + 600, written.end()));
+    }
+
+    BinaryTradeReader reader(path);
+    EXPECT_EQ(reader.size(), 1000u);
+    std::vector<TradeRecord> trades, read;
+    while (reader.read(trades, 256) > 0) {
+        EXPECT_LE(trades.size(), 256u);
+        read.insert(read.end(), trades.begin(), trades.end());
+    }
+    ASSERT_EQ(read.size(), written.size());
+    for (std::size_t i = 0; i < read.size(); ++i) {
+        EXPECT_EQ(read[i].id, written[i].id);
+        EXPECT_EQ(read[i].strike, written[i].strike);
+        EXPECT_EQ(read[i].type, written[i].type);
+    }
+
+    std::unique_ptr<TradeReader> opened = openTradeFile(path);
+    EXPECT_NE(dynamic_cast<BinaryTradeReader *>(opened.get()), nullptr);
+}
+
+// Test case ensuring a file that is not a binary trade file, or has a truncated record, is rejected up front
+TEST(TradeFileTest, BinaryRejectsOtherFiles) {
+    std::string csvPath = testing::TempDir() + "trades.csv";
+    {
+        std::ofstream file(csvPath);
+        file << "id,type,averaging,strike,expiry,periods,spot,rate,volatility\n1,call,arithmetic,105,1,12,100,0.05,0.2\n";
+    }
+    EXPECT_THROW(BinaryTradeReader reader(csvPath), std::runtime_error);
+    std::unique_ptr<TradeReader> opened = openTradeFile(csvPath);
+    EXPECT_NE(dynamic_cast<CsvTradeReader *>(opened.get()), nullptr);
+
+    std::string truncatedPath = testing::TempDir() + "truncated.bin";
+    {
+        std::ofstream file(truncatedPath, std::ios::binary);
+        BinaryTradeWriter writer(file);
+        writer.write({makeTrade(1, 100.0, 0)});
+        file.write("xyz", 3);
+    }
+    EXPECT_THROW(BinaryTradeReader reader(truncatedPath), std::runtime_error);
+    EXPECT_THROW(openTradeFile(testing::TempDir() + "missing.csv"), std::runtime_error);
+}